@@ -11,9 +11,10 @@ int main() {
     cout << "=== STATIC ARRAYS ===" << endl;
     int scores[3] = {85, 92, 78};
     cout << "Static array scores:" << endl;
+    // Inside loops use '\n', not endl (why: see lab/out_buffer.hpp).
     for(int i = 0; i < 3; i++) {
         cout << "scores[" << i << "] = " << scores[i] 
-             << " (address: " << &scores[i] << ")" << endl;
+             << " (address: " << &scores[i] << ")" << '\n';
     }
     cout << "Array name 'scores' points to: " << scores << endl;
     cout << endl;
@@ -37,7 +38,7 @@ int main() {
     cout << "Dynamic array:" << endl;
     for(int i = 0; i < 3; i++) {
         cout << "dynamicArr[" << i << "] = " << dynamicArr[i] 
-             << " (address: " << &dynamicArr[i] << ")" << endl;
+             << " (address: " << &dynamicArr[i] << ")" << '\n';
     }
     cout << "Pointer dynamicArr points to: " << dynamicArr << endl;
     cout << endl;
@@ -49,5 +49,21 @@ int main() {
     cout << "Float result:  " << resultF << " (should be 100000)" << endl;
     cout << "Double result: " << resultD << " (should be 100000)" << endl;
     
+    // 6. Compensated (Kahan) summation: keep the part lost by each addition
+    //    in 'lost' and add it back next time. Still float, still one loop.
+    //    (lab/compensated_sum.hpp has this and faster, vectorized versions.)
+    cout << "\n6. COMPENSATED SUMMATION:" << endl;
+    float kahanF = 0.0f;
+    float lost = 0.0f;
+    
+    for(int i = 0; i < 1000000; i++) {
+        float y = 0.1f - lost;
+        float t = kahanF + y;
+        lost = (t - kahanF) - y;
+        kahanF = t;
+    }
+    
+    cout << "Float with Kahan: " << kahanF << " (should be 100000)" << endl;
+    
     return 0;
 }
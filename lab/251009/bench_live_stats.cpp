@@ -0,0 +1,106 @@
+// CENG241 - Benchmark: stats() rescans vs live stats (dashboard polling)
+// ---------------------------------------------------------------------
+// A ledger of N products receives a stream of writes (appends, deletes near
+// the end, and now and then deletion of the current minimum or maximum) and
+// a "dashboard" calls stats() after every write. The same stream runs twice:
+//   rescan   IndexedInventory with live stats off: every stats() reads the array
+//   live     live stats on (inventory_live_stats.hpp): stats() is O(1)
+// Both must report the same min / max / average after every write. Every
+// 1000 writes p50 and p95 from the histogram are compared with the exact
+// percentiles and must be within 3%.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread bench_live_stats.cpp -o bench_live_stats
+// ./bench_live_stats [products] [writes]      (default 1000000 and 20000)
+
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "inventory_index.hpp"
+
+struct Poll {
+    int min;
+    int max;
+    double avg;
+};
+
+double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Replays the write stream on 'led', calling stats() after each write.
+// Returns false if a percentile was off by more than the sketch allows.
+bool replay(IndexedInventory& led, int products, int writes, std::vector<Poll>& polls) {
+    std::mt19937 rng(241);
+    create(led, products);
+    for (int i = 0; i < products; ++i) append(led, static_cast<int>(rng() % 100000));
+    polls.clear();
+    bool ok = true;
+    for (int w = 0; w < writes; ++w) {
+        unsigned r = rng() % 100;
+        int size = led.inv.size;
+        if (r < 50 || size < 32) {
+            append(led, static_cast<int>(rng() % 100000) - (r < 5 ? 100000 : 0));
+        } else if (r < 98) {
+            delete_at(led, size - 1 - static_cast<int>(rng() % 16));
+        } else {
+            // Remove an extreme: the case a cached min / max cannot handle.
+            int m = 0, x = 0;
+            double a = 0;
+            stats(led.inv, m, x, a);
+            delete_at(led, find(led.inv, r == 98 ? m : x));
+        }
+        Poll p{0, 0, 0};
+        stats(led, p.min, p.max, p.avg);
+        polls.push_back(p);
+        if (led.live_enabled && w % 1000 == 0) {
+            for (double q : {0.50, 0.95}) {
+                int approx = 0;
+                percentile(led, q, approx);
+                std::vector<int> copy(led.inv.data, led.inv.data + led.inv.size);
+                int rank = static_cast<int>(std::ceil(q * copy.size())) - 1; // nearest rank, 0-based
+                std::nth_element(copy.begin(), copy.begin() + rank, copy.end());
+                int exact = copy[rank];
+                ok = ok && std::abs(static_cast<double>(approx) - exact) <= std::abs(exact) / 32.0 + 1;
+            }
+        }
+    }
+    destroy(led);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    int products = (argc > 1) ? std::stoi(argv[1]) : 1000000;
+    int writes = (argc > 2) ? std::stoi(argv[2]) : 20000;
+
+    std::vector<Poll> rescan_polls, live_polls;
+    IndexedInventory rescan{};
+    auto t0 = std::chrono::steady_clock::now();
+    replay(rescan, products, writes, rescan_polls);
+    double rescan_s = seconds_since(t0);
+
+    IndexedInventory live{};
+    set_live_stats_enabled(live, true);
+    t0 = std::chrono::steady_clock::now();
+    bool ok = replay(live, products, writes, live_polls);
+    double live_s = seconds_since(t0);
+
+    for (std::size_t i = 0; ok && i < rescan_polls.size(); ++i) {
+        const Poll& a = rescan_polls[i];
+        const Poll& b = live_polls[i];
+        ok = a.min == b.min && a.max == b.max && a.avg == b.avg;
+    }
+
+    std::cout << std::fixed << std::setprecision(3) << products << " products, " << writes
+              << " writes, stats() after each\n"
+              << "rescan " << std::setw(9) << rescan_s << " s\n"
+              << "live   " << std::setw(9) << live_s << " s  (includes the percentile checks)\n"
+              << (ok ? "results match\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
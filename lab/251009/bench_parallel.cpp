@@ -0,0 +1,89 @@
+// CENG241 - Benchmark: parallel sort_asc / stats scaling
+// ------------------------------------------------------
+// Fills a ledger with random stock values and measures, for 1, 2, 4, ...
+// threads up to the hardware thread count:
+//   - sort_asc (std::sort, single thread) as the baseline
+//   - parallel_sort_asc (radix sort on a work-stealing pool)
+//   - stats (single thread, vectorized) and parallel_stats
+// Every sorted result is checked against the std::sort result. With 1
+// thread both parallel functions fall back to the single-threaded ones.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread bench_parallel.cpp -o bench_parallel
+// ./bench_parallel [elements] [max_threads]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "inventory.hpp"
+#include "inventory_parallel.hpp"
+
+double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? std::stoi(argv[1]) : 10000000;
+    int max_threads = (argc > 2) ? std::stoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (max_threads < 1) max_threads = 1;
+
+    std::vector<int> values(n);
+    std::mt19937 rng(7);
+    for (int& v : values) v = static_cast<int>(rng() % 2000001) - 1000000; // include negatives
+
+    Inventory inv{nullptr, 0, 0};
+    create(inv, n);
+    for (int v : values) append(inv, v);
+
+    auto t0 = std::chrono::steady_clock::now();
+    sort_asc(inv);
+    double sort_ms = ms_since(t0);
+    std::vector<int> expected(inv.data, inv.data + n);
+
+    int mn = 0, mx = 0;
+    double avg = 0;
+    t0 = std::chrono::steady_clock::now();
+    stats(inv, mn, mx, avg);
+    double stats_ms = ms_since(t0);
+
+    std::cout << "Elements: " << n << "\n";
+    std::cout << "Baseline: sort_asc " << std::fixed << std::setprecision(2) << sort_ms
+              << " ms, stats " << stats_ms << " ms\n\n";
+    std::cout << std::setw(8) << "threads"
+              << std::setw(14) << "radix ms"
+              << std::setw(10) << "speedup"
+              << std::setw(14) << "stats ms"
+              << std::setw(10) << "speedup"
+              << "  check\n";
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool(threads);
+        std::copy(values.begin(), values.end(), inv.data);
+
+        t0 = std::chrono::steady_clock::now();
+        parallel_sort_asc(inv, pool);
+        double radix_ms = ms_since(t0);
+        bool ok = std::equal(expected.begin(), expected.end(), inv.data);
+
+        int pmn = 0, pmx = 0;
+        double pavg = 0;
+        t0 = std::chrono::steady_clock::now();
+        parallel_stats(inv, pool, pmn, pmx, pavg);
+        double pstats_ms = ms_since(t0);
+        ok = ok && pmn == mn && pmx == mx && pavg == avg;
+
+        std::cout << std::setw(8) << threads
+                  << std::setw(14) << radix_ms
+                  << std::setw(9) << sort_ms / radix_ms << "x"
+                  << std::setw(14) << pstats_ms
+                  << std::setw(9) << stats_ms / pstats_ms << "x"
+                  << "  " << (ok ? "ok" : "MISMATCH") << "\n";
+        if (threads * 2 > max_threads && threads != max_threads) threads = max_threads / 2; // always end at max
+    }
+
+    destroy(inv);
+    return 0;
+}
@@ -0,0 +1,114 @@
+// CENG241 - Benchmark: range queries by loop vs segment tree
+// ----------------------------------------------------------
+// A ledger of N products answers Q random "sum / min / max of products
+// [i, j)" and "which products in [i, j) are under T" questions, with a
+// point update (set_at) between every two questions:
+//   loop   scan the range each time
+//   tree   range_stats / find_below (inventory_range.hpp)
+// Then the ledger is sorted and receives 100000 point updates before the
+// next question: the tree must be rebuilt once, not 100000 times.
+// Every answer is checked against the loop.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread bench_range.cpp -o bench_range
+// ./bench_range [products] [queries]      (default 1000000 and 20000)
+
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "inventory_index.hpp"
+
+double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+struct Answer {
+    long long sum;
+    int min;
+    int max;
+    int below;
+};
+
+Answer loop_answer(const Inventory& inv, int first, int last, int threshold) {
+    Answer a{0, inv.data[first], inv.data[first], 0};
+    for (int i = first; i < last; ++i) {
+        int v = inv.data[i];
+        a.sum += v;
+        a.min = v < a.min ? v : a.min;
+        a.max = v > a.max ? v : a.max;
+        a.below += v < threshold;
+    }
+    return a;
+}
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? std::stoi(argv[1]) : 1000000;
+    int queries = (argc > 2) ? std::stoi(argv[2]) : 20000;
+
+    IndexedInventory led{};
+    create(led, n);
+    std::mt19937 rng(241);
+    for (int i = 0; i < n; ++i) append(led, static_cast<int>(rng() % 100000));
+
+    // The same questions and updates for both methods.
+    struct Step {
+        int first, last, threshold, update_at, update_to;
+    };
+    std::vector<Step> steps(queries);
+    for (Step& s : steps) {
+        s.first = static_cast<int>(rng() % n);
+        s.last = s.first + 1 + static_cast<int>(rng() % (n - s.first));
+        s.threshold = static_cast<int>(rng() % 5); // rare: a few products per range
+        s.update_at = static_cast<int>(rng() % n);
+        s.update_to = static_cast<int>(rng() % 100000);
+    }
+
+    std::vector<int> saved(led.inv.data, led.inv.data + n);
+    std::vector<Answer> expected(queries);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; ++q) {
+        const Step& s = steps[q];
+        expected[q] = loop_answer(led.inv, s.first, s.last, s.threshold);
+        led.inv.data[s.update_at] = s.update_to;
+    }
+    double loop_ms = ms_since(t0);
+
+    std::copy(saved.begin(), saved.end(), led.inv.data);
+    led.ranges.built = false; // the data was restored behind its back
+    bool ok = true;
+    std::vector<int> found;
+    t0 = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; ++q) {
+        const Step& s = steps[q];
+        Answer a{0, 0, 0, 0};
+        range_stats(led, s.first, s.last, a.sum, a.min, a.max);
+        a.below = find_below(led, s.first, s.last, s.threshold, found);
+        ok = ok && a.sum == expected[q].sum && a.min == expected[q].min && a.max == expected[q].max &&
+             a.below == expected[q].below;
+        set_at(led, s.update_at, s.update_to);
+    }
+    double tree_ms = ms_since(t0);
+
+    // Sort, then a burst of point updates, then one question.
+    sort_asc(led);
+    t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < 100000; ++k) set_at(led, static_cast<int>(rng() % n), static_cast<int>(rng() % 100000));
+    Answer a{0, 0, 0, 0};
+    range_stats(led, 0, n, a.sum, a.min, a.max);
+    double burst_ms = ms_since(t0);
+    Answer e = loop_answer(led.inv, 0, n, 0);
+    ok = ok && a.sum == e.sum && a.min == e.min && a.max == e.max;
+
+    std::cout << std::fixed << std::setprecision(2) << n << " products, " << queries
+              << " range questions with a point update between each\n"
+              << "loop  " << std::setw(10) << loop_ms << " ms\n"
+              << "tree  " << std::setw(10) << tree_ms << " ms (includes building the tree once)\n"
+              << "sort_asc + 100000 set_at + 1 question: " << burst_ms << " ms (one rebuild)\n"
+              << (ok ? "results match\n" : "RESULTS DIFFER\n");
+    destroy(led);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// CENG241 - Benchmark: flat array vs gap buffer vs chunked storage
+// ----------------------------------------------------------------
+// Runs the same sequence of insert_at/delete_at operations against:
+//   - Inventory        (inventory.hpp, the lab's flat array)
+//   - GapInventory     (inventory_gap.hpp)
+//   - ChunkedInventory (inventory_chunked.hpp)
+// for two edit patterns:
+//   localized: each edit lands within +-8 positions of the previous one
+//   random:    each edit lands at a uniformly random position
+// After each run the three ledgers are compared element by element, so the
+// benchmark also checks that all storage modes agree.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic bench_storage_modes.cpp -o bench_storage_modes
+// ./bench_storage_modes [edits_per_run]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "inventory.hpp"
+#include "inventory_gap.hpp"
+#include "inventory_chunked.hpp"
+
+struct Edit {
+    bool insert; // true: insert_at(index, value), false: delete_at(index)
+    int  index;
+    int  value;
+};
+
+// Generate 'count' edits for a ledger that starts with n elements.
+// Inserts and deletes alternate, so the size stays between n and n+1.
+std::vector<Edit> make_edits(int n, int count, bool localized, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<Edit> edits;
+    edits.reserve(count);
+    int size = n;
+    int cursor = n / 2;
+    for (int k = 0; k < count; ++k) {
+        bool insert = (k % 2 == 0);
+        int limit = insert ? size : size - 1; // valid index range is [0, limit]
+        int index;
+        if (localized) {
+            cursor += static_cast<int>(rng() % 17) - 8;
+            if (cursor < 0) cursor = 0;
+            if (cursor > limit) cursor = limit;
+            index = cursor;
+        } else {
+            index = static_cast<int>(rng() % static_cast<unsigned>(limit + 1));
+        }
+        edits.push_back(Edit{insert, index, static_cast<int>(rng() % 1000)});
+        size += insert ? 1 : -1;
+    }
+    return edits;
+}
+
+// Fill a ledger with 0..n-1, replay the edits, return milliseconds spent on the edits.
+template <typename Ledger>
+double run_edits(Ledger& inv, int n, const std::vector<Edit>& edits) {
+    create(inv, n + 1);
+    for (int i = 0; i < n; ++i) append(inv, i);
+    auto t0 = std::chrono::steady_clock::now();
+    for (const Edit& e : edits) {
+        if (e.insert) insert_at(inv, e.index, e.value);
+        else delete_at(inv, e.index);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    int edit_count = (argc > 1) ? std::stoi(argv[1]) : 20000;
+    const int sizes[] = {10000, 100000, 1000000};
+
+    std::cout << "Edits per run: " << edit_count << "\n";
+    std::cout << std::left << std::setw(10) << "pattern" << std::right
+              << std::setw(10) << "n"
+              << std::setw(14) << "flat ms"
+              << std::setw(14) << "gap ms"
+              << std::setw(14) << "chunked ms"
+              << "  check\n";
+
+    for (int localized = 1; localized >= 0; --localized) {
+        for (int n : sizes) {
+            std::vector<Edit> edits = make_edits(n, edit_count, localized != 0, 42u + n);
+
+            Inventory flat{nullptr, 0, 0};
+            GapInventory gap{nullptr, 0, 0, 0};
+            ChunkedInventory chunked{};
+            double t_flat = run_edits(flat, n, edits);
+            double t_gap = run_edits(gap, n, edits);
+            double t_chunked = run_edits(chunked, n, edits);
+
+            bool same = (flat.size == gap.size && flat.size == chunked.size);
+            for (int i = 0; same && i < flat.size; ++i) {
+                same = (flat.data[i] == get(gap, i) && flat.data[i] == get(chunked, i));
+            }
+
+            std::cout << std::left << std::setw(10) << (localized ? "localized" : "random") << std::right
+                      << std::setw(10) << n << std::fixed << std::setprecision(2)
+                      << std::setw(14) << t_flat
+                      << std::setw(14) << t_gap
+                      << std::setw(14) << t_chunked
+                      << "  " << (same ? "ok" : "MISMATCH") << "\n";
+
+            destroy(flat);
+            destroy(gap);
+            destroy(chunked);
+        }
+    }
+    return 0;
+}
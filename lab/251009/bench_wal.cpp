@@ -0,0 +1,115 @@
+// CENG241 - Benchmark: durable operations with a write-ahead log
+// --------------------------------------------------------------
+// Measures how many ledger changes per second can be made durable:
+//   1) fsync per op:  append, then wait until that record is on disk
+//   2) group commit:  append freely, wait once per batch of 'batch' ops
+//   3) N clients:     N threads, each waiting for every one of its own
+//                     records; their waits share fsyncs (classic group commit)
+// Then it reopens the ledger (snapshot + log replay) and checks that every
+// value came back.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread bench_wal.cpp -o bench_wal
+// ./bench_wal [dir] [ops] [clients]    (dir should be on the disk you care about)
+
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "inventory_wal.hpp"
+
+double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void report(const char* name, long long ops, double seconds, std::uint64_t fsyncs) {
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << ops / seconds << " ops/s  " << std::setw(8) << fsyncs << " fsyncs  "
+              << std::setprecision(1) << std::setw(8) << (fsyncs ? static_cast<double>(ops) / fsyncs : 0.0)
+              << " ops/fsync\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string dir = (argc > 1) ? argv[1] : ".";
+    int ops = (argc > 2) ? std::stoi(argv[2]) : 1000000;
+    int clients = (argc > 3) ? std::stoi(argv[3]) : 8;
+    std::string base = dir + "/bench_wal_ledger";
+    std::remove((base + ".snap").c_str());
+    std::remove((base + ".wal").c_str());
+
+    DurableInventory led;
+    if (!open_durable_inventory(led, base.c_str()) || !create(led, 1024)) {
+        std::cout << "Cannot open " << base << "\n";
+        return 1;
+    }
+
+    // 1) One fsync per operation (few ops: this is the slow baseline).
+    int slow_ops = std::min(ops, 2000);
+    std::uint64_t f0 = led.wal.fsyncs();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < slow_ops; ++i) {
+        append(led, i);
+        flush_durable_inventory(led);
+    }
+    report("fsync per op", slow_ops, seconds_since(t0), led.wal.fsyncs() - f0);
+
+    // 2) Group commit: the flusher batches on its own; we wait once per batch.
+    const int batch = 10000;
+    f0 = led.wal.fsyncs();
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < ops; ++i) {
+        append(led, i);
+        if ((i + 1) % batch == 0) flush_durable_inventory(led);
+    }
+    flush_durable_inventory(led);
+    report("group commit", ops, seconds_since(t0), led.wal.fsyncs() - f0);
+
+    // 3) Many clients that each need their own record durable before going on.
+    //    They share one log; only the log is touched here, not the ledger.
+    int per_client = std::max(1, std::min(ops, 200000) / clients);
+    f0 = led.wal.fsyncs();
+    t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    std::atomic<bool> log_failed{false};
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            for (int i = 0; i < per_client; ++i) {
+                if (!led.wal.wait_durable(led.wal.log(WalRecord{WAL_ADD_STOCK, c, i % 5, 1}))) {
+                    log_failed = true;
+                    return;
+                }
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    if (log_failed) {
+        std::cout << "Log write failed\n";
+        close_durable_inventory(led);
+        return 1;
+    }
+    report("clients wait each op", static_cast<long long>(per_client) * clients, seconds_since(t0),
+           led.wal.fsyncs() - f0);
+
+    // The client records are not ledger operations; fold the ledger into a
+    // snapshot so they are not replayed, then log a few more appends.
+    checkpoint_durable_inventory(led);
+    for (int i = 0; i < 1000; ++i) append(led, -i);
+    std::vector<int> expected(led.inv.data, led.inv.data + led.inv.size);
+    close_durable_inventory(led);
+
+    // Recovery: snapshot + replay must give back exactly the same ledger.
+    t0 = std::chrono::steady_clock::now();
+    DurableInventory again;
+    bool ok = open_durable_inventory(again, base.c_str())
+           && again.inv.size == static_cast<int>(expected.size())
+           && std::equal(expected.begin(), expected.end(), again.inv.data);
+    std::cout << "Recovery: " << (ok ? "ok" : "MISMATCH") << ", " << again.inv.size << " products in "
+              << std::setprecision(3) << seconds_since(t0) << " s\n";
+    close_durable_inventory(again);
+    std::remove((base + ".snap").c_str());
+    std::remove((base + ".wal").c_str());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+// CENG241 - Dynamic Inventory: the data structure and its operations
+// ------------------------------------------------------------------
+// This header holds `struct Inventory` and lab functions 1-12 (create,
+// destroy, reserve, append, insert_at, delete_at, find, print_inventory,
+// sort_asc, reverse, stats, show_size_capacity). The interactive menu lives
+// in lab_1.cpp; keeping the operations here lets other programs (benchmarks,
+// alternative storage modes) reuse exactly the same code.
+//
+// The functions are marked `inline` so this header can be included from
+// several .cpp files without "multiple definition" link errors.
+
+#ifndef CENG241_INVENTORY_HPP
+#define CENG241_INVENTORY_HPP
+
+#include <iostream>
+#include <algorithm> // for std::sort, std::swap
+#include <new>       // for std::nothrow
+#include "inventory_kernels.hpp" // vectorized find / reverse / stats
+#include "inventory_metrics.hpp" // counters + latency histograms (off unless INVENTORY_METRICS=1)
+#include "../ledger_alloc.hpp"    // optional arena / pool allocators
+#include "../out_buffer.hpp"      // print_inventory without per-number << calls
+
+struct Inventory {
+    int* data;     // pointer to the first element of a dynamic int array
+    int  size;     // how many elements are actually used
+    int  capacity; // how many elements are allocated
+    LedgerAllocator* alloc = nullptr; // where data comes from; nullptr = new[] / delete[]
+};
+
+// Allocation helpers: new[] / delete[] as in the lab, unless the ledger was
+// created with an allocator (see ../ledger_alloc.hpp).
+inline int* allocate_stock(const Inventory& inv, int count) {
+    if (inv.alloc) return static_cast<int*>(inv.alloc->allocate(static_cast<size_t>(count) * sizeof(int)));
+    return new (std::nothrow) int[count];
+}
+
+inline void release_stock(const Inventory& inv, int* data, int count) {
+    if (inv.alloc) inv.alloc->release(data, static_cast<size_t>(count) * sizeof(int));
+    else delete[] data; // delete[] must match new[]
+}
+
+// 1) create: allocate array with given initial capacity, set size=0
+//    'alloc' (optional) supplies the memory from now on, also for reserve.
+inline bool create(Inventory& inv, int initial_capacity, LedgerAllocator* alloc = nullptr) {
+    inv.alloc = alloc;
+    if (initial_capacity <= 0) {
+        std::cout << "Initial capacity must be positive.\n";
+        inv.data = nullptr;
+        inv.size = 0;
+        inv.capacity = 0;
+        return false;
+    }
+    // new int[initial_capacity] allocates space for 'initial_capacity' integers.
+    inv.data = allocate_stock(inv, initial_capacity);
+    if (!inv.data) {
+        std::cout << "Memory allocation failed!\n";
+        inv.size = 0;
+        inv.capacity = 0;
+        return false;
+    }
+    inv.size = 0;
+    inv.capacity = initial_capacity;
+    INVENTORY_COUNT_CAPACITY(initial_capacity);
+    return true;
+}
+
+// 2) destroy: free allocated memory and reset members
+inline void destroy(Inventory& inv) {
+    release_stock(inv, inv.data, inv.capacity);
+    inv.data = nullptr;
+    inv.size = 0;
+    inv.capacity = 0;
+}
+
+// Second half of reserve (below): move the items into new_data
+// (new_capacity ints from allocate_stock) and free the old array. It cannot
+// fail, so a caller that must not change anything before another step
+// worked (the write-ahead log in inventory_wal.hpp) allocates first and
+// adopts last.
+inline void adopt_stock(Inventory& inv, int* new_data, int new_capacity) {
+    // Copy as many elements as will fit
+    int elements_to_copy = (inv.size < new_capacity) ? inv.size : new_capacity;
+    INVENTORY_COUNT_REALLOC(new_capacity, elements_to_copy);
+    for (int i = 0; i < elements_to_copy; ++i) {
+        new_data[i] = inv.data[i];
+    }
+    release_stock(inv, inv.data, inv.capacity);
+    inv.data = new_data;
+    inv.capacity = new_capacity;
+    // If we shrank below current size, adjust size
+    if (inv.size > new_capacity) {
+        inv.size = new_capacity;
+    }
+}
+
+// 3) reserve: pre-allocate capacity (can grow or shrink)
+inline bool reserve(Inventory& inv, int new_capacity) {
+    if (new_capacity < 0) {
+        std::cout << "New capacity cannot be negative.\n";
+        return false;
+    }
+    if (new_capacity == inv.capacity) {
+        return true; // nothing to do
+    }
+    if (new_capacity == 0) {
+        // Free everything
+        destroy(inv);
+        return true;
+    }
+
+    int* new_data = allocate_stock(inv, new_capacity);
+    if (!new_data) {
+        std::cout << "Memory reallocation failed!\n";
+        return false;
+    }
+    adopt_stock(inv, new_data, new_capacity);
+    return true;
+}
+
+// Internal helper: grow capacity (e.g., double) when full
+inline bool ensure_capacity_for_one_more(Inventory& inv) {
+    if (inv.size < inv.capacity) return true;
+    int new_capacity = (inv.capacity == 0) ? 1 : inv.capacity * 2;
+    return reserve(inv, new_capacity);
+}
+
+// 4) append: add item to the end (grow if needed)
+inline bool append(Inventory& inv, int stock) {
+    INVENTORY_TIME_OP(METRIC_APPEND);
+    if (!ensure_capacity_for_one_more(inv)) {
+        return false;
+    }
+    inv.data[inv.size++] = stock;
+    return true;
+}
+
+// 5) insert_at: insert item at index, shift right
+inline bool insert_at(Inventory& inv, int index, int stock) {
+    INVENTORY_TIME_OP(METRIC_INSERT_AT);
+    if (index < 0 || index > inv.size) {
+        std::cout << "Index out of bounds.\n";
+        return false;
+    }
+    if (!ensure_capacity_for_one_more(inv)) {
+        return false;
+    }
+    // Shift elements [index..size-1] one position to the right
+    INVENTORY_COUNT_SHIFT(inv.size - index);
+    for (int i = inv.size - 1; i >= index; --i) {
+        inv.data[i + 1] = inv.data[i];
+    }
+    inv.data[index] = stock;
+    ++inv.size;
+    return true;
+}
+
+// 6) delete_at: remove item at index, shift left
+inline bool delete_at(Inventory& inv, int index) {
+    INVENTORY_TIME_OP(METRIC_DELETE_AT);
+    if (index < 0 || index >= inv.size) {
+        std::cout << "Index out of bounds.\n";
+        return false;
+    }
+    // Shift elements [index+1..size-1] left by one
+    INVENTORY_COUNT_SHIFT(inv.size - index - 1);
+    for (int i = index + 1; i < inv.size; ++i) {
+        inv.data[i - 1] = inv.data[i];
+    }
+    --inv.size;
+    return true;
+}
+
+// 7) find: return first index whose value == target, else -1
+//    The linear search runs in a vectorized kernel (inventory_kernels.hpp)
+//    that compares 4 or 8 ints per instruction when the CPU supports it.
+inline int find(const Inventory& inv, int target) {
+    INVENTORY_TIME_OP(METRIC_FIND);
+    return inventory_kernels().find(inv.data, inv.size, target);
+}
+
+// 8) print: dump list with size/capacity
+//    Same text as `std::cout << ...` per element, but formatted into one
+//    reusable buffer and written with one write(2) per MiB
+//    (../out_buffer.hpp), so a 10M-entry list prints in well under a second.
+//    For a window of a large ledger see print_inventory_page (../ledger_export.hpp).
+inline void print_inventory(const Inventory& inv) {
+    std::cout.flush(); // earlier std::cout text must come first
+    OutBuffer& out = stdout_buffer();
+    out_str(out, "📦 Stock List (size = ");
+    out_int(out, inv.size);
+    out_str(out, " / capacity = ");
+    out_int(out, inv.capacity);
+    out_str(out, "):\n[");
+    for (int i = 0; i < inv.size; ++i) {
+        if (i) out_str(out, ", ");
+        out_int(out, inv.data[i]);
+    }
+    out_str(out, "]\n");
+    out_flush(out);
+}
+
+// 9) sort_asc: sort from low to high
+inline void sort_asc(Inventory& inv) {
+    INVENTORY_TIME_OP(METRIC_SORT_ASC);
+    std::sort(inv.data, inv.data + inv.size);
+}
+
+// 10) reverse: in-place reversal
+//     Swaps whole blocks from both ends and flips each block with a
+//     shuffle instruction; see reverse_scalar for the plain swap loop.
+inline void reverse(Inventory& inv) {
+    inventory_kernels().reverse(inv.data, inv.size);
+}
+
+// 11) stats: compute min, max, average; return false if empty
+inline bool stats(const Inventory& inv, int& out_min, int& out_max, double& out_avg) {
+    if (inv.size == 0) return false;
+    // One branchless pass computes all three; the sum is kept in 64-bit
+    // lanes to avoid overflow on large arrays.
+    MinMaxSum r = inventory_kernels().minmaxsum(inv.data, inv.size);
+    out_min = r.min;
+    out_max = r.max;
+    out_avg = static_cast<double>(r.sum) / inv.size;
+    return true;
+}
+
+// 12) show_size_capacity: prints current size/capacity
+inline void show_size_capacity(const Inventory& inv) {
+    std::cout << "Size: " << inv.size << ", Capacity: " << inv.capacity << "\n";
+}
+
+#endif // CENG241_INVENTORY_HPP
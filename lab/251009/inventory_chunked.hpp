@@ -0,0 +1,201 @@
+// CENG241 - Chunked Inventory (alternate storage for random edits)
+// ----------------------------------------------------------------
+// The flat Inventory shifts up to n elements per insert_at/delete_at. A
+// gap buffer (inventory_gap.hpp) fixes that for edits near one position,
+// but a jump across the ledger still moves O(n) elements.
+//
+// Here the ledger is split into small fixed-size *chunks* (at most
+// CHUNK_CAPACITY ints each), like the leaves of a B-tree:
+//
+//   chunks:   [12 40 7] [99 18] [25 3 61 8] ...
+//   counts:       3        2         4
+//
+// - An edit only shifts elements INSIDE one chunk: at most CHUNK_CAPACITY.
+// - To find which chunk holds logical index i we need prefix sums of the
+//   chunk counts. A Fenwick (binary indexed) tree keeps those sums and
+//   answers "which chunk contains index i?" in O(log(number of chunks)).
+// - A full chunk is split in two; an emptied chunk is removed and a tiny
+//   chunk is merged with its neighbour. Those events shift the chunk
+//   directory and rebuild the Fenwick tree (O(n / CHUNK_CAPACITY)), but they
+//   happen at most once every ~CHUNK_CAPACITY/2 edits, so the amortized cost
+//   per edit stays O(log n + CHUNK_CAPACITY), i.e. O(log n) for a constant
+//   chunk size.
+//
+// The free functions mirror inventory.hpp (create, destroy, append,
+// insert_at, delete_at, find) plus get(). Like inventory_gap.hpp they
+// return false on bad input instead of printing.
+
+#ifndef CENG241_INVENTORY_CHUNKED_HPP
+#define CENG241_INVENTORY_CHUNKED_HPP
+
+#include <cstring> // std::memmove, std::memcpy
+#include <new>     // std::nothrow
+#include <vector>
+
+const int CHUNK_CAPACITY = 1024; // ints per chunk (4 KiB, one page)
+
+struct Chunk {
+    int* items; // CHUNK_CAPACITY slots
+    int  count; // used slots
+};
+
+struct ChunkedInventory {
+    std::vector<Chunk> chunks;  // the chunk directory, in logical order
+    std::vector<int>   fenwick; // 1-based Fenwick tree over chunk counts
+    int size;                   // total number of elements
+};
+
+// --- Fenwick tree helpers --------------------------------------------------
+
+// Rebuild the tree from the chunk counts in O(number of chunks).
+inline void rebuild_fenwick(ChunkedInventory& inv) {
+    int n = static_cast<int>(inv.chunks.size());
+    inv.fenwick.assign(n + 1, 0);
+    for (int c = 1; c <= n; ++c) {
+        inv.fenwick[c] += inv.chunks[c - 1].count;
+        int parent = c + (c & -c);
+        if (parent <= n) inv.fenwick[parent] += inv.fenwick[c];
+    }
+}
+
+// Add delta to the count of chunk c (0-based).
+inline void fenwick_add(ChunkedInventory& inv, int c, int delta) {
+    int n = static_cast<int>(inv.chunks.size());
+    for (int i = c + 1; i <= n; i += i & -i) inv.fenwick[i] += delta;
+}
+
+// Find the chunk holding logical index 'index' (0 <= index < size).
+// On return 'offset' is the position inside that chunk.
+inline int locate_chunk(const ChunkedInventory& inv, int index, int& offset) {
+    int n = static_cast<int>(inv.chunks.size());
+    int pos = 0;
+    int step = 1;
+    while (step * 2 <= n) step *= 2;
+    // Classic Fenwick "lower bound": walk down powers of two, skipping whole
+    // blocks of chunks whose elements all come before 'index'.
+    for (; step > 0; step /= 2) {
+        if (pos + step <= n && inv.fenwick[pos + step] <= index) {
+            pos += step;
+            index -= inv.fenwick[pos];
+        }
+    }
+    offset = index;
+    return pos; // 0-based chunk number
+}
+
+inline bool new_chunk(Chunk& chunk) {
+    chunk.items = new (std::nothrow) int[CHUNK_CAPACITY];
+    chunk.count = 0;
+    return chunk.items != nullptr;
+}
+
+// --- Public API --------------------------------------------------------
+
+inline void destroy(ChunkedInventory& inv) {
+    for (Chunk& c : inv.chunks) delete[] c.items;
+    inv.chunks.clear();
+    inv.fenwick.assign(1, 0);
+    inv.size = 0;
+}
+
+inline bool create(ChunkedInventory& inv, int initial_capacity) {
+    destroy(inv); // chunks from an earlier create would leak otherwise
+    if (initial_capacity <= 0) return false;
+    inv.chunks.reserve(initial_capacity / CHUNK_CAPACITY + 1);
+    return true;
+}
+
+inline int get(const ChunkedInventory& inv, int i) {
+    int offset;
+    int c = locate_chunk(inv, i, offset);
+    return inv.chunks[c].items[offset];
+}
+
+inline bool insert_at(ChunkedInventory& inv, int index, int stock) {
+    if (index < 0 || index > inv.size) return false;
+
+    int c, offset;
+    if (inv.chunks.empty()) {
+        Chunk first;
+        if (!new_chunk(first)) return false;
+        inv.chunks.push_back(first);
+        rebuild_fenwick(inv);
+        c = 0;
+        offset = 0;
+    } else if (index == inv.size) {
+        c = static_cast<int>(inv.chunks.size()) - 1; // append to the last chunk
+        offset = inv.chunks[c].count;
+    } else {
+        c = locate_chunk(inv, index, offset);
+    }
+
+    if (inv.chunks[c].count == CHUNK_CAPACITY) {
+        // Split: move the upper half into a fresh chunk right after this one.
+        Chunk upper;
+        if (!new_chunk(upper)) return false;
+        int half = CHUNK_CAPACITY / 2;
+        upper.count = CHUNK_CAPACITY - half;
+        std::memcpy(upper.items, inv.chunks[c].items + half, upper.count * sizeof(int));
+        inv.chunks[c].count = half;
+        inv.chunks.insert(inv.chunks.begin() + c + 1, upper);
+        rebuild_fenwick(inv);
+        if (offset > half) {
+            ++c;
+            offset -= half;
+        }
+    }
+
+    Chunk& chunk = inv.chunks[c];
+    std::memmove(chunk.items + offset + 1, chunk.items + offset, (chunk.count - offset) * sizeof(int));
+    chunk.items[offset] = stock;
+    ++chunk.count;
+    ++inv.size;
+    fenwick_add(inv, c, +1);
+    return true;
+}
+
+inline bool append(ChunkedInventory& inv, int stock) {
+    return insert_at(inv, inv.size, stock);
+}
+
+inline bool delete_at(ChunkedInventory& inv, int index) {
+    if (index < 0 || index >= inv.size) return false;
+    int offset;
+    int c = locate_chunk(inv, index, offset);
+    Chunk& chunk = inv.chunks[c];
+    std::memmove(chunk.items + offset, chunk.items + offset + 1, (chunk.count - offset - 1) * sizeof(int));
+    --chunk.count;
+    --inv.size;
+
+    int next = c + 1;
+    if (chunk.count == 0) {
+        delete[] chunk.items;
+        inv.chunks.erase(inv.chunks.begin() + c);
+        rebuild_fenwick(inv);
+    } else if (chunk.count < CHUNK_CAPACITY / 4 && next < static_cast<int>(inv.chunks.size())
+               && chunk.count + inv.chunks[next].count <= CHUNK_CAPACITY / 2) {
+        // Merge two small neighbours so the directory does not fill up
+        // with nearly empty chunks after many deletions.
+        std::memcpy(chunk.items + chunk.count, inv.chunks[next].items, inv.chunks[next].count * sizeof(int));
+        chunk.count += inv.chunks[next].count;
+        delete[] inv.chunks[next].items;
+        inv.chunks.erase(inv.chunks.begin() + next);
+        rebuild_fenwick(inv);
+    } else {
+        fenwick_add(inv, c, -1);
+    }
+    return true;
+}
+
+inline int find(const ChunkedInventory& inv, int target) {
+    int base = 0;
+    for (const Chunk& chunk : inv.chunks) {
+        for (int i = 0; i < chunk.count; ++i) {
+            if (chunk.items[i] == target) return base + i;
+        }
+        base += chunk.count;
+    }
+    return -1;
+}
+
+#endif // CENG241_INVENTORY_CHUNKED_HPP
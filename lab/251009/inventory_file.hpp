@@ -0,0 +1,119 @@
+// CENG241 - Persistent Inventory backed by a memory-mapped file
+// -------------------------------------------------------------
+// A MappedInventory is the lab's Inventory whose `data` pointer points
+// INTO a memory-mapped ledger file (see ../ledger_file.hpp) instead of into
+// a new[] block. Restarting a program is then just "open the file": the
+// stock values are already there, no re-ingest needed.
+//
+// Only the operations that allocate need their own version here:
+//   reserve / append / insert_at grow the FILE (ftruncate + mremap) instead
+//   of allocating a new array and copying.
+// Everything else (delete_at, find, sort_asc, reverse, stats, print) is the
+// unchanged lab function applied to led.inv.
+//
+// After each change call sync_inventory_size(led) (the mapped functions here
+// already do) so the header's size matches inv.size.
+//
+// Usage:
+//   MappedInventory led;
+//   bool ok = ledger_file_exists("stock.inv")  // never create over a file we can't open
+//           ? open_inventory_file(led, "stock.inv")
+//           : create_inventory_file(led, "stock.inv", 1024);
+//   if (!ok) return 1;
+//   append(led, 25);
+//   sort_asc(led.inv);
+//   close_inventory_file(led);
+
+#ifndef CENG241_INVENTORY_FILE_HPP
+#define CENG241_INVENTORY_FILE_HPP
+
+#include <limits>
+#include "inventory.hpp"
+#include "../ledger_file.hpp"
+
+struct MappedInventory {
+    Inventory  inv;  // data points into file.payload; never delete[] it
+    MappedFile file;
+};
+
+inline void sync_inventory_size(MappedInventory& led) {
+    led.file.header->size = static_cast<std::uint64_t>(led.inv.size);
+}
+
+// Re-point inv at the (possibly moved) mapping.
+inline void refresh_inventory_view(MappedInventory& led) {
+    led.inv.data = led.file.payload;
+    led.inv.capacity = static_cast<int>(led.file.header->capacity);
+    led.inv.size = static_cast<int>(led.file.header->size);
+}
+
+inline bool create_inventory_file(MappedInventory& led, const char* path, int initial_capacity) {
+    led.inv = Inventory{nullptr, 0, 0};
+    if (initial_capacity <= 0) return false;
+    if (!ledger_file_create(led.file, path, LEDGER_KIND_INVENTORY, static_cast<std::size_t>(initial_capacity))) return false;
+    refresh_inventory_view(led);
+    return true;
+}
+
+inline bool open_inventory_file(MappedInventory& led, const char* path, bool verify = false) {
+    led.inv = Inventory{nullptr, 0, 0};
+    if (!ledger_file_open(led.file, path, LEDGER_KIND_INVENTORY, verify)) return false;
+    if (led.file.header->capacity > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+        ledger_file_discard(led.file); // leave the rejected file as it was
+        return false;
+    }
+    refresh_inventory_view(led);
+    return true;
+}
+
+inline bool close_inventory_file(MappedInventory& led) {
+    if (!led.file.base) return true;
+    sync_inventory_size(led);
+    bool ok = ledger_file_close(led.file);
+    led.inv = Inventory{nullptr, 0, 0};
+    return ok;
+}
+
+// Flush to disk and record a checksum, without closing.
+inline bool checkpoint_inventory_file(MappedInventory& led) {
+    sync_inventory_size(led);
+    return ledger_file_sync(led.file);
+}
+
+// 3) reserve: resize the file instead of copying into a new array.
+inline bool reserve(MappedInventory& led, int new_capacity) {
+    if (new_capacity <= 0) return false; // a mapped ledger keeps at least one slot
+    if (!ledger_file_resize(led.file, static_cast<std::size_t>(new_capacity))) return false;
+    if (led.inv.size > new_capacity) led.inv.size = new_capacity; // shrunk below size
+    sync_inventory_size(led);
+    refresh_inventory_view(led);
+    return true;
+}
+
+inline bool ensure_capacity_for_one_more(MappedInventory& led) {
+    if (led.inv.size < led.inv.capacity) return true;
+    return reserve(led, led.inv.capacity * 2);
+}
+
+inline bool append(MappedInventory& led, int stock) {
+    if (!ensure_capacity_for_one_more(led)) return false;
+    append(led.inv, stock); // has room now, so it never reallocates
+    sync_inventory_size(led);
+    return true;
+}
+
+inline bool insert_at(MappedInventory& led, int index, int stock) {
+    if (index < 0 || index > led.inv.size) return insert_at(led.inv, index, stock); // prints the error
+    if (!ensure_capacity_for_one_more(led)) return false;
+    insert_at(led.inv, index, stock);
+    sync_inventory_size(led);
+    return true;
+}
+
+inline bool delete_at(MappedInventory& led, int index) {
+    if (!delete_at(led.inv, index)) return false;
+    sync_inventory_size(led);
+    return true;
+}
+
+#endif // CENG241_INVENTORY_FILE_HPP
@@ -0,0 +1,133 @@
+// CENG241 - Gap-buffer Inventory (alternate storage for localized edits)
+// ----------------------------------------------------------------------
+// In the flat Inventory (inventory.hpp), insert_at/delete_at shift EVERY
+// later element by one slot, so each mid-list edit costs O(n).
+//
+// A *gap buffer* keeps the free capacity as a "hole" INSIDE the array,
+// right where the last edit happened (text editors use the same trick):
+//
+//   logical:  [ 10 20 30 | 40 50 ]         (edit position after 30)
+//   physical: [ 10 20 30 _ _ _ _ 40 50 ]
+//                        ^gap_start      gap length = capacity - size
+//
+// - Inserting at the gap just writes into the hole: O(1).
+// - Deleting next to the gap just widens the hole: O(1).
+// - Editing somewhere else first MOVES the gap there, which costs one
+//   memmove of the elements in between. So edits that stay near the same
+//   position (the common case for operators) are O(1) amortized, while a
+//   jump across the whole ledger costs O(distance).
+//   For uniformly random positions see ChunkedInventory (inventory_chunked.hpp).
+//
+// The free functions mirror inventory.hpp (create, destroy, append,
+// insert_at, delete_at, find) plus get() for reading by logical index.
+// They return false on bad input instead of printing, so batch and
+// benchmark code stay quiet.
+
+#ifndef CENG241_INVENTORY_GAP_HPP
+#define CENG241_INVENTORY_GAP_HPP
+
+#include <cstring> // std::memcpy, std::memmove
+#include <new>     // std::nothrow
+
+struct GapInventory {
+    int* data;      // physical array of 'capacity' ints
+    int  size;      // number of stored elements
+    int  capacity;  // allocated slots
+    int  gap_start; // physical index where the hole begins
+};
+
+// Length of the hole: every slot not holding an element belongs to it.
+inline int gap_length(const GapInventory& inv) {
+    return inv.capacity - inv.size;
+}
+
+inline bool create(GapInventory& inv, int initial_capacity) {
+    inv.data = nullptr;
+    inv.size = 0;
+    inv.capacity = 0;
+    inv.gap_start = 0;
+    if (initial_capacity <= 0) return false;
+    inv.data = new (std::nothrow) int[initial_capacity];
+    if (!inv.data) return false;
+    inv.capacity = initial_capacity;
+    return true;
+}
+
+inline void destroy(GapInventory& inv) {
+    delete[] inv.data;
+    inv.data = nullptr;
+    inv.size = 0;
+    inv.capacity = 0;
+    inv.gap_start = 0;
+}
+
+// Read the element at logical index i (caller checks 0 <= i < size).
+inline int get(const GapInventory& inv, int i) {
+    return (i < inv.gap_start) ? inv.data[i] : inv.data[i + gap_length(inv)];
+}
+
+// Move the hole so that it starts at logical position pos.
+inline void move_gap(GapInventory& inv, int pos) {
+    int gap = gap_length(inv);
+    if (pos < inv.gap_start) {
+        // Elements [pos, gap_start) jump over the hole to the right.
+        int n = inv.gap_start - pos;
+        std::memmove(inv.data + pos + gap, inv.data + pos, n * sizeof(int));
+    } else if (pos > inv.gap_start) {
+        // Elements right after the hole jump over it to the left.
+        int n = pos - inv.gap_start;
+        std::memmove(inv.data + inv.gap_start, inv.data + inv.gap_start + gap, n * sizeof(int));
+    }
+    inv.gap_start = pos;
+}
+
+// Double the capacity; the new slots all join the hole.
+inline bool grow_gap(GapInventory& inv) {
+    int new_capacity = (inv.capacity == 0) ? 16 : inv.capacity * 2;
+    int* new_data = new (std::nothrow) int[new_capacity];
+    if (!new_data) return false;
+    int tail = inv.size - inv.gap_start; // elements after the hole
+    std::memcpy(new_data, inv.data, inv.gap_start * sizeof(int));
+    std::memcpy(new_data + new_capacity - tail, inv.data + inv.capacity - tail, tail * sizeof(int));
+    delete[] inv.data;
+    inv.data = new_data;
+    inv.capacity = new_capacity;
+    return true;
+}
+
+inline bool insert_at(GapInventory& inv, int index, int stock) {
+    if (index < 0 || index > inv.size) return false;
+    if (gap_length(inv) == 0 && !grow_gap(inv)) return false;
+    move_gap(inv, index);
+    inv.data[inv.gap_start++] = stock;
+    ++inv.size;
+    return true;
+}
+
+inline bool append(GapInventory& inv, int stock) {
+    return insert_at(inv, inv.size, stock);
+}
+
+inline bool delete_at(GapInventory& inv, int index) {
+    if (index < 0 || index >= inv.size) return false;
+    // With the hole at 'index', the element to delete sits right after it;
+    // shrinking size makes the hole swallow it.
+    move_gap(inv, index);
+    --inv.size;
+    return true;
+}
+
+// First logical index holding target, else -1. Two plain scans: before
+// and after the hole.
+inline int find(const GapInventory& inv, int target) {
+    for (int i = 0; i < inv.gap_start; ++i) {
+        if (inv.data[i] == target) return i;
+    }
+    int gap = gap_length(inv);
+    for (int i = inv.gap_start; i < inv.size; ++i) {
+        if (inv.data[i + gap] == target) return i;
+    }
+    return -1;
+}
+
+#endif // CENG241_INVENTORY_GAP_HPP
@@ -0,0 +1,273 @@
+// CENG241 - Generic Inventory (template version of lab_1's struct Inventory)
+// ---------------------------------------------------------------------------
+// lab_1.cpp stores plain `int` stock counts and, when it runs out of room,
+// allocates a new array and copies element by element. That is fine for
+// learning, but real records are richer (SKU, quantity, price) and the copy
+// loop dominates append-heavy workloads.
+//
+// This header keeps the SAME idea (data pointer + size + capacity, manual
+// growth) but makes it generic:
+//
+//   ledger::Inventory<T, GrowthPolicy>
+//
+// - T can be any type. If T is *trivially copyable* (ints, doubles, plain
+//   structs of them) we grow with std::realloc, which can often extend the
+//   block in place (no copy at all) and otherwise copies with one memcpy.
+//   For other types (e.g. std::string members) we MOVE each element into the
+//   new block instead of copying it. Over-aligned types (alignas(64) ...)
+//   get their blocks from the aligned operator new, since malloc does not
+//   honour alignof(T).
+// - GrowthPolicy decides the next capacity when the array is full:
+//     GrowDouble        -> 2x (what lab_1 does)
+//     GrowOneAndHalf    -> 1.5x (less wasted memory, more reallocations)
+//     GrowPageChunks<N> -> round up to whole N-byte chunks (default 4 KiB pages)
+//   A policy is just a struct with a static `next_capacity` function, so you
+//   can write your own.
+//
+// Error handling follows lab_1: functions return bool (false on failure)
+// instead of throwing.
+//
+// Example:
+//   struct Record { int sku; int qty; double price; };
+//   ledger::Inventory<Record, ledger::GrowOneAndHalf> inv;
+//   inv.append(Record{1001, 25, 3.5});
+
+#ifndef CENG241_INVENTORY_GENERIC_HPP
+#define CENG241_INVENTORY_GENERIC_HPP
+
+#include <cstddef>     // std::size_t, std::max_align_t
+#include <cstdlib>     // std::malloc, std::realloc, std::free
+#include <cstring>     // std::memmove, std::memcpy
+#include <new>         // placement new, aligned operator new
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::move, std::swap
+
+namespace ledger {
+
+// --- Growth policies -------------------------------------------------------
+// Each policy answers: "the array holds `current` elements of `elem_size`
+// bytes and we need at least `required`; what capacity should we allocate?"
+
+struct GrowDouble {
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t /*elem_size*/) {
+        std::size_t next = (current == 0) ? 1 : current * 2;
+        return next < required ? required : next;
+    }
+};
+
+struct GrowOneAndHalf {
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t /*elem_size*/) {
+        std::size_t next = (current < 2) ? current + 1 : current + current / 2;
+        return next < required ? required : next;
+    }
+};
+
+// Grows by whole chunks of ChunkBytes (a page by default), so the allocator
+// hands out page-sized blocks and realloc can often remap instead of copy.
+template <std::size_t ChunkBytes = 4096>
+struct GrowPageChunks {
+    static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t elem_size) {
+        std::size_t want = current * 2;
+        if (want < required) want = required;
+        std::size_t bytes = want * elem_size;
+        bytes = (bytes + ChunkBytes - 1) / ChunkBytes * ChunkBytes;
+        return bytes / elem_size;
+    }
+};
+
+// --- The container ---------------------------------------------------------
+
+template <typename T, typename GrowthPolicy = GrowDouble>
+class Inventory {
+public:
+    Inventory() : data_(nullptr), size_(0), capacity_(0) {}
+
+    ~Inventory() { destroy(); }
+
+    // Owning raw memory: copying would double-free, so only moves are allowed.
+    Inventory(const Inventory&) = delete;
+    Inventory& operator=(const Inventory&) = delete;
+
+    Inventory(Inventory&& other) noexcept
+        : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    Inventory& operator=(Inventory&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+        return *this;
+    }
+
+    // 1) create: allocate the initial capacity (size stays 0).
+    bool create(std::size_t initial_capacity) {
+        destroy();
+        if (initial_capacity == 0) return false;
+        return reallocate(initial_capacity);
+    }
+
+    // 2) destroy: run destructors (if any) and free the block.
+    void destroy() {
+        destroy_range(0, size_);
+        free_block(data_);
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+    }
+
+    // 3) reserve: grow or shrink to exactly new_capacity elements.
+    bool reserve(std::size_t new_capacity) {
+        if (new_capacity == capacity_) return true;
+        if (new_capacity == 0) {
+            destroy();
+            return true;
+        }
+        return reallocate(new_capacity); // drops elements past new_capacity only once it worked
+    }
+
+    // 4) append: add to the end. Taking T by value lets callers move in.
+    bool append(T value) {
+        if (!ensure_capacity_for_one_more()) return false;
+        new (data_ + size_) T(std::move(value));
+        ++size_;
+        return true;
+    }
+
+    // 5) insert_at: shift [index..size) one slot right, then place value.
+    bool insert_at(std::size_t index, T value) {
+        if (index > size_) return false;
+        if (!ensure_capacity_for_one_more()) return false;
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(data_ + index + 1), data_ + index, (size_ - index) * sizeof(T));
+            new (data_ + index) T(std::move(value));
+        } else if (index == size_) {
+            new (data_ + size_) T(std::move(value));
+        } else {
+            // Move-construct the last element into the fresh slot, then move
+            // the rest one step right (assignment into live objects).
+            new (data_ + size_) T(std::move(data_[size_ - 1]));
+            for (std::size_t i = size_ - 1; i > index; --i) {
+                data_[i] = std::move(data_[i - 1]);
+            }
+            data_[index] = std::move(value);
+        }
+        ++size_;
+        return true;
+    }
+
+    // 6) delete_at: shift [index+1..size) one slot left.
+    bool delete_at(std::size_t index) {
+        if (index >= size_) return false;
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(data_ + index), data_ + index + 1, (size_ - index - 1) * sizeof(T));
+        } else {
+            for (std::size_t i = index + 1; i < size_; ++i) {
+                data_[i - 1] = std::move(data_[i]);
+            }
+            data_[size_ - 1].~T();
+        }
+        --size_;
+        return true;
+    }
+
+    // 7) find: first index whose element satisfies `pred`, or -1.
+    //    Use e.g. inv.find_if([](const Record& r) { return r.qty == 0; });
+    template <typename Pred>
+    long long find_if(Pred pred) const {
+        for (std::size_t i = 0; i < size_; ++i) {
+            if (pred(data_[i])) return static_cast<long long>(i);
+        }
+        return -1;
+    }
+
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    T*          data_;     // first element (raw block, see allocate_block)
+    std::size_t size_;     // used slots
+    std::size_t capacity_; // allocated slots
+
+    bool ensure_capacity_for_one_more() {
+        if (size_ < capacity_) return true;
+        return reallocate(GrowthPolicy::next_capacity(capacity_, size_ + 1, sizeof(T)));
+    }
+
+    void destroy_range(std::size_t from, std::size_t to) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (std::size_t i = from; i < to; ++i) data_[i].~T();
+        }
+    }
+
+    // malloc only promises alignof(std::max_align_t); an over-aligned T
+    // (e.g. alignas(64) records) needs the aligned operator new.
+    static constexpr bool over_aligned = alignof(T) > alignof(std::max_align_t);
+
+    static T* allocate_block(std::size_t count) {
+        if constexpr (over_aligned) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T)), std::nothrow));
+        } else {
+            return static_cast<T*>(std::malloc(count * sizeof(T)));
+        }
+    }
+
+    static void free_block(T* p) {
+        if constexpr (over_aligned) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        } else {
+            std::free(p);
+        }
+    }
+
+    // Change the block to hold exactly new_capacity elements, keeping the
+    // first min(size_, new_capacity). On failure nothing changes: elements
+    // past new_capacity are destroyed only once the new block is in place.
+    bool reallocate(std::size_t new_capacity) {
+        if (new_capacity > static_cast<std::size_t>(-1) / sizeof(T)) return false; // byte count would overflow
+        std::size_t keep = size_ < new_capacity ? size_ : new_capacity;
+        if constexpr (std::is_trivially_copyable<T>::value && !over_aligned) {
+            // realloc may extend the block in place; if it has to move it,
+            // it copies the bytes for us (one memcpy, not a per-element loop).
+            // Trivially copyable types have trivial destructors, so the
+            // elements cut off by a shrink need no cleanup.
+            void* p = std::realloc(data_, new_capacity * sizeof(T));
+            if (!p) return false; // old block is still valid
+            data_ = static_cast<T*>(p);
+        } else {
+            T* p = allocate_block(new_capacity);
+            if (!p) return false;
+            if constexpr (std::is_trivially_copyable<T>::value) {
+                if (keep) std::memcpy(static_cast<void*>(p), data_, keep * sizeof(T));
+            } else {
+                for (std::size_t i = 0; i < keep; ++i) new (p + i) T(std::move(data_[i]));
+                destroy_range(0, size_); // moved-from elements and the ones cut off
+            }
+            free_block(data_);
+            data_ = p;
+        }
+        size_ = keep;
+        capacity_ = new_capacity;
+        return true;
+    }
+};
+
+} // namespace ledger
+
+#endif // CENG241_INVENTORY_GENERIC_HPP
@@ -0,0 +1,85 @@
+// CENG241 - Generic Inventory demo
+// --------------------------------
+// Shows ledger::Inventory<T, GrowthPolicy> from inventory_generic.hpp with:
+// - a trivially copyable record (grown with realloc / memmove)
+// - a record holding a std::string (grown by moving elements)
+// - the three growth policies, and how many reallocations each one needs
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic inventory_generic_demo.cpp -o inventory_generic_demo
+// ./inventory_generic_demo
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include "inventory_generic.hpp"
+
+// A plain struct of numbers is trivially copyable.
+struct Record {
+    int    sku;
+    int    qty;
+    double price;
+};
+
+// std::string is NOT trivially copyable, so this record is moved on growth.
+struct NamedRecord {
+    std::string name;
+    int         qty;
+};
+
+// Append n records and report how often the capacity changed and how long it took.
+template <typename Policy>
+void growth_report(const char* label, int n) {
+    ledger::Inventory<Record, Policy> inv;
+    int reallocations = 0;
+    std::size_t last_capacity = inv.capacity();
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        inv.append(Record{i, i % 100, 1.25 * i});
+        if (inv.capacity() != last_capacity) {
+            ++reallocations;
+            last_capacity = inv.capacity();
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::cout << std::left << std::setw(18) << label << std::right
+              << " size = " << inv.size()
+              << ", capacity = " << inv.capacity()
+              << ", reallocations = " << reallocations
+              << ", time = " << std::fixed << std::setprecision(2)
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+}
+
+int main() {
+    std::cout << "=== Trivially copyable records ===\n";
+    ledger::Inventory<Record> shelf;
+    shelf.create(2);
+    shelf.append(Record{1001, 25, 3.50});
+    shelf.append(Record{1002, 12, 1.20});
+    shelf.append(Record{1003, 40, 7.99}); // grows 2 -> 4
+    shelf.insert_at(1, Record{1004, 99, 0.50});
+    shelf.delete_at(0);
+    for (const Record& r : shelf) {
+        std::cout << "SKU " << r.sku << ": qty " << r.qty << ", price " << r.price << "\n";
+    }
+    long long low_pos = shelf.find_if([](const Record& r) { return r.qty < 20; });
+    std::cout << "First low-stock record at index: " << low_pos << "\n";
+
+    std::cout << "\n=== Records with a std::string (moved, not copied) ===\n";
+    ledger::Inventory<NamedRecord, ledger::GrowOneAndHalf> named;
+    named.append(NamedRecord{"pencil", 120});
+    named.append(NamedRecord{"eraser", 35});
+    named.insert_at(0, NamedRecord{"notebook", 60});
+    for (const NamedRecord& r : named) {
+        std::cout << r.name << ": " << r.qty << "\n";
+    }
+
+    std::cout << "\n=== Growth policies (1,000,000 appends) ===\n";
+    growth_report<ledger::GrowDouble>("GrowDouble", 1000000);
+    growth_report<ledger::GrowOneAndHalf>("GrowOneAndHalf", 1000000);
+    growth_report<ledger::GrowPageChunks<>>("GrowPageChunks", 1000000);
+    return 0;
+}
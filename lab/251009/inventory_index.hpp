@@ -0,0 +1,409 @@
+// CENG241 - Secondary index for Inventory::find
+// ---------------------------------------------
+// find() in inventory.hpp scans the array from the start: O(n) per query.
+// When the same ledger answers thousands of "which product has exactly N
+// units?" queries per second, it pays to keep an INDEX next to the data:
+//
+// 1) Hash index: value -> first index holding that value.
+//    An open-addressing table (one flat array of slots, linear probing),
+//    so a lookup is O(1) on average and touches one or two cache lines.
+//
+// 2) Sorted view: all (value, index) pairs sorted by value.
+//    Binary search answers range queries such as "all products with
+//    stock < 10" in O(log n + matches).
+//
+// IndexedInventory wraps a plain Inventory plus the index and offers the
+// same functions (create, destroy, reserve, append, insert_at, delete_at,
+// find, sort_asc, reverse). Each one updates the hash index as it goes:
+//   - append:             O(1)
+//   - insert_at/delete_at: O(table size) to shift stored positions; the
+//                          array shift itself is already O(n), so the
+//                          operation's cost class does not change
+//   - sort_asc/reverse:    rebuilt in one O(n) pass over the new order
+// The sorted view is rebuilt lazily on the first range query after a change
+// (and costs only O(n) right after sort_asc, when the data is in order).
+//
+// The index is switched with set_index_enabled(led, on). For write-heavy
+// phases turn it off: the index is dropped and every write is just the
+// plain Inventory operation. Turning it back on rebuilds it once from the
+// data.
+//
+// The same wrapper can keep LIVE STATISTICS (inventory_live_stats.hpp):
+// with set_live_stats_enabled(led, true) every write also updates count,
+// sum, min/max heaps and a percentile histogram, and stats(led) /
+// percentile(led, ...) answer without reading the array. It is switched
+// independently of the index.
+//
+// Range queries (inventory_range.hpp) need no switch: the segment tree is
+// built by the first range_stats / find_below and then kept current by
+// append and set_at; other writes only mark it stale.
+
+#ifndef CENG241_INVENTORY_INDEX_HPP
+#define CENG241_INVENTORY_INDEX_HPP
+
+#include <algorithm> // std::sort, std::lower_bound, std::nth_element
+#include <vector>
+#include "inventory.hpp"
+#include "inventory_live_stats.hpp"
+#include "inventory_range.hpp"
+
+// One slot of the open-addressing table. pos == -1 means "empty".
+struct IndexSlot {
+    int key; // stock value
+    int pos; // first index in the ledger holding 'key'
+};
+
+struct ValuePos {
+    int value;
+    int index;
+};
+
+struct IndexedInventory {
+    Inventory inv;                 // the actual data (lab structure)
+    bool enabled;                  // index maintained?
+    std::vector<IndexSlot> slots;  // hash table, size is a power of two
+    int used;                      // occupied slots
+    std::vector<ValuePos> sorted;  // sorted view (valid when !sorted_dirty)
+    bool sorted_dirty;
+    bool live_enabled;             // live stats maintained?
+    LiveStats live;
+    RangeTree ranges;              // segment tree, built on demand
+};
+
+// --- Hash table helpers ----------------------------------------------------
+
+// Fibonacci hashing: multiply by 2^32 / golden ratio, then fold the well
+// mixed high bits down into the low bits that the mask keeps.
+inline unsigned index_hash(int key, unsigned mask) {
+    unsigned h = static_cast<unsigned>(key) * 2654435769u;
+    return (h ^ (h >> 16)) & mask;
+}
+
+// Returns the slot holding key, or the empty slot where it would go.
+inline unsigned index_probe(const IndexedInventory& led, int key) {
+    unsigned mask = static_cast<unsigned>(led.slots.size()) - 1;
+    unsigned i = index_hash(key, mask);
+    while (led.slots[i].pos != -1 && led.slots[i].key != key) i = (i + 1) & mask;
+    return i;
+}
+
+inline void index_reset(IndexedInventory& led, int expected_keys) {
+    unsigned cap = 16;
+    while (cap < static_cast<unsigned>(expected_keys) * 2) cap *= 2; // load factor <= 0.5
+    led.slots.assign(cap, IndexSlot{0, -1});
+    led.used = 0;
+}
+
+// Set key -> pos unless the key is already mapped to an earlier position.
+inline void index_put_min(IndexedInventory& led, int key, int pos) {
+    if (static_cast<size_t>(led.used + 1) * 2 > led.slots.size()) {
+        // Grow: re-insert everything into a table twice as large.
+        std::vector<IndexSlot> old;
+        old.swap(led.slots);
+        led.slots.assign(old.size() * 2, IndexSlot{0, -1});
+        for (const IndexSlot& s : old) {
+            if (s.pos != -1) led.slots[index_probe(led, s.key)] = s;
+        }
+    }
+    IndexSlot& s = led.slots[index_probe(led, key)];
+    if (s.pos == -1) {
+        s.key = key;
+        s.pos = pos;
+        ++led.used;
+    } else if (pos < s.pos) {
+        s.pos = pos;
+    }
+}
+
+// Remove key with backward-shift deletion (no tombstones needed for linear probing).
+inline void index_erase(IndexedInventory& led, int key) {
+    unsigned mask = static_cast<unsigned>(led.slots.size()) - 1;
+    unsigned hole = index_probe(led, key);
+    if (led.slots[hole].pos == -1) return;
+    led.slots[hole].pos = -1;
+    --led.used;
+    for (unsigned j = (hole + 1) & mask; led.slots[j].pos != -1; j = (j + 1) & mask) {
+        unsigned home = index_hash(led.slots[j].key, mask);
+        // Move slot j back into the hole if its home is not in (hole, j].
+        bool between = (hole <= j) ? (home > hole && home <= j) : (home > hole || home <= j);
+        if (!between) {
+            led.slots[hole] = led.slots[j];
+            led.slots[j].pos = -1;
+            hole = j;
+        }
+    }
+}
+
+// Rebuild the hash index from the data in one pass.
+inline void index_rebuild(IndexedInventory& led) {
+    index_reset(led, led.inv.size);
+    for (int i = 0; i < led.inv.size; ++i) index_put_min(led, led.inv.data[i], i);
+    led.sorted_dirty = true;
+}
+
+// Add delta to every stored position >= from (after an insert/delete shift).
+inline void index_shift_positions(IndexedInventory& led, int from, int delta) {
+    for (IndexSlot& s : led.slots) {
+        if (s.pos != -1 && s.pos >= from) s.pos += delta;
+    }
+}
+
+// --- Public API (mirrors inventory.hpp) ------------------------------------
+
+// The index setting survives create/destroy, so a ledger declared as
+// `IndexedInventory led{};` starts with the index OFF until enabled.
+inline bool create(IndexedInventory& led, int initial_capacity) {
+    led.sorted.clear();
+    led.sorted_dirty = true;
+    if (led.enabled) index_reset(led, 0);
+    if (led.live_enabled) live_stats_rebuild(led.live, nullptr, 0);
+    led.ranges.built = false;
+    return create(led.inv, initial_capacity);
+}
+
+inline void destroy(IndexedInventory& led) {
+    destroy(led.inv);
+    if (led.enabled) index_reset(led, 0);
+    if (led.live_enabled) live_stats_rebuild(led.live, nullptr, 0);
+    std::vector<RangeNode>().swap(led.ranges.nodes);
+    led.ranges.built = false;
+    led.sorted.clear();
+    led.sorted_dirty = true;
+}
+
+inline void set_index_enabled(IndexedInventory& led, bool on) {
+    if (on == led.enabled) return;
+    led.enabled = on;
+    if (on) {
+        index_rebuild(led);
+    } else {
+        std::vector<IndexSlot>().swap(led.slots); // free the memory
+        std::vector<ValuePos>().swap(led.sorted);
+        led.used = 0;
+        led.sorted_dirty = true;
+    }
+}
+
+inline void set_live_stats_enabled(IndexedInventory& led, bool on) {
+    if (on == led.live_enabled) return;
+    led.live_enabled = on;
+    if (on) live_stats_rebuild(led.live, led.inv.data, led.inv.size);
+    else live_stats_clear(led.live);
+}
+
+inline bool reserve(IndexedInventory& led, int new_capacity) {
+    int old_size = led.inv.size;
+    if (!reserve(led.inv, new_capacity)) return false;
+    led.ranges.built = false; // leaves are sized by capacity
+    if (led.inv.size != old_size) { // shrink dropped items
+        if (led.enabled) index_rebuild(led);
+        if (led.live_enabled) live_stats_rebuild(led.live, led.inv.data, led.inv.size);
+    }
+    return true;
+}
+
+inline bool append(IndexedInventory& led, int stock) {
+    if (!append(led.inv, stock)) return false;
+    if (led.live_enabled) live_stats_add(led.live, stock);
+    range_tree_set(led.ranges, led.inv.size - 1, stock);
+    if (led.enabled) {
+        index_put_min(led, stock, led.inv.size - 1);
+        led.sorted_dirty = true;
+    }
+    return true;
+}
+
+inline bool insert_at(IndexedInventory& led, int index, int stock) {
+    if (!insert_at(led.inv, index, stock)) return false;
+    if (led.live_enabled) live_stats_add(led.live, stock);
+    led.ranges.built = false; // every later product moved
+    if (led.enabled) {
+        index_shift_positions(led, index, +1);
+        index_put_min(led, stock, index);
+        led.sorted_dirty = true;
+    }
+    return true;
+}
+
+inline bool delete_at(IndexedInventory& led, int index) {
+    if (index < 0 || index >= led.inv.size) return delete_at(led.inv, index); // prints the error
+    int removed = led.inv.data[index];
+    if (!delete_at(led.inv, index)) return false;
+    if (led.live_enabled) live_stats_remove(led.live, removed, led.inv.data, led.inv.size);
+    if (index == led.inv.size) range_tree_clear(led.ranges, index); // the last one: nothing moved
+    else led.ranges.built = false;
+    if (led.enabled) {
+        unsigned s = index_probe(led, removed);
+        bool was_first = (led.slots[s].pos == index);
+        index_shift_positions(led, index + 1, -1);
+        if (was_first) {
+            // The next occurrence (if any) can only be at or after 'index'.
+            int next = -1;
+            for (int i = index; i < led.inv.size; ++i) {
+                if (led.inv.data[i] == removed) {
+                    next = i;
+                    break;
+                }
+            }
+            if (next >= 0) led.slots[index_probe(led, removed)].pos = next;
+            else index_erase(led, removed);
+        }
+        led.sorted_dirty = true;
+    }
+    return true;
+}
+
+// Point update: product 'index' now has 'stock' units. Nothing moves, so
+// every structure is updated in place (the range tree in O(log n)).
+inline bool set_at(IndexedInventory& led, int index, int stock) {
+    if (index < 0 || index >= led.inv.size) {
+        std::cout << "Index out of bounds.\n";
+        return false;
+    }
+    int old = led.inv.data[index];
+    led.inv.data[index] = stock;
+    if (led.live_enabled) {
+        live_stats_add(led.live, stock);
+        live_stats_remove(led.live, old, led.inv.data, led.inv.size);
+    }
+    range_tree_set(led.ranges, index, stock);
+    if (led.enabled && old != stock) {
+        unsigned s = index_probe(led, old);
+        if (led.slots[s].pos == index) {
+            // Same search as delete_at: the next 'old' can only come later.
+            int next = -1;
+            for (int i = index + 1; i < led.inv.size; ++i) {
+                if (led.inv.data[i] == old) {
+                    next = i;
+                    break;
+                }
+            }
+            if (next >= 0) led.slots[s].pos = next;
+            else index_erase(led, old);
+        }
+        index_put_min(led, stock, index);
+        led.sorted_dirty = true;
+    }
+    return true;
+}
+
+inline int find(const IndexedInventory& led, int target) {
+    if (!led.enabled) return find(led.inv, target);
+    const IndexSlot& s = led.slots[index_probe(led, target)];
+    return s.pos; // -1 when the slot is empty
+}
+
+// Refresh both views after the data was sorted (by sort_asc below or by
+// another sort such as parallel_sort_asc).
+inline void index_after_sort(IndexedInventory& led) {
+    led.ranges.built = false;
+    if (!led.enabled) return;
+    // Data is now in order, so both views come from one linear pass.
+    index_reset(led, led.used);
+    led.sorted.resize(led.inv.size);
+    for (int i = 0; i < led.inv.size; ++i) {
+        led.sorted[i] = ValuePos{led.inv.data[i], i};
+        if (i == 0 || led.inv.data[i] != led.inv.data[i - 1]) index_put_min(led, led.inv.data[i], i);
+    }
+    led.sorted_dirty = false;
+}
+
+inline void sort_asc(IndexedInventory& led) {
+    sort_asc(led.inv);
+    index_after_sort(led);
+}
+
+inline void reverse(IndexedInventory& led) {
+    reverse(led.inv);
+    led.ranges.built = false;
+    if (led.enabled) index_rebuild(led);
+}
+
+// O(1) with live stats on, one pass over the array otherwise.
+inline bool stats(const IndexedInventory& led, int& out_min, int& out_max, double& out_avg) {
+    if (led.live_enabled) return live_stats(led.live, out_min, out_max, out_avg);
+    return stats(led.inv, out_min, out_max, out_avg);
+}
+
+// Stock level below which a fraction q (0..1) of the products are (nearest
+// rank). With live stats on it comes from the histogram (within 3%);
+// otherwise it is exact, from a copy of the array (O(n)).
+inline bool percentile(const IndexedInventory& led, double q, int& out) {
+    if (led.live_enabled) return live_percentile(led.live, q, out);
+    if (led.inv.size == 0) return false;
+    double exact = q * led.inv.size;
+    int rank = static_cast<int>(exact);
+    if (rank < exact || rank == 0) ++rank;
+    if (rank > led.inv.size) rank = led.inv.size;
+    std::vector<int> copy(led.inv.data, led.inv.data + led.inv.size);
+    std::nth_element(copy.begin(), copy.begin() + (rank - 1), copy.end());
+    out = copy[rank - 1];
+    return true;
+}
+
+// --- Range queries on the sorted view --------------------------------------
+
+inline void ensure_sorted_view(IndexedInventory& led) {
+    if (!led.sorted_dirty) return;
+    led.sorted.resize(led.inv.size);
+    for (int i = 0; i < led.inv.size; ++i) led.sorted[i] = ValuePos{led.inv.data[i], i};
+    std::sort(led.sorted.begin(), led.sorted.end(), [](const ValuePos& a, const ValuePos& b) {
+        return a.value < b.value || (a.value == b.value && a.index < b.index);
+    });
+    led.sorted_dirty = false;
+}
+
+// Collect the indices of all products with lo <= stock < hi (sorted by stock).
+// Returns how many were found. Works (by scanning) even with the index off.
+inline int find_range(IndexedInventory& led, int lo, int hi, std::vector<int>& out_indices) {
+    out_indices.clear();
+    if (!led.enabled) {
+        for (int i = 0; i < led.inv.size; ++i) {
+            if (led.inv.data[i] >= lo && led.inv.data[i] < hi) out_indices.push_back(i);
+        }
+        return static_cast<int>(out_indices.size());
+    }
+    ensure_sorted_view(led);
+    auto first = std::lower_bound(led.sorted.begin(), led.sorted.end(), lo,
+                                  [](const ValuePos& p, int v) { return p.value < v; });
+    for (auto it = first; it != led.sorted.end() && it->value < hi; ++it) out_indices.push_back(it->index);
+    return static_cast<int>(out_indices.size());
+}
+
+// Count products with lo <= stock < hi in O(log n) (two binary searches).
+inline int count_range(IndexedInventory& led, int lo, int hi) {
+    if (!led.enabled) {
+        int count = 0;
+        for (int i = 0; i < led.inv.size; ++i) count += (led.inv.data[i] >= lo && led.inv.data[i] < hi);
+        return count;
+    }
+    ensure_sorted_view(led);
+    auto less_than = [](const ValuePos& p, int v) { return p.value < v; };
+    auto first = std::lower_bound(led.sorted.begin(), led.sorted.end(), lo, less_than);
+    auto last = std::lower_bound(first, led.sorted.end(), hi, less_than);
+    return static_cast<int>(last - first);
+}
+
+// --- Range queries by position (segment tree) ------------------------------
+
+// Sum, min and max of products [first, last); false if the range is empty
+// or out of bounds. O(log n) once the tree is built.
+inline bool range_stats(IndexedInventory& led, int first, int last, long long& out_sum, int& out_min,
+                        int& out_max) {
+    if (first < 0 || last > led.inv.size || first >= last) return false;
+    RangeNode r = range_query(led.ranges, led.inv, first, last);
+    out_sum = r.sum;
+    out_min = r.min;
+    out_max = r.max;
+    return true;
+}
+
+// Positions in [first, last) with stock < threshold, in order; returns how
+// many. O(log n) per product found.
+inline int find_below(IndexedInventory& led, int first, int last, int threshold, std::vector<int>& out_indices) {
+    out_indices.clear();
+    if (first < 0 || last > led.inv.size || first >= last) return 0;
+    return range_below(led.ranges, led.inv, first, last, threshold, out_indices);
+}
+
+#endif // CENG241_INVENTORY_INDEX_HPP
@@ -0,0 +1,239 @@
+// CENG241 - Vectorized kernels for stats, find and reverse
+// --------------------------------------------------------
+// The loops in the lab (`if (data[i] < mn) mn = data[i];`) handle ONE int
+// per step and contain branches the CPU has to predict. Modern x86 CPUs can
+// process 4 ints (SSE, 128-bit registers) or 8 ints (AVX2, 256-bit
+// registers) with a single instruction. This header provides three kernels
+// in three flavours each:
+//
+//   kernel          scalar fallback      SSE4.1              AVX2
+//   min/max/sum     branchless loop      4 lanes             8 lanes
+//   find first      plain loop           compare+movemask    compare+movemask
+//   reverse         swap loop            shuffle 4 lanes     permute 8 lanes
+//
+// Which flavour runs is decided ONCE at runtime by asking the CPU what it
+// supports (__builtin_cpu_supports), so the same binary works everywhere.
+// The AVX2/SSE functions are compiled with `__attribute__((target(...)))`,
+// which lets us use those instructions without compiling the whole program
+// with -mavx2.
+//
+// For testing, the environment variable INVENTORY_SIMD=scalar|sse4|avx2
+// forces a flavour (it is ignored if the CPU cannot run it).
+
+#ifndef CENG241_INVENTORY_KERNELS_HPP
+#define CENG241_INVENTORY_KERNELS_HPP
+
+#include <algorithm> // std::swap
+#include <cstdlib>   // std::getenv
+#include <cstring>   // std::strcmp
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define INVENTORY_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define INVENTORY_KERNELS_X86 0
+#endif
+
+// Result of one min/max/sum pass. All minmaxsum kernels need n > 0.
+struct MinMaxSum {
+    int       min;
+    int       max;
+    long long sum;
+};
+
+// --- Scalar fallback -------------------------------------------------------
+
+// Branchless: std::min/std::max compile to conditional moves, not jumps.
+inline MinMaxSum minmaxsum_scalar(const int* data, int n) {
+    MinMaxSum r{data[0], data[0], 0};
+    for (int i = 0; i < n; ++i) {
+        r.min = std::min(r.min, data[i]);
+        r.max = std::max(r.max, data[i]);
+        r.sum += data[i];
+    }
+    return r;
+}
+
+inline int find_scalar(const int* data, int n, int target) {
+    for (int i = 0; i < n; ++i) {
+        if (data[i] == target) return i;
+    }
+    return -1;
+}
+
+inline void reverse_scalar(int* data, int n) {
+    int i = 0, j = n - 1;
+    while (i < j) {
+        std::swap(data[i], data[j]);
+        ++i;
+        --j;
+    }
+}
+
+#if INVENTORY_KERNELS_X86
+
+// --- SSE4.1 (4 ints per register) ------------------------------------------
+
+__attribute__((target("sse4.1")))
+inline MinMaxSum minmaxsum_sse4(const int* data, int n) {
+    __m128i vmin = _mm_set1_epi32(data[0]);
+    __m128i vmax = vmin;
+    __m128i vsum = _mm_setzero_si128(); // two 64-bit partial sums
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        vmin = _mm_min_epi32(vmin, v);
+        vmax = _mm_max_epi32(vmax, v);
+        // Widen to 64-bit before adding so large ledgers cannot overflow.
+        vsum = _mm_add_epi64(vsum, _mm_cvtepi32_epi64(v));
+        vsum = _mm_add_epi64(vsum, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    alignas(16) int mins[4], maxs[4];
+    alignas(16) long long sums[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(mins), vmin);
+    _mm_store_si128(reinterpret_cast<__m128i*>(maxs), vmax);
+    _mm_store_si128(reinterpret_cast<__m128i*>(sums), vsum);
+    MinMaxSum r{mins[0], maxs[0], sums[0] + sums[1]};
+    for (int k = 1; k < 4; ++k) {
+        r.min = std::min(r.min, mins[k]);
+        r.max = std::max(r.max, maxs[k]);
+    }
+    for (; i < n; ++i) { // leftover tail (fewer than 4 ints)
+        r.min = std::min(r.min, data[i]);
+        r.max = std::max(r.max, data[i]);
+        r.sum += data[i];
+    }
+    return r;
+}
+
+__attribute__((target("sse4.1")))
+inline int find_sse4(const int* data, int n, int target) {
+    __m128i t = _mm_set1_epi32(target);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), t);
+        // One bit per lane: bit k is set if lane k matched.
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+    for (; i < n; ++i) {
+        if (data[i] == target) return i;
+    }
+    return -1;
+}
+
+__attribute__((target("sse4.1")))
+inline void reverse_sse4(int* data, int n) {
+    int i = 0, j = n - 4; // [i, i+4) swaps with [j, j+4)
+    for (; i + 4 <= j; i += 4, j -= 4) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + j));
+        // 0x1B = lanes 3,2,1,0: reverses the 4 ints inside a register.
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_shuffle_epi32(hi, 0x1B));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + j), _mm_shuffle_epi32(lo, 0x1B));
+    }
+    reverse_scalar(data + i, j + 4 - i); // middle part not covered by full blocks
+}
+
+// --- AVX2 (8 ints per register) --------------------------------------------
+
+__attribute__((target("avx2")))
+inline MinMaxSum minmaxsum_avx2(const int* data, int n) {
+    __m256i vmin = _mm256_set1_epi32(data[0]);
+    __m256i vmax = vmin;
+    __m256i vsum = _mm256_setzero_si256(); // four 64-bit partial sums
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        vmin = _mm256_min_epi32(vmin, v);
+        vmax = _mm256_max_epi32(vmax, v);
+        vsum = _mm256_add_epi64(vsum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        vsum = _mm256_add_epi64(vsum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    alignas(32) int mins[8], maxs[8];
+    alignas(32) long long sums[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(mins), vmin);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(sums), vsum);
+    MinMaxSum r{mins[0], maxs[0], sums[0] + sums[1] + sums[2] + sums[3]};
+    for (int k = 1; k < 8; ++k) {
+        r.min = std::min(r.min, mins[k]);
+        r.max = std::max(r.max, maxs[k]);
+    }
+    for (; i < n; ++i) {
+        r.min = std::min(r.min, data[i]);
+        r.max = std::max(r.max, data[i]);
+        r.sum += data[i];
+    }
+    return r;
+}
+
+__attribute__((target("avx2")))
+inline int find_avx2(const int* data, int n, int target) {
+    __m256i t = _mm256_set1_epi32(target);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), t);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+    for (; i < n; ++i) {
+        if (data[i] == target) return i;
+    }
+    return -1;
+}
+
+__attribute__((target("avx2")))
+inline void reverse_avx2(int* data, int n) {
+    const __m256i rev = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    int i = 0, j = n - 8;
+    for (; i + 8 <= j; i += 8, j -= 8) {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_permutevar8x32_epi32(hi, rev));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + j), _mm256_permutevar8x32_epi32(lo, rev));
+    }
+    reverse_scalar(data + i, j + 8 - i);
+}
+
+#endif // INVENTORY_KERNELS_X86
+
+// --- Runtime dispatch --------------------------------------------------
+
+// A table of function pointers, filled once with the best flavour.
+struct InventoryKernels {
+    const char* name;
+    MinMaxSum (*minmaxsum)(const int*, int);
+    int (*find)(const int*, int, int);
+    void (*reverse)(int*, int);
+};
+
+inline InventoryKernels select_inventory_kernels() {
+    InventoryKernels scalar{"scalar", minmaxsum_scalar, find_scalar, reverse_scalar};
+#if INVENTORY_KERNELS_X86
+    InventoryKernels sse4{"sse4", minmaxsum_sse4, find_sse4, reverse_sse4};
+    InventoryKernels avx2{"avx2", minmaxsum_avx2, find_avx2, reverse_avx2};
+    __builtin_cpu_init();
+    bool has_sse4 = __builtin_cpu_supports("sse4.1");
+    bool has_avx2 = __builtin_cpu_supports("avx2");
+
+    const char* forced = std::getenv("INVENTORY_SIMD");
+    if (forced) {
+        if (std::strcmp(forced, "scalar") == 0) return scalar;
+        if (std::strcmp(forced, "sse4") == 0 && has_sse4) return sse4;
+        if (std::strcmp(forced, "avx2") == 0 && has_avx2) return avx2;
+    }
+    if (has_avx2) return avx2;
+    if (has_sse4) return sse4;
+#endif
+    return scalar;
+}
+
+// The selection runs on first use only (a function-local static is
+// initialized exactly once, even with threads).
+inline const InventoryKernels& inventory_kernels() {
+    static const InventoryKernels k = select_inventory_kernels();
+    return k;
+}
+
+#endif // CENG241_INVENTORY_KERNELS_HPP
@@ -0,0 +1,172 @@
+// CENG241 - Live statistics: min / max / average / percentiles without a rescan
+// -----------------------------------------------------------------------------
+// stats() in inventory.hpp reads the whole array on every call. That is one
+// fast pass, but a dashboard that asks for the numbers after every few writes
+// pays O(n) per question. LiveStats keeps the answers up to date instead;
+// every append / insert_at / delete_at reports the value that came or went:
+//
+//   count, sum   two counters: O(1) per change, O(1) per query
+//   min, max     two binary heaps of the stored values (smallest / largest
+//                on top). A removed value cannot be found inside a heap
+//                cheaply, so it goes into a second "removed" heap; whenever
+//                both tops are equal the top was removed and is popped from
+//                both. Removing the current minimum therefore costs
+//                O(log n), not a rescan. Removed values that are not on top
+//                wait; when they outnumber the live ones the heaps are
+//                rebuilt from the data (O(n), so O(1) per removal on average).
+//   percentiles  a log-linear histogram (the bucket layout of the latency
+//                histograms in inventory_metrics.hpp): every value below 32
+//                has its own bucket, above that each power of two is split
+//                into 16 buckets. Adding or removing a value is one counter;
+//                a percentile walks the ~2000 buckets. The answer is the
+//                middle of the bucket, so it is off by at most 1/32 of the
+//                value (3%), clamped to [min, max].
+//
+// Positions are not tracked, so sort_asc and reverse cost nothing here.
+// The functions below only see values; IndexedInventory (inventory_index.hpp)
+// calls them from its operations when live stats are switched on.
+
+#ifndef CENG241_INVENTORY_LIVE_STATS_HPP
+#define CENG241_INVENTORY_LIVE_STATS_HPP
+
+#include <algorithm>  // std::push_heap, std::pop_heap, std::make_heap
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::greater
+#include <vector>
+#include "inventory_metrics.hpp" // histogram_bucket, histogram_bucket_floor
+
+struct LiveStats {
+    long long count;
+    long long sum;
+    std::vector<int> low, low_removed;   // min-heaps (std::greater)
+    std::vector<int> high, high_removed; // max-heaps
+    std::vector<long long> negative;     // histogram of -v for v < 0
+    std::vector<long long> positive;     // histogram of v for v >= 0
+};
+
+inline std::uint64_t live_magnitude(int v) {
+    return v < 0 ? static_cast<std::uint64_t>(-static_cast<long long>(v)) : static_cast<std::uint64_t>(v);
+}
+
+inline long long& live_bucket(LiveStats& ls, int v) {
+    return (v < 0 ? ls.negative : ls.positive)[histogram_bucket(live_magnitude(v))];
+}
+
+// Pop values that were removed while they sat in the middle of a heap.
+template <typename Less>
+void live_heap_settle(std::vector<int>& heap, std::vector<int>& removed, Less less) {
+    while (!removed.empty() && heap.front() == removed.front()) {
+        std::pop_heap(heap.begin(), heap.end(), less);
+        heap.pop_back();
+        std::pop_heap(removed.begin(), removed.end(), less);
+        removed.pop_back();
+    }
+}
+
+// Start over from the values data[0..n).
+inline void live_stats_rebuild(LiveStats& ls, const int* data, int n) {
+    ls.count = n;
+    ls.sum = 0;
+    ls.negative.assign(HIST_BUCKETS, 0);
+    ls.positive.assign(HIST_BUCKETS, 0);
+    ls.low.assign(data, data + n);
+    ls.high.assign(data, data + n);
+    ls.low_removed.clear();
+    ls.high_removed.clear();
+    for (int i = 0; i < n; ++i) {
+        ls.sum += data[i];
+        ++live_bucket(ls, data[i]);
+    }
+    std::make_heap(ls.low.begin(), ls.low.end(), std::greater<int>());
+    std::make_heap(ls.high.begin(), ls.high.end());
+}
+
+// Free the memory (live stats switched off).
+inline void live_stats_clear(LiveStats& ls) {
+    ls.count = 0;
+    ls.sum = 0;
+    std::vector<int>().swap(ls.low);
+    std::vector<int>().swap(ls.low_removed);
+    std::vector<int>().swap(ls.high);
+    std::vector<int>().swap(ls.high_removed);
+    std::vector<long long>().swap(ls.negative);
+    std::vector<long long>().swap(ls.positive);
+}
+
+inline void live_stats_add(LiveStats& ls, int v) {
+    ++ls.count;
+    ls.sum += v;
+    ++live_bucket(ls, v);
+    ls.low.push_back(v);
+    std::push_heap(ls.low.begin(), ls.low.end(), std::greater<int>());
+    ls.high.push_back(v);
+    std::push_heap(ls.high.begin(), ls.high.end());
+}
+
+// v must be one of the stored values. data[0..n) is the ledger AFTER the
+// removal; it is only read when the heaps are rebuilt.
+inline void live_stats_remove(LiveStats& ls, int v, const int* data, int n) {
+    --ls.count;
+    ls.sum -= v;
+    --live_bucket(ls, v);
+    if (ls.low_removed.size() + ls.high_removed.size() > static_cast<std::size_t>(ls.count) + 128) {
+        live_stats_rebuild(ls, data, n); // too many waiting removals
+        return;
+    }
+    ls.low_removed.push_back(v);
+    std::push_heap(ls.low_removed.begin(), ls.low_removed.end(), std::greater<int>());
+    live_heap_settle(ls.low, ls.low_removed, std::greater<int>());
+    ls.high_removed.push_back(v);
+    std::push_heap(ls.high_removed.begin(), ls.high_removed.end());
+    live_heap_settle(ls.high, ls.high_removed, std::less<int>());
+}
+
+// Same results as stats() in inventory.hpp, in O(1).
+inline bool live_stats(const LiveStats& ls, int& out_min, int& out_max, double& out_avg) {
+    if (ls.count == 0) return false;
+    out_min = ls.low.front();
+    out_max = ls.high.front();
+    out_avg = static_cast<double>(ls.sum) / ls.count;
+    return true;
+}
+
+// Middle of histogram bucket b (for magnitudes).
+inline long long live_bucket_middle(int b) {
+    std::uint64_t lo = histogram_bucket_floor(b);
+    std::uint64_t hi = histogram_bucket_floor(b + 1) - 1;
+    return static_cast<long long>(lo + (hi - lo) / 2);
+}
+
+// Approximate stock level below which a fraction q (0..1) of the products
+// are (nearest rank, like histogram_percentile); false if empty.
+inline bool live_percentile(const LiveStats& ls, double q, int& out) {
+    if (ls.count == 0) return false;
+    double exact = q * static_cast<double>(ls.count);
+    long long rank = static_cast<long long>(exact);
+    if (static_cast<double>(rank) < exact || rank == 0) ++rank;
+    if (rank > ls.count) rank = ls.count;
+    long long seen = 0, value = 0;
+    bool found = false;
+    // Negative values first, largest magnitude (= smallest value) first.
+    for (int b = HIST_BUCKETS - 1; b > 0 && !found; --b) {
+        seen += ls.negative[b];
+        if (seen >= rank) {
+            value = -live_bucket_middle(b);
+            found = true;
+        }
+    }
+    for (int b = 0; b < HIST_BUCKETS && !found; ++b) {
+        seen += ls.positive[b];
+        if (seen >= rank) {
+            value = live_bucket_middle(b);
+            found = true;
+        }
+    }
+    if (value < ls.low.front()) value = ls.low.front();
+    if (value > ls.high.front()) value = ls.high.front();
+    out = static_cast<int>(value);
+    return true;
+}
+
+#endif // CENG241_INVENTORY_LIVE_STATS_HPP
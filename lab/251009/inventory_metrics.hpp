@@ -0,0 +1,411 @@
+// CENG241 - Instrumentation for the Inventory hot paths
+// -----------------------------------------------------
+// How long does append take? How often did reserve copy the whole array?
+// With INVENTORY_METRICS defined to 1 (g++ -DINVENTORY_METRICS=1, or
+// cmake -DCENG241_INVENTORY_METRICS=ON) the lab functions record:
+//
+//   - per operation (append, insert_at, delete_at, find, sort_asc):
+//     a call counter and a latency histogram
+//   - reallocations done by reserve, bytes they allocated and copied,
+//     bytes moved by insert_at / delete_at shifting, and the peak capacity
+//
+// Without it every hook below is an empty macro: the compiler sees no
+// clock reads and no counters, so release builds pay nothing.
+//
+// Histograms are "HDR-style" (log-linear): each power of two is split into
+// 16 equal buckets, so any latency from 1 ns to minutes is stored with
+// about 6% precision in a fixed array of counters. No allocation, no locks.
+//
+// Dumping: dump_inventory_metrics(fd, format) writes Prometheus text or
+// JSON. It uses only write(2) and atomic loads, so it is also safe inside a
+// signal handler: after install_metrics_signal(SIGUSR1) you can run
+//   kill -USR1 <pid>
+// and the current numbers appear on stderr while the program keeps running.
+// Programs that call dump_inventory_metrics_if_requested() at exit print
+// them when INVENTORY_METRICS_DUMP=prom or =json is set.
+//
+// The counters assume one writer thread at a time (like the lab functions
+// themselves): they use plain load+store instead of locked read-modify-write
+// instructions, which keeps the enabled build fast too.
+
+#ifndef CENG241_INVENTORY_METRICS_HPP
+#define CENG241_INVENTORY_METRICS_HPP
+
+#ifndef INVENTORY_METRICS
+#define INVENTORY_METRICS 0
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib> // std::getenv
+#include <cstring>
+#include <unistd.h> // write
+
+enum MetricOp {
+    METRIC_APPEND,
+    METRIC_INSERT_AT,
+    METRIC_DELETE_AT,
+    METRIC_FIND,
+    METRIC_SORT_ASC,
+    METRIC_OP_COUNT
+};
+
+const char* const METRIC_OP_NAMES[METRIC_OP_COUNT] = {"append", "insert_at", "delete_at", "find", "sort_asc"};
+
+enum MetricsFormat { METRICS_PROMETHEUS, METRICS_JSON };
+
+// --- Log-linear histogram ------------------------------------------------
+
+const int HIST_SUB_BITS = 4;
+const int HIST_SUB_BUCKETS = 1 << HIST_SUB_BITS;               // 16 per power of two
+const int HIST_BUCKETS = (64 - HIST_SUB_BITS + 1) * HIST_SUB_BUCKETS; // covers all uint64 values
+
+// Values below 16 get their own bucket; above that, the bucket is chosen by
+// the position of the highest set bit plus the next 4 bits.
+inline int histogram_bucket(std::uint64_t v) {
+    if (v < static_cast<std::uint64_t>(HIST_SUB_BUCKETS)) return static_cast<int>(v);
+    int msb = 63 - __builtin_clzll(v);
+    int shift = msb - HIST_SUB_BITS;
+    return (shift + 1) * HIST_SUB_BUCKETS + static_cast<int>((v >> shift) - HIST_SUB_BUCKETS);
+}
+
+// Smallest value that falls into bucket b.
+inline std::uint64_t histogram_bucket_floor(int b) {
+    if (b < HIST_SUB_BUCKETS) return static_cast<std::uint64_t>(b);
+    int shift = b / HIST_SUB_BUCKETS - 1;
+    return static_cast<std::uint64_t>(HIST_SUB_BUCKETS + b % HIST_SUB_BUCKETS) << shift;
+}
+
+// Single-writer increment: no lock prefix, still readable from other threads.
+inline void metric_add(std::atomic<std::uint64_t>& c, std::uint64_t v) {
+    c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+inline void metric_max(std::atomic<std::uint64_t>& c, std::uint64_t v) {
+    if (v > c.load(std::memory_order_relaxed)) c.store(v, std::memory_order_relaxed);
+}
+
+struct LatencyHistogram {
+    std::atomic<std::uint64_t> buckets[HIST_BUCKETS];
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> sum_ns;
+    std::atomic<std::uint64_t> max_ns;
+};
+
+inline void record_latency(LatencyHistogram& h, std::uint64_t ns) {
+    metric_add(h.buckets[histogram_bucket(ns)], 1);
+    metric_add(h.count, 1);
+    metric_add(h.sum_ns, ns);
+    metric_max(h.max_ns, ns);
+}
+
+// Latency below which a fraction q (0..1) of the calls finished. Reports
+// the top of the bucket (capped at the maximum seen), so it never understates.
+inline std::uint64_t histogram_percentile(const LatencyHistogram& h, double q) {
+    std::uint64_t count = h.count.load(std::memory_order_relaxed);
+    if (count == 0) return 0;
+    // Nearest rank: the ceil(q * count)-th smallest value (at least the 1st).
+    double exact = q * static_cast<double>(count);
+    std::uint64_t rank = static_cast<std::uint64_t>(exact);
+    if (static_cast<double>(rank) < exact || rank == 0) ++rank;
+    std::uint64_t max = h.max_ns.load(std::memory_order_relaxed);
+    std::uint64_t seen = 0;
+    for (int b = 0; b < HIST_BUCKETS - 1; ++b) {
+        seen += h.buckets[b].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            std::uint64_t top = histogram_bucket_floor(b + 1) - 1;
+            return top < max ? top : max;
+        }
+    }
+    return max;
+}
+
+struct InventoryMetrics {
+    LatencyHistogram           latency[METRIC_OP_COUNT];
+    std::atomic<std::uint64_t> reallocations;   // reserve calls that allocated a new array
+    std::atomic<std::uint64_t> bytes_allocated; // total size of those arrays
+    std::atomic<std::uint64_t> bytes_copied;    // old elements copied into them
+    std::atomic<std::uint64_t> bytes_shifted;   // moved by insert_at / delete_at
+    std::atomic<std::uint64_t> peak_capacity;   // largest capacity seen (elements)
+};
+
+// One process-wide instance. Static storage starts zeroed, so no
+// constructor runs and a signal handler can read it at any time.
+inline InventoryMetrics g_inventory_metrics;
+
+inline void reset_inventory_metrics() {
+    InventoryMetrics& m = g_inventory_metrics;
+    for (LatencyHistogram& h : m.latency) {
+        for (std::atomic<std::uint64_t>& b : h.buckets) b.store(0);
+        h.count.store(0);
+        h.sum_ns.store(0);
+        h.max_ns.store(0);
+    }
+    m.reallocations.store(0);
+    m.bytes_allocated.store(0);
+    m.bytes_copied.store(0);
+    m.bytes_shifted.store(0);
+    m.peak_capacity.store(0);
+}
+
+// --- Hooks used by inventory.hpp -------------------------------------------
+
+#if INVENTORY_METRICS
+
+// Times the enclosing scope and files it under 'op'.
+class MetricTimer {
+public:
+    explicit MetricTimer(MetricOp op) : op_(op), start_(std::chrono::steady_clock::now()) {}
+    ~MetricTimer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+        record_latency(g_inventory_metrics.latency[op_], static_cast<std::uint64_t>(ns));
+    }
+    MetricTimer(const MetricTimer&) = delete;
+    MetricTimer& operator=(const MetricTimer&) = delete;
+
+private:
+    MetricOp op_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+inline void record_capacity(int capacity) {
+    metric_max(g_inventory_metrics.peak_capacity, static_cast<std::uint64_t>(capacity));
+}
+
+inline void record_realloc(int new_capacity, int copied_elements) {
+    InventoryMetrics& m = g_inventory_metrics;
+    metric_add(m.reallocations, 1);
+    metric_add(m.bytes_allocated, static_cast<std::uint64_t>(new_capacity) * sizeof(int));
+    metric_add(m.bytes_copied, static_cast<std::uint64_t>(copied_elements) * sizeof(int));
+    record_capacity(new_capacity);
+}
+
+#define INVENTORY_TIME_OP(op) MetricTimer inventory_metric_timer_(op)
+#define INVENTORY_COUNT_CAPACITY(capacity) record_capacity(capacity)
+#define INVENTORY_COUNT_REALLOC(new_capacity, copied_elements) record_realloc(new_capacity, copied_elements)
+#define INVENTORY_COUNT_SHIFT(elements) \
+    metric_add(g_inventory_metrics.bytes_shifted, static_cast<std::uint64_t>(elements) * sizeof(int))
+
+#else
+
+#define INVENTORY_TIME_OP(op) ((void)0)
+#define INVENTORY_COUNT_CAPACITY(capacity) ((void)0)
+#define INVENTORY_COUNT_REALLOC(new_capacity, copied_elements) ((void)0)
+#define INVENTORY_COUNT_SHIFT(elements) ((void)0)
+
+#endif // INVENTORY_METRICS
+
+// --- Dumping -----------------------------------------------------------------
+// A tiny formatter on a stack buffer: no iostream, no malloc, no locale,
+// which is what makes it usable from a signal handler.
+
+struct MetricsWriter {
+    int  fd;
+    int  used;
+    bool ok;
+    char buf[2048];
+};
+
+inline void metrics_flush(MetricsWriter& w) {
+    int done = 0;
+    while (done < w.used) {
+        ssize_t n = ::write(w.fd, w.buf + done, static_cast<size_t>(w.used - done));
+        if (n <= 0) {
+            w.ok = false;
+            break;
+        }
+        done += static_cast<int>(n);
+    }
+    w.used = 0;
+}
+
+inline void metrics_put(MetricsWriter& w, const char* s) {
+    for (; *s; ++s) {
+        if (w.used == static_cast<int>(sizeof w.buf)) metrics_flush(w);
+        w.buf[w.used++] = *s;
+    }
+}
+
+inline void metrics_put(MetricsWriter& w, std::uint64_t v) {
+    char digits[21];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v);
+    char text[21];
+    for (int k = 0; k < n; ++k) text[k] = digits[n - 1 - k];
+    text[n] = '\0';
+    metrics_put(w, text);
+}
+
+// One value; 'type' is the Prometheus type ("counter" or "gauge").
+inline void metrics_scalar(MetricsWriter& w, MetricsFormat f, const char* type, const char* name, const char* help,
+                           const std::atomic<std::uint64_t>& c, bool last) {
+    std::uint64_t v = c.load(std::memory_order_relaxed);
+    if (f == METRICS_PROMETHEUS) {
+        metrics_put(w, "# HELP inventory_");
+        metrics_put(w, name);
+        metrics_put(w, " ");
+        metrics_put(w, help);
+        metrics_put(w, "\n# TYPE inventory_");
+        metrics_put(w, name);
+        metrics_put(w, " ");
+        metrics_put(w, type);
+        metrics_put(w, "\ninventory_");
+        metrics_put(w, name);
+        metrics_put(w, " ");
+        metrics_put(w, v);
+        metrics_put(w, "\n");
+    } else {
+        metrics_put(w, "  \"");
+        metrics_put(w, name);
+        metrics_put(w, "\": ");
+        metrics_put(w, v);
+        metrics_put(w, last ? "\n" : ",\n");
+    }
+}
+
+// Only ever grows (totals since start).
+inline void metrics_counter(MetricsWriter& w, MetricsFormat f, const char* name, const char* help,
+                            const std::atomic<std::uint64_t>& c, bool last = false) {
+    metrics_scalar(w, f, "counter", name, help, c, last);
+}
+
+// A level that is not a running total, e.g. a high-water mark.
+inline void metrics_gauge(MetricsWriter& w, MetricsFormat f, const char* name, const char* help,
+                          const std::atomic<std::uint64_t>& c, bool last = false) {
+    metrics_scalar(w, f, "gauge", name, help, c, last);
+}
+
+// Prometheus histogram with power-of-two bucket bounds in nanoseconds
+// (integers keep the formatter simple); empty tails are left out.
+inline void metrics_prometheus_histograms(MetricsWriter& w) {
+    const InventoryMetrics& m = g_inventory_metrics;
+    metrics_put(w, "# HELP inventory_op_latency_ns Latency of Inventory operations in nanoseconds.\n");
+    metrics_put(w, "# TYPE inventory_op_latency_ns histogram\n");
+    for (int op = 0; op < METRIC_OP_COUNT; ++op) {
+        const LatencyHistogram& h = m.latency[op];
+        std::uint64_t count = h.count.load(std::memory_order_relaxed);
+        std::uint64_t cumulative = 0;
+        int b = 0;
+        for (int power = HIST_SUB_BITS; power < 64 && cumulative < count; ++power) {
+            std::uint64_t bound = std::uint64_t(1) << power;
+            for (; b < HIST_BUCKETS && histogram_bucket_floor(b) < bound; ++b) {
+                cumulative += h.buckets[b].load(std::memory_order_relaxed);
+            }
+            metrics_put(w, "inventory_op_latency_ns_bucket{op=\"");
+            metrics_put(w, METRIC_OP_NAMES[op]);
+            metrics_put(w, "\",le=\"");
+            metrics_put(w, bound - 1);
+            metrics_put(w, "\"} ");
+            metrics_put(w, cumulative);
+            metrics_put(w, "\n");
+        }
+        metrics_put(w, "inventory_op_latency_ns_bucket{op=\"");
+        metrics_put(w, METRIC_OP_NAMES[op]);
+        metrics_put(w, "\",le=\"+Inf\"} ");
+        metrics_put(w, count);
+        metrics_put(w, "\ninventory_op_latency_ns_sum{op=\"");
+        metrics_put(w, METRIC_OP_NAMES[op]);
+        metrics_put(w, "\"} ");
+        metrics_put(w, h.sum_ns.load(std::memory_order_relaxed));
+        metrics_put(w, "\ninventory_op_latency_ns_count{op=\"");
+        metrics_put(w, METRIC_OP_NAMES[op]);
+        metrics_put(w, "\"} ");
+        metrics_put(w, count);
+        metrics_put(w, "\n");
+    }
+}
+
+// JSON: count, total and selected percentiles per operation.
+inline void metrics_json_histograms(MetricsWriter& w) {
+    const InventoryMetrics& m = g_inventory_metrics;
+    metrics_put(w, "  \"ops\": {\n");
+    for (int op = 0; op < METRIC_OP_COUNT; ++op) {
+        const LatencyHistogram& h = m.latency[op];
+        metrics_put(w, "    \"");
+        metrics_put(w, METRIC_OP_NAMES[op]);
+        metrics_put(w, "\": {\"count\": ");
+        metrics_put(w, h.count.load(std::memory_order_relaxed));
+        metrics_put(w, ", \"sum_ns\": ");
+        metrics_put(w, h.sum_ns.load(std::memory_order_relaxed));
+        metrics_put(w, ", \"p50_ns\": ");
+        metrics_put(w, histogram_percentile(h, 0.50));
+        metrics_put(w, ", \"p90_ns\": ");
+        metrics_put(w, histogram_percentile(h, 0.90));
+        metrics_put(w, ", \"p99_ns\": ");
+        metrics_put(w, histogram_percentile(h, 0.99));
+        metrics_put(w, ", \"p999_ns\": ");
+        metrics_put(w, histogram_percentile(h, 0.999));
+        metrics_put(w, ", \"max_ns\": ");
+        metrics_put(w, h.max_ns.load(std::memory_order_relaxed));
+        metrics_put(w, op + 1 < METRIC_OP_COUNT ? "},\n" : "}\n");
+    }
+    metrics_put(w, "  },\n");
+}
+
+// Write all metrics to 'fd'. Async-signal-safe. Returns false on a write
+// error; with INVENTORY_METRICS off it writes a note instead.
+inline bool dump_inventory_metrics(int fd, MetricsFormat f) {
+    MetricsWriter w;
+    w.fd = fd;
+    w.used = 0;
+    w.ok = true;
+#if INVENTORY_METRICS
+    const InventoryMetrics& m = g_inventory_metrics;
+    if (f == METRICS_PROMETHEUS) {
+        metrics_prometheus_histograms(w);
+    } else {
+        metrics_put(w, "{\n");
+        metrics_json_histograms(w);
+    }
+    metrics_counter(w, f, "reallocations_total", "Arrays allocated by reserve.", m.reallocations);
+    metrics_counter(w, f, "bytes_allocated_total", "Bytes of those arrays.", m.bytes_allocated);
+    metrics_counter(w, f, "bytes_copied_total", "Bytes copied into them.", m.bytes_copied);
+    metrics_counter(w, f, "bytes_shifted_total", "Bytes moved by insert_at and delete_at.", m.bytes_shifted);
+    metrics_gauge(w, f, "peak_capacity", "Largest capacity reached (elements).", m.peak_capacity, true);
+    if (f == METRICS_JSON) metrics_put(w, "}\n");
+#else
+    metrics_put(w, f == METRICS_JSON ? "{\"metrics\": \"disabled\"}\n"
+                                     : "# inventory metrics disabled (build with INVENTORY_METRICS=1)\n");
+#endif
+    metrics_flush(w);
+    return w.ok;
+}
+
+inline std::atomic<int> g_metrics_signal_format{METRICS_PROMETHEUS};
+
+inline void metrics_signal_handler(int) {
+    int saved = errno; // write() may change errno under the interrupted code
+    dump_inventory_metrics(STDERR_FILENO, static_cast<MetricsFormat>(g_metrics_signal_format.load()));
+    errno = saved;
+}
+
+// Dump to stderr whenever 'sig' arrives. Does nothing when metrics are off.
+inline void install_metrics_signal(int sig = SIGUSR1, MetricsFormat f = METRICS_PROMETHEUS) {
+#if INVENTORY_METRICS
+    g_metrics_signal_format.store(f);
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof sa);
+    sa.sa_handler = metrics_signal_handler;
+    sa.sa_flags = SA_RESTART; // don't make reads in the menu fail with EINTR
+    sigaction(sig, &sa, nullptr);
+#else
+    (void)sig;
+    (void)f;
+#endif
+}
+
+// Dump to stderr if INVENTORY_METRICS_DUMP is "prom" or "json".
+inline void dump_inventory_metrics_if_requested() {
+    const char* format = std::getenv("INVENTORY_METRICS_DUMP");
+    if (!format) return;
+    if (std::strcmp(format, "json") == 0) dump_inventory_metrics(STDERR_FILENO, METRICS_JSON);
+    else if (std::strcmp(format, "prom") == 0) dump_inventory_metrics(STDERR_FILENO, METRICS_PROMETHEUS);
+}
+
+#endif // CENG241_INVENTORY_METRICS_HPP
@@ -0,0 +1,266 @@
+// CENG241 - Parallel sort_asc and stats for large ledgers
+// -------------------------------------------------------
+// sort_asc (std::sort) and stats (one pass) in inventory.hpp use a single
+// CPU core. For ledgers with tens of millions of products we can split the
+// work across all cores:
+//
+// 1) ThreadPool: a fixed set of worker threads. Work is handed out as
+//    numbered tasks. Every thread (including the caller, which helps while
+//    it waits) has its own task queue; a thread that runs out of tasks
+//    STEALS from the front of another thread's queue. This "work stealing"
+//    keeps all cores busy even when some tasks take longer than others.
+//
+// 2) parallel_sort_asc: an LSD radix sort. Instead of comparing elements it
+//    distributes them by one byte at a time (4 passes for 32-bit ints):
+//      - every thread counts the bytes in its own block (histogram),
+//      - prefix sums turn the counts into write positions,
+//      - every thread copies its block to those positions.
+//    Blocks are processed in order, so equal values keep their order
+//    (the sort is *stable*) and the whole sort is O(n), not O(n log n).
+//
+// 3) parallel_stats: each thread runs the vectorized min/max/sum kernel on
+//    its block; the partial results are combined at the end.
+//
+// Below PARALLEL_MIN_ELEMENTS elements (or with a 1-thread pool) both
+// functions simply call the single-threaded sort_asc / stats, because
+// starting threads costs more than it saves on small arrays.
+
+#ifndef CENG241_INVENTORY_PARALLEL_HPP
+#define CENG241_INVENTORY_PARALLEL_HPP
+
+#include <algorithm> // std::fill
+#include <atomic>
+#include <condition_variable>
+#include <cstring>   // std::memcpy
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>       // std::nothrow
+#include <thread>
+#include <vector>
+#include "inventory.hpp"
+
+const int PARALLEL_MIN_ELEMENTS = 1 << 16; // below this, stay single-threaded
+
+class ThreadPool {
+public:
+    // 'threads' is the total parallelism: threads-1 workers plus the caller.
+    // 0 means "one per hardware thread".
+    explicit ThreadPool(int threads = 0) {
+        if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (threads <= 0) threads = 1;
+        size_ = threads;
+        queues_.reset(new WorkQueue[size_]);
+        for (int w = 1; w < size_; ++w) workers_.emplace_back([this, w] { worker_loop(w); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stop_ = true;
+        }
+        wake_cv_.notify_all();
+        for (std::thread& t : workers_) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return size_; }
+
+    // Run fn(0), fn(1), ..., fn(tasks-1) on the pool and wait until all are done.
+    void run(int tasks, const std::function<void(int)>& fn) {
+        if (tasks <= 0) return;
+        if (size_ == 1) {
+            for (int t = 0; t < tasks; ++t) fn(t);
+            return;
+        }
+        job_ = &fn;
+        remaining_.store(tasks);
+        // Deal the tasks round-robin into the queues.
+        for (int t = 0; t < tasks; ++t) {
+            WorkQueue& q = queues_[t % size_];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(t);
+        }
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            ++generation_;
+        }
+        wake_cv_.notify_all();
+
+        drain(0); // the caller works too instead of just waiting
+        std::unique_lock<std::mutex> lock(done_mutex_);
+        done_cv_.wait(lock, [this] { return remaining_.load() == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex      mutex;
+        std::deque<int> tasks;
+    };
+
+    int size_ = 1;
+    std::unique_ptr<WorkQueue[]> queues_;
+    std::vector<std::thread> workers_;
+    const std::function<void(int)>* job_ = nullptr;
+    std::atomic<int> remaining_{0};
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    unsigned long long generation_ = 0;
+    bool stop_ = false;
+
+    std::mutex done_mutex_;
+    std::condition_variable done_cv_;
+
+    // Own queue: take from the back (most recently dealt, still in cache).
+    bool pop_own(int w, int& task) {
+        WorkQueue& q = queues_[w];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return false;
+        task = q.tasks.back();
+        q.tasks.pop_back();
+        return true;
+    }
+
+    // Someone else's queue: take from the front (opposite end to the owner).
+    bool steal(int w, int& task) {
+        for (int k = 1; k < size_; ++k) {
+            WorkQueue& q = queues_[(w + k) % size_];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = q.tasks.front();
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Run tasks until no queue has any left.
+    void drain(int w) {
+        int task;
+        while (pop_own(w, task) || steal(w, task)) {
+            (*job_)(task);
+            if (remaining_.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(done_mutex_);
+                done_cv_.notify_all();
+            }
+        }
+    }
+
+    void worker_loop(int w) {
+        unsigned long long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+            drain(w);
+        }
+    }
+};
+
+// Split [0, n) into 'parts' nearly equal blocks; block t is [begin, end).
+inline void block_range(int n, int parts, int t, int& begin, int& end) {
+    long long b = static_cast<long long>(n) * t / parts;
+    long long e = static_cast<long long>(n) * (t + 1) / parts;
+    begin = static_cast<int>(b);
+    end = static_cast<int>(e);
+}
+
+// Stable parallel LSD radix sort, 8 bits per pass.
+inline bool parallel_sort_asc(Inventory& inv, ThreadPool& pool) {
+    int n = inv.size;
+    if (n < PARALLEL_MIN_ELEMENTS || pool.size() == 1) {
+        sort_asc(inv);
+        return true;
+    }
+    int* buffer = new (std::nothrow) int[n];
+    if (!buffer) return false;
+
+    const int parts = pool.size() * 4; // a few tasks per thread helps stealing balance the load
+    const int RADIX = 256;
+    // hist[t * RADIX + digit]: how many elements of block t have this digit.
+    // It is recounted every pass because the blocks hold different elements
+    // after each scatter.
+    std::vector<int> hist(static_cast<size_t>(parts) * RADIX);
+
+    // Flipping the sign bit makes signed ints sort correctly as unsigned.
+    auto key = [](int v) { return static_cast<unsigned>(v) ^ 0x80000000u; };
+
+    int* src = inv.data;
+    int* dst = buffer;
+    for (int shift = 0; shift < 32; shift += 8) {
+        std::fill(hist.begin(), hist.end(), 0);
+        pool.run(parts, [&, shift](int t) {
+            int begin, end;
+            block_range(n, parts, t, begin, end);
+            int* h = &hist[static_cast<size_t>(t) * RADIX];
+            for (int i = begin; i < end; ++i) ++h[(key(src[i]) >> shift) & 0xFF];
+        });
+
+        // Prefix sums in (digit, block) order keep equal digits in block
+        // order; hist turns into the write position of each (block, digit).
+        int total = 0;
+        bool single_digit = false;
+        for (int d = 0; d < RADIX; ++d) {
+            int digit_count = 0;
+            for (int t = 0; t < parts; ++t) {
+                int& c = hist[static_cast<size_t>(t) * RADIX + d];
+                int count = c;
+                c = total + digit_count;
+                digit_count += count;
+            }
+            if (digit_count == n) single_digit = true;
+            total += digit_count;
+        }
+        if (single_digit) continue; // every element has the same byte here: nothing moves
+
+        pool.run(parts, [&, shift](int t) {
+            int begin, end;
+            block_range(n, parts, t, begin, end);
+            int* off = &hist[static_cast<size_t>(t) * RADIX];
+            for (int i = begin; i < end; ++i) {
+                int v = src[i];
+                dst[off[(key(v) >> shift) & 0xFF]++] = v;
+            }
+        });
+        std::swap(src, dst);
+    }
+    if (src != inv.data) std::memcpy(inv.data, src, static_cast<size_t>(n) * sizeof(int));
+    delete[] buffer;
+    return true;
+}
+
+// Parallel min/max/average; same contract as stats().
+inline bool parallel_stats(const Inventory& inv, ThreadPool& pool, int& out_min, int& out_max, double& out_avg) {
+    int n = inv.size;
+    if (n < PARALLEL_MIN_ELEMENTS || pool.size() == 1) return stats(inv, out_min, out_max, out_avg);
+
+    const int parts = pool.size();
+    std::vector<MinMaxSum> partial(parts);
+    pool.run(parts, [&](int t) {
+        int begin, end;
+        block_range(n, parts, t, begin, end);
+        partial[t] = inventory_kernels().minmaxsum(inv.data + begin, end - begin);
+    });
+
+    MinMaxSum r = partial[0];
+    for (int t = 1; t < parts; ++t) {
+        r.min = std::min(r.min, partial[t].min);
+        r.max = std::max(r.max, partial[t].max);
+        r.sum += partial[t].sum;
+    }
+    out_min = r.min;
+    out_max = r.max;
+    out_avg = static_cast<double>(r.sum) / n;
+    return true;
+}
+
+#endif // CENG241_INVENTORY_PARALLEL_HPP
@@ -0,0 +1,127 @@
+// CENG241 - Range queries: sum / min / max of stock between two positions
+// ------------------------------------------------------------------------
+// stats() answers for the whole ledger and find() scans from the start.
+// "What is the total stock of products 1200..1800?" or "which products in
+// this aisle have fewer than 5 units?" would each need a loop over the
+// range: O(j - i) per question.
+//
+// A SEGMENT TREE answers them in O(log n). It is a complete binary tree
+// stored in one array: leaf k holds product k, every inner node holds the
+// sum, min and max of the two nodes below it, so node 1 (the root) covers
+// the whole ledger:
+//
+//                  [0..8) sum 43, min 1, max 12
+//          [0..4) sum 20                [4..8) sum 23
+//      [0..2)       [2..4)          [4..6)       [6..8)
+//     5    7      1      7        12     3      6     2      <- leaves
+//
+// Any range [i, j) is covered by at most 2 log n nodes, so a query combines
+// those instead of the products themselves. A point update rewrites one
+// leaf and the log n nodes above it. "Under a threshold" walks down only
+// into nodes whose min is below it: O(log n) per product found.
+//
+// Laziness: insert_at / delete_at shift every later product, and sort_asc
+// / reverse move all of them, so the tree is simply marked stale
+// (built = false). It is rebuilt in one O(n) pass by the next query, never
+// earlier, so a burst of changes followed by one query pays one rebuild.
+// Appends and point updates keep a built tree current in O(log n). The
+// leaves are sized for the ledger's capacity, so appends fit until the
+// array itself grows.
+//
+// IndexedInventory (inventory_index.hpp) owns one RangeTree and keeps it in
+// step with its operations.
+
+#ifndef CENG241_INVENTORY_RANGE_HPP
+#define CENG241_INVENTORY_RANGE_HPP
+
+#include <climits> // INT_MAX, INT_MIN
+#include <vector>
+#include "inventory.hpp"
+
+struct RangeNode {
+    long long sum;
+    int min;
+    int max;
+};
+
+struct RangeTree {
+    std::vector<RangeNode> nodes; // nodes[1] is the root, leaves start at 'leaves'
+    int leaves;                   // a power of two >= the ledger's capacity
+    bool built;                   // false: rebuild before the next query
+};
+
+// What an empty leaf (past the end of the ledger) contributes.
+const RangeNode RANGE_EMPTY = {0, INT_MAX, INT_MIN};
+
+inline RangeNode range_combine(const RangeNode& a, const RangeNode& b) {
+    return RangeNode{a.sum + b.sum, a.min < b.min ? a.min : b.min, a.max > b.max ? a.max : b.max};
+}
+
+inline void range_tree_rebuild(RangeTree& t, const Inventory& inv) {
+    int leaves = 1;
+    while (leaves < inv.capacity) leaves *= 2;
+    t.leaves = leaves;
+    t.nodes.assign(2 * static_cast<size_t>(leaves), RANGE_EMPTY);
+    for (int i = 0; i < inv.size; ++i) t.nodes[leaves + i] = RangeNode{inv.data[i], inv.data[i], inv.data[i]};
+    for (int k = leaves - 1; k >= 1; --k) t.nodes[k] = range_combine(t.nodes[2 * k], t.nodes[2 * k + 1]);
+    t.built = true;
+}
+
+// Leaf 'index' becomes 'leaf', then the nodes above it are recomputed:
+// O(log n). Does nothing while the tree is stale.
+inline void range_tree_set_node(RangeTree& t, int index, const RangeNode& leaf) {
+    if (!t.built) return;
+    if (index >= t.leaves) { // appended past the leaves: the array grew
+        t.built = false;
+        return;
+    }
+    int k = t.leaves + index;
+    t.nodes[k] = leaf;
+    for (k /= 2; k >= 1; k /= 2) t.nodes[k] = range_combine(t.nodes[2 * k], t.nodes[2 * k + 1]);
+}
+
+inline void range_tree_set(RangeTree& t, int index, int stock) {
+    range_tree_set_node(t, index, RangeNode{stock, stock, stock});
+}
+
+inline void range_tree_clear(RangeTree& t, int index) {
+    range_tree_set_node(t, index, RANGE_EMPTY);
+}
+
+// Sum, min and max of products [first, last). The range must be valid and
+// non-empty (callers check against inv.size).
+inline RangeNode range_query(RangeTree& t, const Inventory& inv, int first, int last) {
+    if (!t.built) range_tree_rebuild(t, inv);
+    RangeNode left = RANGE_EMPTY, right = RANGE_EMPTY;
+    // Walk up from both ends; a node that sticks out of the range is
+    // skipped and its parent's sibling is taken instead.
+    for (int l = first + t.leaves, r = last + t.leaves; l < r; l /= 2, r /= 2) {
+        if (l & 1) left = range_combine(left, t.nodes[l++]);
+        if (r & 1) right = range_combine(t.nodes[--r], right);
+    }
+    return range_combine(left, right);
+}
+
+inline void range_collect_below(const RangeTree& t, int k, int lo, int hi, int first, int last, int threshold,
+                                std::vector<int>& out) {
+    if (hi <= first || last <= lo || t.nodes[k].min >= threshold) return;
+    if (k >= t.leaves) {
+        out.push_back(k - t.leaves);
+        return;
+    }
+    int mid = lo + (hi - lo) / 2;
+    range_collect_below(t, 2 * k, lo, mid, first, last, threshold, out);
+    range_collect_below(t, 2 * k + 1, mid, hi, first, last, threshold, out);
+}
+
+// Positions in [first, last) whose stock is below 'threshold', in order.
+// Returns how many were found.
+inline int range_below(RangeTree& t, const Inventory& inv, int first, int last, int threshold,
+                       std::vector<int>& out) {
+    out.clear();
+    if (!t.built) range_tree_rebuild(t, inv);
+    range_collect_below(t, 1, 0, t.leaves, first, last, threshold, out);
+    return static_cast<int>(out.size());
+}
+
+#endif // CENG241_INVENTORY_RANGE_HPP
@@ -0,0 +1,240 @@
+// CENG241 - Versioned Inventory: O(1) snapshots for reports during sales
+// ----------------------------------------------------------------------
+// stats() and print_inventory() scan the same array that append /
+// insert_at / delete_at change in place. If a reporting thread and a sales
+// thread share one Inventory, the only safe choice is a lock around every
+// operation, and then a full scan holds up every sale behind it.
+//
+// VersionedInventory keeps the ledger in copy-on-write chunks
+// (../cow_chunks.hpp), like the leaves of inventory_chunked.hpp:
+//
+//   directory:  chunks  [12 40 7] [99 18] [25 3 61 8] ...
+//               starts    0         3       5          (index of first element)
+//
+//   snapshot(v)   copies the pointer to the directory under the lock: O(1).
+//                 The reader then scans its InventorySnapshot WITHOUT any
+//                 lock; it is immutable and stays valid for as long as the
+//                 reader keeps it.
+//   writers       take the lock for one operation. The first write after a
+//                 snapshot copies the directory (n / 1024 pointers); a write
+//                 into a chunk that a snapshot shares copies that chunk
+//                 (4 KiB). Everything else happens in place.
+//
+// So a reader blocks a writer for one pointer copy, never for a scan, and
+// the cost of a snapshot is paid by the first writes after it, a few KiB at
+// a time. Old chunks are freed when the last snapshot using them is dropped.
+//
+// An edit shifts elements inside one chunk only; a full chunk is split in
+// two, an emptied chunk is removed. 'starts' is refreshed after the edited
+// chunk (O(n / 1024)); locating index i is a binary search in 'starts'.
+//
+// The free functions mirror inventory.hpp (create, append, insert_at,
+// delete_at) for writers; find / stats / print_inventory take a snapshot.
+
+#ifndef CENG241_INVENTORY_SNAPSHOT_HPP
+#define CENG241_INVENTORY_SNAPSHOT_HPP
+
+#include <iostream>
+#include <algorithm> // std::upper_bound
+#include <cstring>   // std::memmove, std::memcpy
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "inventory_kernels.hpp" // minmaxsum / find per chunk
+#include "../cow_chunks.hpp"
+#include "../out_buffer.hpp"
+
+struct SnapshotDirectory {
+    std::vector<CowChunkRef> chunks; // in logical order, none empty
+    std::vector<int>         starts; // starts[c] = index of chunks[c]'s first element
+    int size;
+    unsigned long long version;      // number of changes applied so far
+};
+
+// An immutable view of the ledger at one version.
+struct InventorySnapshot {
+    std::shared_ptr<const SnapshotDirectory> dir;
+};
+
+struct VersionedInventory {
+    mutable std::mutex lock;                // one write, or one snapshot() pointer copy
+    std::shared_ptr<SnapshotDirectory> dir;
+};
+
+inline void create(VersionedInventory& v) {
+    std::lock_guard<std::mutex> guard(v.lock);
+    v.dir = std::make_shared<SnapshotDirectory>();
+    v.dir->size = 0;
+    v.dir->version = 0;
+}
+
+// O(1): the current version, readable from any thread without a lock.
+inline InventorySnapshot snapshot(const VersionedInventory& v) {
+    std::lock_guard<std::mutex> guard(v.lock);
+    return InventorySnapshot{v.dir};
+}
+
+// --- Writer helpers (caller holds v.lock) -----------------------------------
+
+inline void refresh_starts(SnapshotDirectory& d, int from) {
+    int at = from > 0 ? d.starts[from - 1] + d.chunks[from - 1]->count : 0;
+    for (int c = from; c < static_cast<int>(d.chunks.size()); ++c) {
+        d.starts[c] = at;
+        at += d.chunks[c]->count;
+    }
+}
+
+// Chunk holding logical index 'index' (0 <= index < size), offset inside it.
+inline int locate_snapshot_chunk(const SnapshotDirectory& d, int index, int& offset) {
+    int c = static_cast<int>(std::upper_bound(d.starts.begin(), d.starts.end(), index) - d.starts.begin()) - 1;
+    offset = index - d.starts[c];
+    return c;
+}
+
+// Split full chunk c into two halves; the upper half becomes chunk c + 1.
+inline void split_snapshot_chunk(SnapshotDirectory& d, int c) {
+    CowChunk& full = cow_writable(d.chunks[c]);
+    CowChunkRef upper = std::make_shared<CowChunk>();
+    int keep = full.count / 2;
+    upper->count = full.count - keep;
+    std::memcpy(upper->items, full.items + keep, sizeof(int) * upper->count);
+    full.count = keep;
+    d.chunks.insert(d.chunks.begin() + c + 1, upper);
+    d.starts.insert(d.starts.begin() + c + 1, 0);
+}
+
+// Insert into the writable directory d (caller holds the lock, index valid).
+inline void insert_locked(SnapshotDirectory& d, int index, int stock) {
+    int c, offset;
+    if (d.chunks.empty()) {
+        d.chunks.push_back(std::make_shared<CowChunk>());
+        d.chunks[0]->count = 0;
+        d.starts.push_back(0);
+        c = offset = 0;
+    } else if (index == d.size) {
+        c = static_cast<int>(d.chunks.size()) - 1; // append to the last chunk
+        offset = d.chunks[c]->count;
+    } else {
+        c = locate_snapshot_chunk(d, index, offset);
+    }
+    if (d.chunks[c]->count == COW_CHUNK_INTS) {
+        split_snapshot_chunk(d, c);
+        if (offset > d.chunks[c]->count) {
+            offset -= d.chunks[c]->count;
+            ++c;
+        }
+    }
+    CowChunk& chunk = cow_writable(d.chunks[c]);
+    std::memmove(chunk.items + offset + 1, chunk.items + offset, sizeof(int) * (chunk.count - offset));
+    chunk.items[offset] = stock;
+    ++chunk.count;
+    refresh_starts(d, c);
+    ++d.size;
+    ++d.version;
+}
+
+// --- Writers ------------------------------------------------------------------
+
+inline bool append(VersionedInventory& v, int stock) {
+    std::lock_guard<std::mutex> guard(v.lock);
+    SnapshotDirectory& d = cow_writable(v.dir);
+    insert_locked(d, d.size, stock);
+    return true;
+}
+
+inline bool insert_at(VersionedInventory& v, int index, int stock) {
+    std::lock_guard<std::mutex> guard(v.lock);
+    if (index < 0 || index > v.dir->size) return false;
+    insert_locked(cow_writable(v.dir), index, stock);
+    return true;
+}
+
+inline bool delete_at(VersionedInventory& v, int index) {
+    std::lock_guard<std::mutex> guard(v.lock);
+    if (index < 0 || index >= v.dir->size) return false;
+    SnapshotDirectory& d = cow_writable(v.dir);
+    int offset;
+    int c = locate_snapshot_chunk(d, index, offset);
+    if (d.chunks[c]->count == 1) {
+        d.chunks.erase(d.chunks.begin() + c); // no copy: the chunk just goes away
+        d.starts.erase(d.starts.begin() + c);
+    } else {
+        CowChunk& chunk = cow_writable(d.chunks[c]);
+        std::memmove(chunk.items + offset, chunk.items + offset + 1, sizeof(int) * (chunk.count - offset - 1));
+        --chunk.count;
+    }
+    if (c < static_cast<int>(d.chunks.size())) refresh_starts(d, c);
+    --d.size;
+    ++d.version;
+    return true;
+}
+
+// Current value at 'index', for a writer that needs it before an edit.
+inline bool get(const VersionedInventory& v, int index, int& out) {
+    std::lock_guard<std::mutex> guard(v.lock);
+    if (index < 0 || index >= v.dir->size) return false;
+    int offset;
+    int c = locate_snapshot_chunk(*v.dir, index, offset);
+    out = v.dir->chunks[c]->items[offset];
+    return true;
+}
+
+// --- Readers (no lock: a snapshot never changes) ---------------------------------
+
+inline int snapshot_size(const InventorySnapshot& s) { return s.dir->size; }
+inline unsigned long long snapshot_version(const InventorySnapshot& s) { return s.dir->version; }
+
+inline int get(const InventorySnapshot& s, int index) {
+    int offset;
+    int c = locate_snapshot_chunk(*s.dir, index, offset);
+    return s.dir->chunks[c]->items[offset];
+}
+
+inline int find(const InventorySnapshot& s, int target) {
+    const InventoryKernels& k = inventory_kernels();
+    for (std::size_t c = 0; c < s.dir->chunks.size(); ++c) {
+        const CowChunk& chunk = *s.dir->chunks[c];
+        int i = k.find(chunk.items, chunk.count, target);
+        if (i >= 0) return s.dir->starts[c] + i;
+    }
+    return -1;
+}
+
+inline bool stats(const InventorySnapshot& s, int& out_min, int& out_max, double& out_avg) {
+    if (s.dir->size == 0) return false;
+    const InventoryKernels& k = inventory_kernels();
+    MinMaxSum all = k.minmaxsum(s.dir->chunks[0]->items, s.dir->chunks[0]->count);
+    for (std::size_t c = 1; c < s.dir->chunks.size(); ++c) {
+        MinMaxSum r = k.minmaxsum(s.dir->chunks[c]->items, s.dir->chunks[c]->count);
+        all.min = std::min(all.min, r.min);
+        all.max = std::max(all.max, r.max);
+        all.sum += r.sum;
+    }
+    out_min = all.min;
+    out_max = all.max;
+    out_avg = static_cast<double>(all.sum) / s.dir->size;
+    return true;
+}
+
+// Same text as print_inventory in inventory.hpp, plus the version.
+inline void print_inventory(const InventorySnapshot& s) {
+    std::cout.flush();
+    OutBuffer& out = stdout_buffer();
+    out_str(out, "📦 Stock List (size = ");
+    out_int(out, s.dir->size);
+    out_str(out, ", version ");
+    out_int(out, static_cast<long long>(s.dir->version));
+    out_str(out, "):\n[");
+    bool first = true;
+    for (const CowChunkRef& chunk : s.dir->chunks) {
+        for (int i = 0; i < chunk->count; ++i) {
+            if (!first) out_str(out, ", ");
+            first = false;
+            out_int(out, chunk->items[i]);
+        }
+    }
+    out_str(out, "]\n");
+    out_flush(out);
+}
+
+#endif // CENG241_INVENTORY_SNAPSHOT_HPP
@@ -0,0 +1,199 @@
+// CENG241 - Durable Inventory: snapshot + write-ahead log
+// -------------------------------------------------------
+// A DurableInventory is the lab's in-memory Inventory plus a write-ahead
+// log (../ledger_wal.hpp). Every successful change (create, append,
+// insert_at, delete_at, reserve, sort_asc, reverse) is logged as a small
+// record; a background thread writes the records in groups with one fsync
+// per group. Reading operations (find, stats, print) use led.inv directly.
+//
+// Files for the base name "stock":
+//   stock.snap  full copy of the ledger (a ledger file, see ../ledger_file.hpp)
+//   stock.wal   changes made after that copy
+//
+// open_durable_inventory loads stock.snap and replays stock.wal, so after a
+// crash the ledger is back at its last durable state.
+// checkpoint_durable_inventory writes a new snapshot and empties the log;
+// call it now and then so the log (and the replay time) stays short.
+//
+// Durability: the change functions return as soon as the record is queued.
+// Call flush_durable_inventory (or led.wal.wait_durable) before telling
+// anyone the change is safe, e.g. once per batch or per customer request.
+//
+// Usage:
+//   DurableInventory led;
+//   if (!open_durable_inventory(led, "stock")) return 1;
+//   if (!led.inv.data) create(led, 1024);
+//   append(led, 25);
+//   flush_durable_inventory(led);      // now 25 survives a crash
+//   checkpoint_durable_inventory(led); // optional: shorten the log
+//   close_durable_inventory(led);
+
+#ifndef CENG241_INVENTORY_WAL_HPP
+#define CENG241_INVENTORY_WAL_HPP
+
+#include <limits>
+#include <string>
+#include "inventory.hpp"
+#include "../ledger_wal.hpp"
+
+struct DurableInventory {
+    Inventory     inv;
+    WriteAheadLog wal;
+    std::string   snapshot_path; // base + ".snap"
+    std::string   wal_path;      // base + ".wal"
+};
+
+// Apply one logged change (used for replay; the lab functions do the work).
+inline bool apply_wal_record(Inventory& inv, const WalRecord& r) {
+    switch (r.op) {
+        case WAL_CREATE:
+            if (r.a <= 0) return false;
+            destroy(inv);
+            return create(inv, r.a);
+        case WAL_APPEND:
+            return append(inv, r.a);
+        case WAL_INSERT_AT:
+            return r.a >= 0 && r.a <= inv.size && insert_at(inv, r.a, r.b);
+        case WAL_DELETE_AT:
+            return r.a >= 0 && r.a < inv.size && delete_at(inv, r.a);
+        case WAL_RESERVE:
+            return r.a >= 0 && reserve(inv, r.a);
+        case WAL_SORT_ASC:
+            sort_asc(inv);
+            return true;
+        case WAL_REVERSE:
+            reverse(inv);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Load base.snap (if any), replay base.wal and open the log for writing.
+// Without files the ledger starts empty (inv.data == nullptr), just like
+// the menu before option 1.
+inline bool open_durable_inventory(DurableInventory& led, const char* base, WalOptions options = WalOptions()) {
+    led.inv = Inventory{nullptr, 0, 0};
+    led.snapshot_path = std::string(base) + ".snap";
+    led.wal_path = std::string(base) + ".wal";
+
+    std::uint32_t generation = 0;
+    SnapshotReader snap;
+    int found = ledger_snapshot_open(snap, led.snapshot_path.c_str(), LEDGER_KIND_INVENTORY);
+    if (found < 0) return false;
+    if (found > 0) {
+        generation = snap.header.generation;
+        int capacity = (snap.header.capacity <= static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+                     ? static_cast<int>(snap.header.capacity) : -1;
+        if (capacity < 0 || (capacity > 0 && !create(led.inv, capacity))) {
+            ledger_snapshot_close(snap);
+            return false;
+        }
+        if (!ledger_snapshot_read(snap, led.inv.data)) {
+            destroy(led.inv);
+            return false;
+        }
+        led.inv.size = static_cast<int>(snap.header.size);
+    }
+
+    WalReplayInfo info;
+    bool ok = wal_replay(led.wal_path.c_str(), generation, info,
+                         [&](const WalRecord& r) { return apply_wal_record(led.inv, r); });
+    if (!ok || !led.wal.open(led.wal_path.c_str(), generation, info.stale ? 0 : info.valid_bytes, options)) {
+        destroy(led.inv);
+        return false;
+    }
+    return true;
+}
+
+// Wait until every change so far is on disk.
+inline bool flush_durable_inventory(DurableInventory& led) {
+    return led.wal.sync();
+}
+
+// Write the whole ledger as snapshot generation+1 and restart the log.
+inline bool checkpoint_durable_inventory(DurableInventory& led) {
+    if (!led.wal.sync()) return false;
+    LedgerFileHeader shape{};
+    shape.kind = LEDGER_KIND_INVENTORY;
+    shape.size = static_cast<std::uint64_t>(led.inv.size);
+    shape.capacity = static_cast<std::uint64_t>(led.inv.capacity);
+    shape.generation = led.wal.generation() + 1;
+    if (!ledger_snapshot_write(led.snapshot_path, shape, led.inv.data)) return false;
+    return led.wal.restart(shape.generation);
+}
+
+// Sync the log and free the ledger (no checkpoint: the log is kept).
+inline bool close_durable_inventory(DurableInventory& led) {
+    bool ok = led.wal.close();
+    destroy(led.inv);
+    return ok;
+}
+
+// --- Logged versions of the changing lab functions ----------------------
+// Write-ahead order: each checks its arguments and does anything that can
+// fail (allocation) first, then logs the record, and changes led.inv only
+// once the log took it. So replay never meets an operation that fails, and
+// memory is never ahead of the log. false = the change was refused or the
+// log is broken; either way led.inv is unchanged.
+
+inline bool logged(DurableInventory& led, const WalRecord& r) {
+    return led.wal.log(r) != 0;
+}
+
+inline bool create(DurableInventory& led, int initial_capacity) {
+    Inventory fresh;
+    if (!create(fresh, initial_capacity)) return false;
+    if (!logged(led, WalRecord{WAL_CREATE, initial_capacity, 0, 0})) {
+        destroy(fresh);
+        return false;
+    }
+    destroy(led.inv);
+    led.inv = fresh;
+    return true;
+}
+
+inline bool reserve(DurableInventory& led, int new_capacity) {
+    if (new_capacity < 0) return false;
+    if (new_capacity == led.inv.capacity || new_capacity == 0) { // no allocation: cannot fail
+        return logged(led, WalRecord{WAL_RESERVE, new_capacity, 0, 0}) && reserve(led.inv, new_capacity);
+    }
+    int* new_data = allocate_stock(led.inv, new_capacity);
+    if (!new_data) return false;
+    if (!logged(led, WalRecord{WAL_RESERVE, new_capacity, 0, 0})) {
+        release_stock(led.inv, new_data, new_capacity);
+        return false;
+    }
+    adopt_stock(led.inv, new_data, new_capacity);
+    return true;
+}
+
+// Growing for one more item is not logged: replay grows the same way.
+inline bool append(DurableInventory& led, int stock) {
+    if (!ensure_capacity_for_one_more(led.inv)) return false;
+    return logged(led, WalRecord{WAL_APPEND, stock, 0, 0}) && append(led.inv, stock);
+}
+
+inline bool insert_at(DurableInventory& led, int index, int stock) {
+    if (index < 0 || index > led.inv.size || !ensure_capacity_for_one_more(led.inv)) return false;
+    return logged(led, WalRecord{WAL_INSERT_AT, index, stock, 0}) && insert_at(led.inv, index, stock);
+}
+
+inline bool delete_at(DurableInventory& led, int index) {
+    if (index < 0 || index >= led.inv.size) return false;
+    return logged(led, WalRecord{WAL_DELETE_AT, index, 0, 0}) && delete_at(led.inv, index);
+}
+
+inline bool sort_asc(DurableInventory& led) {
+    if (!logged(led, WalRecord{WAL_SORT_ASC, 0, 0, 0})) return false;
+    sort_asc(led.inv);
+    return true;
+}
+
+inline bool reverse(DurableInventory& led) {
+    if (!logged(led, WalRecord{WAL_REVERSE, 0, 0, 0})) return false;
+    reverse(led.inv);
+    return true;
+}
+
+#endif // CENG241_INVENTORY_WAL_HPP
@@ -19,21 +19,33 @@
 //
 // Build & Run (example):
 // ----------------------
-// g++ -std=c++17 -O2 -Wall -Wextra -pedantic inventory.cpp -o inventory
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread lab_1.cpp -o inventory
 // ./inventory
+// (or from the repository root: cmake -S . -B build && cmake --build build,
+//  which builds every program; this one is build/lab/251009/lab_1)
+// ./inventory --batch ops.txt     (non-interactive replay, see "Batch mode")
+// ./inventory --load stock.txt     (start with every number in the file, then the menu)
 //
 // Author: ChatGPT (C++ rewrite of the lab with explanations)
 
 #include <iostream>
 #include <limits>    // for std::numeric_limits
-#include <algorithm> // for std::sort, std::swap
 #include <iomanip>   // for std::setprecision
+#include <string>
+#include <cstring>   // for std::memcmp, std::memchr
+#include <fstream>   // batch mode: read script / op-log files
+#include <charconv>  // batch mode: std::from_chars (fast integer parsing)
+#include <chrono>    // batch mode: elapsed time in the summary
+#include <cstdlib>   // batch mode: std::atoi for --threads
+#include <memory>    // batch mode: std::unique_ptr for the thread pool
+#include <vector>    // batch mode: positions found by 'below'
+#include <csignal>   // SIGUSR1: dump metrics (inventory_metrics.hpp)
 
-struct Inventory {
-    int* data;     // pointer to the first element of a dynamic int array
-    int  size;     // how many elements are actually used
-    int  capacity; // how many elements are allocated
-};
+#include "inventory.hpp"
+#include "inventory_index.hpp" // batch mode: optional find index
+#include "inventory_parallel.hpp" // batch mode: --threads N
+#include "../ledger_loader.hpp"    // --load: bulk ingest of a value file
+#include "../ledger_export.hpp"    // 12) page view, 13) export to a file
 
 // Utility: safely read an integer from std::cin with prompt
 int read_int(const char* prompt) {
@@ -47,199 +59,469 @@ int read_int(const char* prompt) {
     }
 }
 
-// 1) create: allocate array with given initial capacity, set size=0
-bool create(Inventory& inv, int initial_capacity) {
-    if (initial_capacity <= 0) {
-        std::cout << "Initial capacity must be positive.\n";
-        inv.data = nullptr;
-        inv.size = 0;
-        inv.capacity = 0;
-        return false;
+// 13) print_menu: list the actions
+void print_menu() {
+    std::cout << "---------------------------------------------------\n";
+    std::cout << "1) Create new stock ledger\n";
+    std::cout << "2) Add (append) a new product’s stock\n";
+    std::cout << "3) Insert product stock at specific position\n";
+    std::cout << "4) Remove a product from inventory\n";
+    std::cout << "5) Find product by stock quantity\n";
+    std::cout << "6) Show current number of products and total capacity\n";
+    std::cout << "7) Reverse product list\n";
+    std::cout << "8) Display inventory statistics (min / max / average stock)\n";
+    std::cout << "9) Adjust reserved capacity\n";
+    std::cout << "10) Show all products’ stock values\n";
+    std::cout << "11) Sort inventory (ascending by stock)\n";
+    std::cout << "12) Show one page of products\n";
+    std::cout << "13) Export inventory to a file (CSV / JSON lines / binary)\n";
+    std::cout << "0) Exit\n";
+    std::cout << "---------------------------------------------------\n";
+}
+
+// ---------------------------------------------------------------------
+// Batch mode (no prompts)
+// ---------------------------------------------------------------------
+// The menu above is great for learning, but every single operation goes
+// through a prompt and a std::cout line. When we want to replay a whole
+// day of stock changes (millions of operations) that terminal I/O costs far
+// more than the operations themselves. Batch mode reads all operations from
+// a file, runs them silently and prints ONE summary at the end.
+//
+// Two input formats are supported:
+//
+// 1) Text script: one operation per line, '#' starts a comment.
+//      create 16
+//      append 25
+//      insert_at 1 99
+//      delete_at 2
+//      find 40
+//      sort_asc
+//      reverse
+//      stats
+//      reserve 64
+//      index_on             (maintain the hash/sorted index, see inventory_index.hpp)
+//      count_range 0 10     (how many products have 0 <= stock < 10)
+//      index_off            (drop the index for write-heavy stretches)
+//      stats_on             (keep live stats, see inventory_live_stats.hpp:
+//                            'stats' no longer reads the array)
+//      percentile 95        (stock level of the 95th percentile product)
+//      stats_off
+//      set_at 3 40          (product 3 now has 40 units)
+//      range 100 200        (sum / min / max of products 100..199,
+//                            segment tree, see inventory_range.hpp)
+//      below 5              (products under 5 units in the last 'range')
+//
+//    The index and live stats start OFF, so plain scripts behave exactly
+//    like before.
+//
+// 2) Binary op-log: the 8-byte magic "INVLOG01" followed by fixed-size
+//    9-byte records: [1 byte opcode][int32 arg1][int32 arg2] (little-endian).
+//    Fixed-size records need no parsing at all, so this is the fastest way
+//    to feed very large replays. Use --convert to turn a script into a log.
+//
+// Usage:
+//   ./lab_1 --batch ops.txt          (text script)
+//   ./lab_1 --batch ops.bin          (binary op-log, detected by its magic)
+//   ./lab_1 --batch ops.bin --threads 8   (sort_asc / stats on 8 threads
+//                                          for ledgers above PARALLEL_MIN_ELEMENTS)
+//   ./lab_1 --convert ops.txt ops.bin
+
+enum BatchOp : unsigned char {
+    OP_CREATE = 1,
+    OP_APPEND,
+    OP_INSERT_AT,
+    OP_DELETE_AT,
+    OP_FIND,
+    OP_SORT_ASC,
+    OP_REVERSE,
+    OP_STATS,
+    OP_RESERVE,
+    OP_INDEX_ON,
+    OP_INDEX_OFF,
+    OP_COUNT_RANGE,
+    OP_STATS_ON,
+    OP_STATS_OFF,
+    OP_PERCENTILE,
+    OP_SET_AT,
+    OP_RANGE,
+    OP_BELOW,
+    OP_COUNT // number of opcodes + 1 (used to size arrays)
+};
+
+const char* const BATCH_OP_NAMES[OP_COUNT] = {
+    "", "create", "append", "insert_at", "delete_at", "find",
+    "sort_asc", "reverse", "stats", "reserve",
+    "index_on", "index_off", "count_range",
+    "stats_on", "stats_off", "percentile",
+    "set_at", "range", "below"
+};
+
+const char BATCH_LOG_MAGIC[8] = {'I', 'N', 'V', 'L', 'O', 'G', '0', '1'};
+const int BATCH_RECORD_SIZE = 9; // 1 byte opcode + 2 * int32
+
+struct BatchRecord {
+    unsigned char op;
+    int a;
+    int b;
+};
+
+// Counters collected while replaying; printed once at the end.
+struct BatchSummary {
+    long long ok[OP_COUNT];
+    long long failed[OP_COUNT];
+    long long find_hits;
+    long long find_misses;
+    long long range_matches; // total of all count_range results
+    long long bad_lines; // unparsable script lines / unknown opcodes
+    bool has_stats;      // result of the last successful 'stats' op
+    int last_min;
+    int last_max;
+    double last_avg;
+    bool has_percentile; // result of the last successful 'percentile' op
+    int last_percent;
+    int last_percentile;
+    bool has_range;      // result of the last successful 'range' op
+    int range_first;
+    int range_last;
+    long long range_sum;
+    int range_min;
+    int range_max;
+    long long below_matches; // total of all 'below' results
+    std::vector<int> below_found; // scratch for 'below', reused between ops
+};
+
+// Read a whole file into memory in one go (much faster than line-by-line
+// std::getline for big files). Returns false if the file cannot be read.
+bool read_whole_file(const char* path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    in.seekg(0, std::ios::end);
+    std::streamoff len = in.tellg();
+    if (len < 0) return false;
+    out.resize(static_cast<size_t>(len));
+    in.seekg(0, std::ios::beg);
+    if (len > 0) in.read(&out[0], len);
+    return static_cast<bool>(in);
+}
+
+// Look up an opcode by its name; returns 0 if unknown.
+unsigned char batch_op_from_name(const char* begin, const char* end) {
+    size_t n = static_cast<size_t>(end - begin);
+    for (int op = 1; op < OP_COUNT; ++op) {
+        const char* name = BATCH_OP_NAMES[op];
+        if (std::strlen(name) == n && std::memcmp(name, begin, n) == 0) {
+            return static_cast<unsigned char>(op);
+        }
     }
-    // new int[initial_capacity] allocates space for 'initial_capacity' integers.
-    inv.data = new (std::nothrow) int[initial_capacity];
-    if (!inv.data) {
-        std::cout << "Memory allocation failed!\n";
-        inv.size = 0;
-        inv.capacity = 0;
-        return false;
+    return 0;
+}
+
+// How many integer arguments each opcode expects.
+int batch_op_arity(unsigned char op) {
+    switch (op) {
+        case OP_CREATE: case OP_APPEND: case OP_DELETE_AT:
+        case OP_FIND: case OP_RESERVE: case OP_PERCENTILE: case OP_BELOW:
+            return 1;
+        case OP_INSERT_AT: case OP_COUNT_RANGE: case OP_SET_AT: case OP_RANGE:
+            return 2;
+        default:
+            return 0;
     }
-    inv.size = 0;
-    inv.capacity = initial_capacity;
-    return true;
 }
 
-// 2) destroy: free allocated memory and reset members
-void destroy(Inventory& inv) {
-    // delete[] must match new[]
-    delete[] inv.data;
-    inv.data = nullptr;
-    inv.size = 0;
-    inv.capacity = 0;
+// Parse one script line [p, end) into 'out'.
+// Returns 1 on success, 0 for blank/comment lines, -1 for malformed lines.
+int parse_batch_line(const char* p, const char* end, BatchRecord& out) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    if (p == end || *p == '#') return 0;
+
+    const char* word = p;
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '#') ++p;
+    out.op = batch_op_from_name(word, p);
+    if (out.op == 0) return -1;
+
+    int args[2] = {0, 0};
+    int arity = batch_op_arity(out.op);
+    for (int k = 0; k < arity; ++k) {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        // std::from_chars parses without locales or allocations.
+        std::from_chars_result r = std::from_chars(p, end, args[k]);
+        if (r.ec != std::errc()) return -1;
+        p = r.ptr;
+    }
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    if (p != end && *p != '#') return -1; // trailing garbage
+
+    out.a = args[0];
+    out.b = args[1];
+    return 1;
 }
 
-// 3) reserve: pre-allocate capacity (can grow or shrink)
-bool reserve(Inventory& inv, int new_capacity) {
-    if (new_capacity < 0) {
-        std::cout << "New capacity cannot be negative.\n";
-        return false;
+// Apply one operation silently. Indices and capacities are validated HERE,
+// before calling the lab functions, so their error messages never print.
+// 'pool' is nullptr unless --threads was given.
+bool apply_batch_op(IndexedInventory& led, ThreadPool* pool, const BatchRecord& op, BatchSummary& sum) {
+    Inventory& inv = led.inv;
+    if (op.op == OP_CREATE) {
+        if (op.a <= 0) return false;
+        if (inv.data != nullptr) destroy(led);
+        return create(led, op.a);
     }
-    if (new_capacity == inv.capacity) {
-        return true; // nothing to do
+    // The index switch is a setting, it works with or without a ledger.
+    if (op.op == OP_INDEX_ON || op.op == OP_INDEX_OFF) {
+        set_index_enabled(led, op.op == OP_INDEX_ON);
+        return true;
     }
-    if (new_capacity == 0) {
-        // Free everything
-        destroy(inv);
+    if (op.op == OP_STATS_ON || op.op == OP_STATS_OFF) {
+        set_live_stats_enabled(led, op.op == OP_STATS_ON);
         return true;
     }
+    // Same rule as the menu: every other operation needs a ledger first.
+    if (inv.data == nullptr) return false;
 
-    int* new_data = new (std::nothrow) int[new_capacity];
-    if (!new_data) {
-        std::cout << "Memory reallocation failed!\n";
-        return false;
-    }
-    // Copy as many elements as will fit
-    int elements_to_copy = (inv.size < new_capacity) ? inv.size : new_capacity;
-    for (int i = 0; i < elements_to_copy; ++i) {
-        new_data[i] = inv.data[i];
+    switch (op.op) {
+        case OP_APPEND:
+            return append(led, op.a);
+        case OP_INSERT_AT:
+            if (op.a < 0 || op.a > inv.size) return false;
+            return insert_at(led, op.a, op.b);
+        case OP_DELETE_AT:
+            if (op.a < 0 || op.a >= inv.size) return false;
+            return delete_at(led, op.a);
+        case OP_FIND:
+            if (find(led, op.a) >= 0) ++sum.find_hits;
+            else ++sum.find_misses;
+            return true;
+        case OP_SORT_ASC:
+            if (!pool) {
+                sort_asc(led);
+                return true;
+            }
+            if (!parallel_sort_asc(inv, *pool)) return false;
+            index_after_sort(led);
+            return true;
+        case OP_REVERSE:
+            reverse(led);
+            return true;
+        case OP_STATS:
+            // Live stats already know the answer; no pass to parallelize.
+            sum.has_stats = (pool && !led.live_enabled)
+                                ? parallel_stats(inv, *pool, sum.last_min, sum.last_max, sum.last_avg)
+                                : stats(led, sum.last_min, sum.last_max, sum.last_avg);
+            return sum.has_stats;
+        case OP_PERCENTILE:
+            if (op.a < 0 || op.a > 100) return false;
+            if (!percentile(led, op.a / 100.0, sum.last_percentile)) return false;
+            sum.has_percentile = true;
+            sum.last_percent = op.a;
+            return true;
+        case OP_SET_AT:
+            if (op.a < 0 || op.a >= inv.size) return false;
+            return set_at(led, op.a, op.b);
+        case OP_RANGE:
+            if (!range_stats(led, op.a, op.b, sum.range_sum, sum.range_min, sum.range_max)) return false;
+            sum.has_range = true;
+            sum.range_first = op.a;
+            sum.range_last = op.b;
+            return true;
+        case OP_BELOW: {
+            // Positions may have changed since the 'range' op; clamp to the ledger.
+            if (!sum.has_range) return false;
+            int last = sum.range_last < inv.size ? sum.range_last : inv.size;
+            sum.below_matches += find_below(led, sum.range_first, last, op.a, sum.below_found);
+            return true;
+        }
+        case OP_RESERVE:
+            if (op.a < 0) return false;
+            return reserve(led, op.a);
+        case OP_COUNT_RANGE:
+            sum.range_matches += count_range(led, op.a, op.b);
+            return true;
+        default:
+            return false;
     }
-    delete[] inv.data;
-    inv.data = new_data;
-    inv.capacity = new_capacity;
-    // If we shrank below current size, adjust size
-    if (inv.size > new_capacity) {
-        inv.size = new_capacity;
+}
+
+void run_batch_op(IndexedInventory& led, ThreadPool* pool, const BatchRecord& op, BatchSummary& sum) {
+    if (op.op == 0 || op.op >= OP_COUNT) {
+        ++sum.bad_lines;
+        return;
     }
-    return true;
+    if (apply_batch_op(led, pool, op, sum)) ++sum.ok[op.op];
+    else ++sum.failed[op.op];
 }
 
-// Internal helper: grow capacity (e.g., double) when full
-bool ensure_capacity_for_one_more(Inventory& inv) {
-    if (inv.size < inv.capacity) return true;
-    int new_capacity = (inv.capacity == 0) ? 1 : inv.capacity * 2;
-    return reserve(inv, new_capacity);
+// Decode one little-endian int32 from a byte buffer.
+int decode_i32(const unsigned char* p) {
+    unsigned int u = static_cast<unsigned int>(p[0])
+                   | (static_cast<unsigned int>(p[1]) << 8)
+                   | (static_cast<unsigned int>(p[2]) << 16)
+                   | (static_cast<unsigned int>(p[3]) << 24);
+    int v;
+    std::memcpy(&v, &u, sizeof v);
+    return v;
 }
 
-// 4) append: add item to the end (grow if needed)
-bool append(Inventory& inv, int stock) {
-    if (!ensure_capacity_for_one_more(inv)) {
-        return false;
-    }
-    inv.data[inv.size++] = stock;
-    return true;
+void encode_i32(unsigned char* p, int v) {
+    unsigned int u;
+    std::memcpy(&u, &v, sizeof u);
+    p[0] = static_cast<unsigned char>(u);
+    p[1] = static_cast<unsigned char>(u >> 8);
+    p[2] = static_cast<unsigned char>(u >> 16);
+    p[3] = static_cast<unsigned char>(u >> 24);
 }
 
-// 5) insert_at: insert item at index, shift right
-bool insert_at(Inventory& inv, int index, int stock) {
-    if (index < 0 || index > inv.size) {
-        std::cout << "Index out of bounds.\n";
-        return false;
-    }
-    if (!ensure_capacity_for_one_more(inv)) {
-        return false;
-    }
-    // Shift elements [index..size-1] one position to the right
-    for (int i = inv.size - 1; i >= index; --i) {
-        inv.data[i + 1] = inv.data[i];
-    }
-    inv.data[index] = stock;
-    ++inv.size;
-    return true;
+bool is_binary_log(const std::string& buf) {
+    return buf.size() >= sizeof BATCH_LOG_MAGIC
+        && std::memcmp(buf.data(), BATCH_LOG_MAGIC, sizeof BATCH_LOG_MAGIC) == 0;
 }
 
-// 6) delete_at: remove item at index, shift left
-bool delete_at(Inventory& inv, int index) {
-    if (index < 0 || index >= inv.size) {
-        std::cout << "Index out of bounds.\n";
-        return false;
+// Call 'fn' for every operation in the buffer (script or binary log).
+template <typename Fn>
+void for_each_batch_op(const std::string& buf, BatchSummary& sum, Fn fn) {
+    if (is_binary_log(buf)) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(buf.data()) + sizeof BATCH_LOG_MAGIC;
+        size_t records = (buf.size() - sizeof BATCH_LOG_MAGIC) / BATCH_RECORD_SIZE;
+        if ((buf.size() - sizeof BATCH_LOG_MAGIC) % BATCH_RECORD_SIZE != 0) ++sum.bad_lines; // truncated tail
+        for (size_t r = 0; r < records; ++r, p += BATCH_RECORD_SIZE) {
+            BatchRecord op{p[0], decode_i32(p + 1), decode_i32(p + 5)};
+            fn(op);
+        }
+        return;
     }
-    // Shift elements [index+1..size-1] left by one
-    for (int i = index + 1; i < inv.size; ++i) {
-        inv.data[i - 1] = inv.data[i];
+    const char* p = buf.data();
+    const char* end = p + buf.size();
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!eol) eol = end;
+        BatchRecord op{0, 0, 0};
+        int r = parse_batch_line(p, eol, op);
+        if (r > 0) fn(op);
+        else if (r < 0) ++sum.bad_lines;
+        p = eol + 1;
     }
-    --inv.size;
-    return true;
 }
 
-// 7) find: return first index whose value == target, else -1
-int find(const Inventory& inv, int target) {
-    for (int i = 0; i < inv.size; ++i) {
-        if (inv.data[i] == target) return i;
+void print_batch_summary(const Inventory& inv, const BatchSummary& sum, double seconds) {
+    long long total_ok = 0, total_failed = 0;
+    std::cout << "=== Batch summary ===\n";
+    for (int op = 1; op < OP_COUNT; ++op) {
+        total_ok += sum.ok[op];
+        total_failed += sum.failed[op];
+        if (sum.ok[op] == 0 && sum.failed[op] == 0) continue;
+        std::cout << std::left << std::setw(10) << BATCH_OP_NAMES[op] << std::right
+                  << " ok = " << sum.ok[op] << ", failed = " << sum.failed[op] << "\n";
+    }
+    std::cout << "Operations: " << (total_ok + total_failed) << " (" << total_failed << " failed, "
+              << sum.bad_lines << " malformed)\n";
+    std::cout << "Find hits/misses: " << sum.find_hits << " / " << sum.find_misses << "\n";
+    if (sum.ok[OP_COUNT_RANGE] > 0) std::cout << "Range matches: " << sum.range_matches << "\n";
+    std::cout << "Final size: " << inv.size << ", capacity: " << inv.capacity << "\n";
+    if (sum.has_stats) {
+        std::cout << "Last stats: min = " << sum.last_min << ", max = " << sum.last_max
+                  << ", avg = " << std::fixed << std::setprecision(2) << sum.last_avg << "\n";
+    }
+    if (sum.has_range) {
+        std::cout << "Last range [" << sum.range_first << ", " << sum.range_last << "): sum = " << sum.range_sum
+                  << ", min = " << sum.range_min << ", max = " << sum.range_max << "\n";
+    }
+    if (sum.ok[OP_BELOW] > 0) std::cout << "Below-threshold matches: " << sum.below_matches << "\n";
+    if (sum.has_percentile) {
+        std::cout << "Last percentile: p" << sum.last_percent << " = " << sum.last_percentile << "\n";
     }
-    return -1;
+    std::cout << "Elapsed: " << std::fixed << std::setprecision(3) << seconds << " s";
+    if (seconds > 0) {
+        std::cout << " (" << std::setprecision(0) << (total_ok + total_failed) / seconds << " ops/s)";
+    }
+    std::cout << "\n";
 }
 
-// 8) print: dump list with size/capacity
-void print_inventory(const Inventory& inv) {
-    std::cout << "📦 Stock List (size = " << inv.size
-              << " / capacity = " << inv.capacity << "):\n[";
-    for (int i = 0; i < inv.size; ++i) {
-        std::cout << inv.data[i];
-        if (i + 1 < inv.size) std::cout << ", ";
+int run_batch(const char* path, int threads) {
+    std::string buf;
+    if (!read_whole_file(path, buf)) {
+        std::cout << "Cannot read batch file: " << path << "\n";
+        return 1;
     }
-    std::cout << "]\n";
-}
+    IndexedInventory led{}; // empty ledger, index and live stats off
+    BatchSummary sum{};
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) pool.reset(new ThreadPool(threads));
 
-// 9) sort_asc: sort from low to high
-void sort_asc(Inventory& inv) {
-    std::sort(inv.data, inv.data + inv.size);
-}
+    auto t0 = std::chrono::steady_clock::now();
+    for_each_batch_op(buf, sum, [&](const BatchRecord& op) { run_batch_op(led, pool.get(), op, sum); });
+    auto t1 = std::chrono::steady_clock::now();
 
-// 10) reverse: in-place reversal
-void reverse(Inventory& inv) {
-    int i = 0, j = inv.size - 1;
-    while (i < j) {
-        std::swap(inv.data[i], inv.data[j]);
-        ++i;
-        --j;
-    }
+    print_batch_summary(led.inv, sum, std::chrono::duration<double>(t1 - t0).count());
+    dump_inventory_metrics_if_requested();
+    destroy(led);
+    return 0;
 }
 
-// 11) stats: compute min, max, average; return false if empty
-bool stats(const Inventory& inv, int& out_min, int& out_max, double& out_avg) {
-    if (inv.size == 0) return false;
-    int mn = inv.data[0];
-    int mx = inv.data[0];
-    long long sum = 0; // use wider type to avoid overflow on large arrays
-    for (int i = 0; i < inv.size; ++i) {
-        if (inv.data[i] < mn) mn = inv.data[i];
-        if (inv.data[i] > mx) mx = inv.data[i];
-        sum += inv.data[i];
+// Convert a text script into a binary op-log (for fast repeated replays).
+int convert_batch(const char* script_path, const char* log_path) {
+    std::string buf;
+    if (!read_whole_file(script_path, buf)) {
+        std::cout << "Cannot read batch file: " << script_path << "\n";
+        return 1;
     }
-    out_min = mn;
-    out_max = mx;
-    out_avg = static_cast<double>(sum) / inv.size;
-    return true;
-}
+    std::ofstream out(log_path, std::ios::binary);
+    if (!out) {
+        std::cout << "Cannot write op-log: " << log_path << "\n";
+        return 1;
+    }
+    out.write(BATCH_LOG_MAGIC, sizeof BATCH_LOG_MAGIC);
 
-// 12) show_size_capacity: prints current size/capacity
-void show_size_capacity(const Inventory& inv) {
-    std::cout << "Size: " << inv.size << ", Capacity: " << inv.capacity << "\n";
+    BatchSummary sum{};
+    long long records = 0;
+    for_each_batch_op(buf, sum, [&](const BatchRecord& op) {
+        unsigned char rec[BATCH_RECORD_SIZE];
+        rec[0] = op.op;
+        encode_i32(rec + 1, op.a);
+        encode_i32(rec + 5, op.b);
+        out.write(reinterpret_cast<const char*>(rec), BATCH_RECORD_SIZE);
+        ++records;
+    });
+    if (!out) {
+        std::cout << "Write failed: " << log_path << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << records << " operations to " << log_path
+              << " (" << sum.bad_lines << " malformed lines skipped)\n";
+    return 0;
 }
 
-// 13) print_menu: list the actions
-void print_menu() {
-    std::cout << "---------------------------------------------------\n";
-    std::cout << "1) Create new stock ledger\n";
-    std::cout << "2) Add (append) a new product’s stock\n";
-    std::cout << "3) Insert product stock at specific position\n";
-    std::cout << "4) Remove a product from inventory\n";
-    std::cout << "5) Find product by stock quantity\n";
-    std::cout << "6) Show current number of products and total capacity\n";
-    std::cout << "7) Reverse product list\n";
-    std::cout << "8) Display inventory statistics (min / max / average stock)\n";
-    std::cout << "9) Adjust reserved capacity\n";
-    std::cout << "10) Show all products’ stock values\n";
-    std::cout << "11) Sort inventory (ascending by stock)\n";
-    std::cout << "0) Exit\n";
-    std::cout << "---------------------------------------------------\n";
-}
+int main(int argc, char* argv[]) {
+    // Builds with INVENTORY_METRICS=1 dump their counters on `kill -USR1 <pid>`.
+    install_metrics_signal(SIGUSR1);
+    if (argc == 3 && std::string(argv[1]) == "--batch") {
+        return run_batch(argv[2], 1);
+    }
+    if (argc == 5 && std::string(argv[1]) == "--batch" && std::string(argv[3]) == "--threads") {
+        return run_batch(argv[2], std::atoi(argv[4]));
+    }
+    if (argc == 4 && std::string(argv[1]) == "--convert") {
+        return convert_batch(argv[2], argv[3]);
+    }
 
-int main() {
     std::cout << "=== Welcome to the Dynamic Stock Ledger System (C++ version) ===\n";
     std::cout << "Manage your store’s product stock easily through the options below.\n";
 
     Inventory inv{nullptr, 0, 0};
+    if (argc == 3 && std::string(argv[1]) == "--load") {
+        // mmap + direct parsing, far faster than typing or cin for big files.
+        LoadReport report;
+        if (!load_inventory(inv, argv[2], report)) {
+            std::cout << "Could not load " << argv[2] << "\n";
+            return 1;
+        }
+        std::cout << "Loaded " << report.values << " stock values from " << argv[2];
+        if (report.bad_lines > 0) {
+            std::cout << " (" << report.bad_lines << " malformed lines skipped, first: line "
+                      << report.bad_line_numbers[0] << ")";
+        }
+        std::cout << "\n";
+    }
     bool running = true;
     while (running) {
         print_menu();
@@ -366,6 +648,38 @@ int main() {
                 std::cout << u8"✅ Inventory sorted successfully.\n";
                 break;
             }
+            case 12: {
+                if (!inv.data) {
+                    std::cout << "Please create the inventory first (option 1).\n";
+                    break;
+                }
+                int page_size = read_int("Enter products per page: ");
+                int page = read_int("Enter page number (starting at 1): ");
+                if (!print_inventory_page(inv, page - 1, page_size)) {
+                    std::cout << "No such page.\n";
+                }
+                break;
+            }
+            case 13: {
+                if (!inv.data) {
+                    std::cout << "Please create the inventory first (option 1).\n";
+                    break;
+                }
+                int format = read_int("Format (0 = CSV, 1 = JSON lines, 2 = binary): ");
+                if (format < 0 || format > 2) {
+                    std::cout << "Unknown format.\n";
+                    break;
+                }
+                std::cout << "Enter file name: ";
+                std::string file;
+                std::cin >> file;
+                if (export_inventory_file(inv, file.c_str(), static_cast<ExportFormat>(format))) {
+                    std::cout << u8"✅ Exported " << inv.size << " products to " << file << ".\n";
+                } else {
+                    std::cout << "Could not write " << file << ".\n";
+                }
+                break;
+            }
             case 0: {
                 running = false;
                 break;
@@ -376,6 +690,7 @@ int main() {
     }
 
     destroy(inv); // Always free memory before exiting
+    dump_inventory_metrics_if_requested();
 
     std::cout << "Goodbye!\n";
     return 0;
@@ -0,0 +1,86 @@
+// CENG241 - Benchmark: heap vs pool vs arena for short-lived ledgers
+// -----------------------------------------------------------------
+// Every thread repeatedly builds a small per-store ledger (an Inventory
+// that grows by appends plus a 1 x 64 StockMatrix row), uses it briefly and
+// throws it away:
+//   heap   new[] / delete[] for every buffer (the lab default)
+//   pool   thread_pool_allocator(): freed buffers are reused per size class
+//   arena  thread_arena(): ledgers are never freed one by one; after each
+//          batch of BATCH ledgers ONE reset() releases them all
+// The checksum must be the same for all three.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread bench_allocators.cpp -o bench_allocators
+// ./bench_allocators [ledgers_per_thread] [threads]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "251009/inventory.hpp"
+#include "stock_matrix.hpp"
+
+const int BATCH = 1000;         // arena: ledgers per reset()
+const int APPENDS = 100;        // grows the Inventory 8 -> 16 -> ... -> 128
+const int ROW_ITEMS = 64;
+
+enum Mode { HEAP, POOL, ARENA };
+const char* const MODE_NAMES[] = {"heap", "pool", "arena"};
+
+// Build, use and drop one ledger; returns a value so nothing is optimized away.
+long long one_ledger(LedgerAllocator* alloc, bool destroy_it, int seed) {
+    Inventory inv;
+    StockMatrix row;
+    if (!create(inv, 8, alloc) || !create_matrix(row, 1, ROW_ITEMS, MatrixLayout::RowMajor, alloc)) return -1;
+    for (int i = 0; i < APPENDS; ++i) append(inv, seed + i);
+    for (int i = 0; i < ROW_ITEMS; ++i) cell(row, 0, i) = inv.data[i];
+    long long sum = store_total(row, 0) + inv.size;
+    if (destroy_it) {
+        destroy(inv);
+        destroy_matrix(row);
+    }
+    return sum;
+}
+
+long long run_thread(Mode mode, int ledgers) {
+    long long checksum = 0;
+    for (int k = 0; k < ledgers; ++k) {
+        if (mode == HEAP) checksum += one_ledger(nullptr, true, k);
+        else if (mode == POOL) checksum += one_ledger(&thread_pool_allocator(), true, k);
+        else {
+            checksum += one_ledger(&thread_arena(), false, k);
+            if ((k + 1) % BATCH == 0) thread_arena().reset(); // the whole batch in one step
+        }
+    }
+    if (mode == ARENA) thread_arena().reset();
+    return checksum;
+}
+
+int main(int argc, char* argv[]) {
+    int ledgers = (argc > 1) ? std::stoi(argv[1]) : 200000;
+    int threads = (argc > 2) ? std::stoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+
+    std::cout << ledgers << " ledgers per thread, " << threads << " thread(s)\n";
+    long long reference = 0;
+    bool ok = true;
+    for (Mode mode : {HEAP, POOL, ARENA}) {
+        std::vector<long long> sums(threads);
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) pool.emplace_back([&, t] { sums[t] = run_thread(mode, ledgers); });
+        for (std::thread& th : pool) th.join();
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        long long total = 0;
+        for (long long v : sums) total += v;
+        if (mode == HEAP) reference = total;
+        ok = ok && total == reference;
+        std::cout << std::left << std::setw(6) << MODE_NAMES[mode] << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(12) << (static_cast<double>(ledgers) * threads / s)
+                  << " ledgers/s" << (total == reference ? "" : "  CHECKSUM MISMATCH") << "\n";
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+// CENG241 - Benchmark: plain int/double arrays vs packed columns
+// ---------------------------------------------------------------
+// Three data sets, each compared in bytes and scan speed:
+//   quantities  an Inventory of N stock counts, mostly 0..200 with some
+//               blocks of large counts: stats() on the Inventory vs on the
+//               packed column, find() of a missing value
+//   matrix      a stores x items StockMatrix vs ColumnarStock: item totals
+//   prices      N prices with two decimals, packed with a guard of half a
+//               cent (0.005): float where that is safe, double elsewhere
+// Every result must match the plain version.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread -I251009 bench_columnar.cpp -o bench_columnar
+// ./bench_columnar [N] [stores] [items]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "columnar_stock.hpp"
+
+const int REPEAT = 10;
+
+template <typename Fn>
+double best_seconds(Fn fn) {
+    double best = 1e30;
+    for (int r = 0; r < REPEAT; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        best = s < best ? s : best;
+    }
+    return best;
+}
+
+void line(const char* what, std::size_t plain_bytes, std::size_t packed, double plain_s, double packed_s) {
+    std::cout << std::left << std::setw(22) << what << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << plain_bytes / 1e6 << " MB" << std::setw(9) << packed / 1e6 << " MB"
+              << std::setw(7) << static_cast<double>(plain_bytes) / packed << "x" << std::setprecision(2)
+              << std::setw(10) << plain_s * 1000 << " ms" << std::setw(9) << packed_s * 1000 << " ms\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = (argc > 1) ? std::stoull(argv[1]) : 20000000;
+    int stores = (argc > 2) ? std::stoi(argv[2]) : 5000;
+    int items = (argc > 3) ? std::stoi(argv[3]) : 1000;
+    bool ok = true;
+    std::mt19937 rng(241);
+
+    std::cout << bulk_kernels().name << " kernels\n" << std::left << std::setw(22) << "" << std::right
+              << std::setw(12) << "plain" << std::setw(12) << "packed" << std::setw(8) << "ratio"
+              << std::setw(13) << "plain scan" << std::setw(12) << "packed" << "\n";
+
+    // Quantities: every 16th block holds counts up to 50000 (2-byte deltas).
+    Inventory inv{nullptr, 0, 0};
+    create(inv, static_cast<int>(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        bool big = (i / PACK_BLOCK) % 16 == 15;
+        inv.data[i] = static_cast<int>(rng() % (big ? 50000 : 200));
+    }
+    inv.size = static_cast<int>(n);
+    PackedIntColumn qty;
+    pack_inventory(inv, qty);
+
+    int mn1 = 0, mx1 = 0, mn2 = 0, mx2 = 0;
+    double avg1 = 0, avg2 = 0;
+    double plain_s = best_seconds([&] { stats(inv, mn1, mx1, avg1); });
+    double packed_s = best_seconds([&] { stats(qty, mn2, mx2, avg2); });
+    ok = ok && mn1 == mn2 && mx1 == mx2 && avg1 == avg2;
+    line("quantities: stats", n * sizeof(int), packed_bytes(qty), plain_s, packed_s);
+
+    int f1 = 0;
+    long long f2 = 0;
+    plain_s = best_seconds([&] { f1 = find(inv, 60000); });
+    packed_s = best_seconds([&] { f2 = find(qty, 60000); });
+    ok = ok && f1 == f2;
+    line("quantities: find miss", n * sizeof(int), packed_bytes(qty), plain_s, packed_s);
+
+    std::vector<int> back(n);
+    unpack_ints(qty, back.data());
+    ok = ok && std::equal(back.begin(), back.end(), inv.data);
+    destroy(inv);
+
+    // Matrix: stock levels of 0..150 per cell.
+    StockMatrix m;
+    if (!create_matrix(m, stores, items, MatrixLayout::ColMajor)) return 1;
+    for (int i = 0; i < items; ++i) {
+        for (int s = 0; s < stores; ++s) cell(m, s, i) = static_cast<int>(rng() % 151);
+    }
+    ColumnarStock cs;
+    pack_matrix(m, cs);
+    std::vector<long long> t1(items), t2(items);
+    plain_s = best_seconds([&] { item_totals(m, t1.data()); });
+    packed_s = best_seconds([&] { columnar_item_totals(cs, t2.data()); });
+    ok = ok && t1 == t2 && columnar_cell(cs, stores / 2, items / 2) == cell(m, stores / 2, items / 2);
+    line("matrix: item totals", matrix_bytes(m), packed_bytes(cs), plain_s, packed_s);
+    destroy_matrix(m);
+
+    // Prices: cents / 100. Below 2^17 a float is exact to within 1/128 of
+    // a cent, so those blocks become float; every 8th block holds large
+    // amounts (up to 1e8) and stays double.
+    std::vector<double> prices(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        bool big = (i / PACK_BLOCK) % 8 == 7;
+        prices[i] = static_cast<double>(rng() % (big ? 10000000000ULL : 10000000ULL)) / 100.0;
+    }
+    PackedRealColumn pc;
+    pack_reals(pc, prices.data(), n, 0.005);
+    double pmin1 = 0, pmax1 = 0, s1 = 0, pmin2 = 0, pmax2 = 0, pavg2 = 0;
+    plain_s = best_seconds([&] { s1 = accurate_sum(prices.data(), n); });
+    packed_s = best_seconds([&] { stats(pc, pmin2, pmax2, pavg2); });
+    pmin1 = *std::min_element(prices.begin(), prices.end());
+    pmax1 = *std::max_element(prices.begin(), prices.end());
+    double worst = 0;
+    for (std::size_t i = 0; i < n; ++i) worst = std::max(worst, std::fabs(packed_real_at(pc, i) - prices[i]));
+    ok = ok && worst <= 0.005 && pmin1 == pmin2 && pmax1 == pmax2;
+    line("prices: sum", n * sizeof(double), packed_bytes(pc), plain_s, packed_s);
+    std::cout << pc.float_blocks << " of " << pc.blocks.size() << " price blocks stored as float, worst error "
+              << std::scientific << std::setprecision(2) << worst << ", total " << std::fixed << s1 << " vs "
+              << pavg2 * static_cast<double>(n) << "\n";
+
+    std::cout << (ok ? "all results match\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
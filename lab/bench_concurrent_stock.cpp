@@ -0,0 +1,105 @@
+// CENG241 - Benchmark: concurrent add/reduce on ConcurrentStockMatrix
+// -------------------------------------------------------------------
+// Many threads hammer a small table of hot cells (the worst case for
+// contention) with add_stock, reduce_stock and 3-line reduce_order calls.
+// For each thread count it prints the update rate and checks two
+// invariants that a racy int** version would break:
+//   1) no cell is ever negative,
+//   2) final total == units added - units removed (no lost updates).
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread bench_concurrent_stock.cpp -o bench_concurrent_stock
+// ./bench_concurrent_stock [ops_per_thread] [max_threads]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrent_stock_matrix.hpp"
+
+const int BENCH_STORES = 8;
+const int BENCH_ITEMS = 8;
+
+struct ThreadResult {
+    long long added;
+    long long removed;
+};
+
+void worker(ConcurrentStockMatrix& m, int ops, unsigned seed, ThreadResult& out) {
+    std::mt19937 rng(seed);
+    long long added = 0, removed = 0;
+    for (int k = 0; k < ops; ++k) {
+        int s = static_cast<int>(rng() % BENCH_STORES);
+        int i = static_cast<int>(rng() % BENCH_ITEMS);
+        int qty = 1 + static_cast<int>(rng() % 5);
+        switch (rng() % 3) {
+            case 0:
+                add_stock(m, s, i, qty);
+                added += qty;
+                break;
+            case 1: {
+                int taken;
+                reduce_stock(m, s, i, qty, taken);
+                removed += taken;
+                break;
+            }
+            default: {
+                OrderLine order[3] = {{s, i, qty}, {s, (i + 1) % BENCH_ITEMS, 1}, {(s + 1) % BENCH_STORES, i, 2}};
+                if (reduce_order(m, order, 3)) removed += qty + 1 + 2;
+                break;
+            }
+        }
+    }
+    out = ThreadResult{added, removed};
+}
+
+void run(int threads, int ops, int cells_per_line) {
+    ConcurrentStockMatrix m;
+    create_concurrent_matrix(m, BENCH_STORES, BENCH_ITEMS, cells_per_line);
+
+    std::vector<ThreadResult> results(threads);
+    std::vector<std::thread> pool;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back(worker, std::ref(m), ops, 1000u + t, std::ref(results[t]));
+    }
+    for (std::thread& th : pool) th.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    long long expected = 0, total = 0;
+    bool negative = false;
+    for (const ThreadResult& r : results) expected += r.added - r.removed;
+    for (int s = 0; s < BENCH_STORES; ++s) {
+        for (int i = 0; i < BENCH_ITEMS; ++i) {
+            int v = load_stock(m, s, i);
+            total += v;
+            negative = negative || v < 0;
+        }
+    }
+
+    std::cout << std::setw(8) << threads
+              << std::setw(16) << cells_per_line
+              << std::setw(16) << std::fixed << std::setprecision(0)
+              << (static_cast<double>(threads) * ops / seconds)
+              << "  " << ((total == expected && !negative) ? "ok" : "BROKEN") << "\n";
+    destroy_concurrent_matrix(m);
+}
+
+int main(int argc, char* argv[]) {
+    int ops = (argc > 1) ? std::stoi(argv[1]) : 1000000;
+    int max_threads = (argc > 2) ? std::stoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (max_threads < 1) max_threads = 1;
+
+    std::cout << "Operations per thread: " << ops << "\n";
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "cells/line" << std::setw(16) << "updates/s" << "  check\n";
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > max_threads) threads = max_threads;
+        run(threads, ops, INTS_PER_LINE); // packed
+        run(threads, ops, 1);             // one cell per cache line
+        if (threads == max_threads) break;
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+// CENG241 - Benchmark: std::cout / std::endl vs the buffered exporters
+// -------------------------------------------------------------------
+// Writes N stock values to a file in several ways:
+//   endl     `out << v << std::endl` (flushes every line)
+//   stream   `out << v << '\n'` (one << per number, stream buffering)
+//   csv      export_inventory_file(..., EXPORT_CSV)    to_chars + write(2)
+//   jsonl    export_inventory_file(..., EXPORT_JSONL)
+//   binary   export_inventory_file(..., EXPORT_BINARY) raw int32
+// The CSV must load back (ledger_loader.hpp) to the same values, the
+// stream file must be byte-identical to it, and a StockMatrix must survive
+// the same round trip. 'endl' only writes the first N/10 values (it is slow).
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread -I251009 bench_export.cpp -o bench_export
+// ./bench_export [N] [dir]      (default 10000000 values in /tmp)
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include "ledger_export.hpp"
+#include "ledger_loader.hpp"
+
+double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void report(const char* name, std::size_t n, double s) {
+    std::cout << std::left << std::setw(8) << name << std::right << std::setw(8) << s << " s" << std::setw(10)
+              << n / s / 1e6 << " M values/s\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = (argc > 1) ? std::stoull(argv[1]) : 10000000;
+    std::string dir = (argc > 2) ? argv[2] : "/tmp";
+    std::string stream_path = dir + "/bench_export_stream.txt";
+    std::string csv_path = dir + "/bench_export.csv";
+    std::string jsonl_path = dir + "/bench_export.jsonl";
+    std::string bin_path = dir + "/bench_export.bin";
+
+    Inventory inv{nullptr, 0, 0};
+    if (!create(inv, static_cast<int>(n))) return 1;
+    std::mt19937 rng(241);
+    for (std::size_t i = 0; i < n; ++i) append(inv, static_cast<int>(rng() % 2000000) - 1000000);
+
+    std::cout << std::fixed << std::setprecision(2) << n << " values\n";
+
+    std::size_t n_endl = n / 10;
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        std::ofstream out(stream_path);
+        for (std::size_t i = 0; i < n_endl; ++i) out << inv.data[i] << std::endl;
+    }
+    report("endl", n_endl, seconds_since(t0));
+
+    t0 = std::chrono::steady_clock::now();
+    {
+        std::ofstream out(stream_path);
+        for (int i = 0; i < inv.size; ++i) out << inv.data[i] << '\n';
+    }
+    report("stream", n, seconds_since(t0));
+
+    bool ok = true;
+    const ExportFormat formats[] = {EXPORT_CSV, EXPORT_JSONL, EXPORT_BINARY};
+    const char* names[] = {"csv", "jsonl", "binary"};
+    const std::string* paths[] = {&csv_path, &jsonl_path, &bin_path};
+    for (int f = 0; f < 3; ++f) {
+        t0 = std::chrono::steady_clock::now();
+        ok = export_inventory_file(inv, paths[f]->c_str(), formats[f]) && ok;
+        report(names[f], n, seconds_since(t0));
+    }
+
+    // Round trips.
+    ok = ok && read_file(stream_path) == read_file(csv_path);
+    std::string bin = read_file(bin_path);
+    ok = ok && bin.size() == n * sizeof(int) && std::memcmp(bin.data(), inv.data, bin.size()) == 0;
+    Inventory back{nullptr, 0, 0};
+    LoadReport lr;
+    ok = ok && load_inventory(back, csv_path.c_str(), lr) && lr.bad_lines == 0 && back.size == inv.size &&
+         std::memcmp(back.data, inv.data, n * sizeof(int)) == 0;
+    destroy(back);
+
+    StockMatrix m, m2{};
+    bool mok = create_matrix(m, 300, 1000, MatrixLayout::ColMajor);
+    for (int s = 0; mok && s < m.stores; ++s) {
+        for (int i = 0; i < m.items; ++i) cell(m, s, i) = (s * 31 + i * 7) % 500 - 100;
+    }
+    mok = mok && export_matrix_file(m, csv_path.c_str(), EXPORT_CSV) && load_matrix(m2, csv_path.c_str(), lr) &&
+          m2.stores == m.stores && m2.items == m.items;
+    for (int s = 0; mok && s < m.stores; ++s) {
+        for (int i = 0; mok && i < m.items; ++i) mok = cell(m, s, i) == cell(m2, s, i);
+    }
+    destroy_matrix(m2);
+    destroy_matrix(m);
+    destroy(inv);
+
+    for (const std::string* p : paths) std::remove(p->c_str());
+    std::remove(stream_path.c_str());
+    std::cout << (ok && mok ? "results match\n" : "RESULTS DIFFER\n");
+    return ok && mok ? 0 : 1;
+}
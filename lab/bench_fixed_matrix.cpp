@@ -0,0 +1,109 @@
+// CENG241 - Benchmark: fixed-shape vs runtime-shape stock matrix
+// --------------------------------------------------------------
+// For a few shapes (the week1_task2 default 10 x 5 first) the same loop runs
+// on three tables: one cell update, then every store total and every item
+// total, repeated many times:
+//
+//   fixed     ledger::StockMatrix<Stores, Items>  (stock_matrix_fixed.hpp)
+//   dynamic   ledger::DynamicStockMatrix<>        (same interface, runtime shape)
+//   lab       ::StockMatrix + its free functions  (stock_matrix.hpp)
+//
+// The loop is one template (run_loop) written against the shared interface;
+// the lab struct gets a thin adapter. Checks: all three produce the same
+// checksum of the totals. A static_assert shows the fixed matrix working
+// at compile time.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic bench_fixed_matrix.cpp -o bench_fixed_matrix
+// ./bench_fixed_matrix [cells_touched_millions]      (default 400)
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "stock_matrix.hpp"
+#include "stock_matrix_fixed.hpp"
+
+// The fixed matrix in a constant expression: built, filled and summed by
+// the compiler.
+constexpr long long compile_time_total() {
+    ledger::StockMatrix<3, 4> m;
+    for (int s = 0; s < 3; ++s) {
+        for (int i = 0; i < 4; ++i) m.cell(s, i) = s + i;
+    }
+    return m.total() + m.store_total(2);
+}
+static_assert(compile_time_total() == 30 + 14, "constexpr StockMatrix");
+
+// ::StockMatrix behind the member interface of the ledger:: matrices.
+struct LabMatrix {
+    using total_type = long long;
+    ::StockMatrix m{};
+
+    bool create(int stores, int items) { return create_matrix(m, stores, items); }
+    ~LabMatrix() { destroy_matrix(m); }
+    int stores() const { return m.stores; }
+    int items() const { return m.items; }
+    int& cell(int store, int item) { return ::cell(m, store, item); }
+    void store_totals(long long* out) const { ::store_totals(m, out); }
+    void item_totals(long long* out) const { ::item_totals(m, out); }
+};
+
+// reps x (one update + all store totals + all item totals); returns ns per rep.
+template <typename M>
+double run_loop(M& m, long long reps, long long& checksum) {
+    using Total = typename M::total_type;
+    std::vector<Total> st(m.stores()), it(m.items());
+    unsigned x = 241;
+    checksum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long long r = 0; r < reps; ++r) {
+        x = x * 1103515245u + 12345u;
+        int s = static_cast<int>((x >> 8) % static_cast<unsigned>(m.stores()));
+        int i = static_cast<int>((x >> 16) % static_cast<unsigned>(m.items()));
+        m.cell(s, i) += 1 + static_cast<int>(x & 7);
+        m.store_totals(st.data());
+        m.item_totals(it.data());
+        checksum += st[s] + it[i];
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / reps;
+}
+
+template <int Stores, int Items>
+bool run_shape(long long cells_touched) {
+    long long reps = cells_touched / (Stores * Items);
+    if (reps < 1) reps = 1;
+
+    static ledger::StockMatrix<Stores, Items> fixed; // static: large shapes would not fit on the stack
+    ledger::DynamicStockMatrix<> dynamic;
+    LabMatrix lab;
+    if (!fixed.create(Stores, Items) || !dynamic.create(Stores, Items) || !lab.create(Stores, Items)) return false;
+
+    long long c_fixed, c_dynamic, c_lab;
+    double ns_fixed = run_loop(fixed, reps, c_fixed);
+    double ns_dynamic = run_loop(dynamic, reps, c_dynamic);
+    double ns_lab = run_loop(lab, reps, c_lab);
+
+    std::cout << std::setw(5) << Stores << " x " << std::left << std::setw(5) << Items << std::right
+              << std::setw(11) << reps << std::setprecision(1) << std::setw(12) << ns_fixed << std::setw(12)
+              << ns_dynamic << std::setw(12) << ns_lab << std::setprecision(2) << std::setw(10)
+              << ns_dynamic / ns_fixed << "x\n";
+    return c_fixed == c_dynamic && c_fixed == c_lab;
+}
+
+int main(int argc, char* argv[]) {
+    long long cells = (argc > 1 ? std::stoll(argv[1]) : 400) * 1000000LL;
+
+    std::cout << std::fixed << "sizeof(ledger::StockMatrix<10, 5>) = " << sizeof(ledger::StockMatrix<10, 5>)
+              << " bytes (the cells, nothing else)\n"
+              << "shape              reps    fixed ns  dynamic ns      lab ns   speedup\n";
+    bool ok = run_shape<10, 5>(cells);
+    ok = run_shape<8, 16>(cells) && ok;
+    ok = run_shape<64, 64>(cells) && ok;
+    ok = run_shape<200, 50>(cells) && ok;
+    ok = run_shape<256, 1000>(cells) && ok;
+    std::cout << "(ns per update + all store and item totals; speedup = dynamic / fixed)\n"
+              << (ok ? "results match\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,294 @@
+// CENG241 - Benchmark suite for every ledger operation (Google Benchmark)
+// ----------------------------------------------------------------------
+// The hand-written bench_*.cpp programs answer one question each. This
+// suite times every basic operation over sizes 1e3, 1e4, ... up to
+// LEDGER_BENCH_MAX_SIZE (1e8 by default) so a regression in any of them
+// shows up in a per-commit comparison:
+//
+//   Inventory:   append growth, insert_at / delete_at at head, middle and
+//                tail, find hit / miss, sort_asc, reverse, stats
+//   StockMatrix: item_totals / store_totals in both layouts
+//   Pricing:     bulk_mul_add / bulk_divide (bulk_arithmetic.hpp)
+//
+// Build & Run (see CMakeLists.txt):
+//   cmake --build build --target bench_json        -> build/ledger_benchmarks.json
+//   ./build/lab/ledger_benchmarks --benchmark_filter=Find
+// Two JSON files can be compared with benchmark's tools/compare.py.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "251009/inventory.hpp"
+#include "stock_matrix.hpp"
+#include "bulk_arithmetic.hpp"
+
+#ifndef LEDGER_BENCH_MAX_SIZE
+#define LEDGER_BENCH_MAX_SIZE 100000000
+#endif
+
+const long long SMALLEST_SIZE = 1000;
+
+// Operations run this many times between two O(1) size resets, so the
+// ledger stays at n elements without pausing the timer.
+const int EDITS_PER_RESET = 64;
+
+enum EditPosition { HEAD, MIDDLE, TAIL };
+
+// Random stock values in [0, 1e6); the same seed for every size.
+std::vector<int> random_stock(long long n) {
+    std::vector<int> v(static_cast<size_t>(n));
+    std::mt19937 rng(241);
+    for (int& x : v) x = static_cast<int>(rng() % 1000000);
+    return v;
+}
+
+// A ledger holding n random values, with room for EDITS_PER_RESET more.
+bool filled_inventory(Inventory& inv, long long n) {
+    inv = Inventory{nullptr, 0, 0};
+    if (!create(inv, static_cast<int>(n) + EDITS_PER_RESET)) return false;
+    std::vector<int> v = random_stock(n);
+    std::memcpy(inv.data, v.data(), v.size() * sizeof(int));
+    inv.size = static_cast<int>(n);
+    return true;
+}
+
+int edit_index(const Inventory& inv, EditPosition where, bool inserting) {
+    if (where == HEAD) return 0;
+    if (where == MIDDLE) return inv.size / 2;
+    return inserting ? inv.size : inv.size - 1;
+}
+
+void set_elements(benchmark::State& state, long long per_iteration) {
+    state.SetItemsProcessed(static_cast<long long>(state.iterations()) * per_iteration);
+}
+
+// --- Inventory -----------------------------------------------------------
+
+// Append n values to a ledger that starts with capacity 1 (all doublings).
+void BM_AppendGrowth(benchmark::State& state) {
+    const long long n = state.range(0);
+    for (auto _ : state) {
+        Inventory inv{nullptr, 0, 0};
+        create(inv, 1);
+        for (long long i = 0; i < n; ++i) append(inv, static_cast<int>(i));
+        benchmark::DoNotOptimize(inv.data);
+        destroy(inv);
+    }
+    set_elements(state, n);
+}
+
+// One insert_at per iteration. Every EDITS_PER_RESET inserts the size is
+// put back to n (O(1); the values do not matter for the timing).
+void BM_InsertAt(benchmark::State& state, EditPosition where) {
+    const long long n = state.range(0);
+    Inventory inv;
+    if (!filled_inventory(inv, n)) {
+        state.SkipWithError("ledger allocation failed");
+        return;
+    }
+    int done = 0;
+    for (auto _ : state) {
+        insert_at(inv, edit_index(inv, where, true), 7);
+        if (++done == EDITS_PER_RESET) {
+            inv.size = static_cast<int>(n);
+            done = 0;
+        }
+    }
+    benchmark::DoNotOptimize(inv.data);
+    destroy(inv);
+    set_elements(state, 1);
+}
+
+void BM_DeleteAt(benchmark::State& state, EditPosition where) {
+    const long long n = state.range(0);
+    Inventory inv;
+    if (!filled_inventory(inv, n)) {
+        state.SkipWithError("ledger allocation failed");
+        return;
+    }
+    int done = 0;
+    for (auto _ : state) {
+        delete_at(inv, edit_index(inv, where, false));
+        if (++done == EDITS_PER_RESET) {
+            inv.size = static_cast<int>(n); // the slots past size still hold values
+            done = 0;
+        }
+    }
+    benchmark::DoNotOptimize(inv.data);
+    destroy(inv);
+    set_elements(state, 1);
+}
+
+// Hit: the target sits in the middle. Miss: scans everything.
+void BM_Find(benchmark::State& state, bool hit) {
+    const long long n = state.range(0);
+    Inventory inv;
+    if (!filled_inventory(inv, n)) {
+        state.SkipWithError("ledger allocation failed");
+        return;
+    }
+    int target = -1; // stock values are never negative
+    if (hit) {
+        target = 1000000;
+        inv.data[inv.size / 2] = target;
+    }
+    for (auto _ : state) benchmark::DoNotOptimize(find(inv, target));
+    destroy(inv);
+    set_elements(state, hit ? n / 2 : n);
+}
+
+// Each iteration sorts a fresh unsorted copy; the copy is not timed.
+void BM_SortAsc(benchmark::State& state) {
+    const long long n = state.range(0);
+    Inventory inv;
+    if (!filled_inventory(inv, n)) {
+        state.SkipWithError("ledger allocation failed");
+        return;
+    }
+    std::vector<int> original(inv.data, inv.data + inv.size);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::memcpy(inv.data, original.data(), original.size() * sizeof(int));
+        state.ResumeTiming();
+        sort_asc(inv);
+        benchmark::ClobberMemory();
+    }
+    destroy(inv);
+    set_elements(state, n);
+}
+
+void BM_Reverse(benchmark::State& state) {
+    const long long n = state.range(0);
+    Inventory inv;
+    if (!filled_inventory(inv, n)) {
+        state.SkipWithError("ledger allocation failed");
+        return;
+    }
+    for (auto _ : state) {
+        reverse(inv);
+        benchmark::ClobberMemory();
+    }
+    destroy(inv);
+    set_elements(state, n);
+    state.SetBytesProcessed(static_cast<long long>(state.iterations()) * n * 2 * static_cast<long long>(sizeof(int)));
+}
+
+void BM_Stats(benchmark::State& state) {
+    const long long n = state.range(0);
+    Inventory inv;
+    if (!filled_inventory(inv, n)) {
+        state.SkipWithError("ledger allocation failed");
+        return;
+    }
+    int mn = 0, mx = 0;
+    double avg = 0;
+    for (auto _ : state) {
+        stats(inv, mn, mx, avg);
+        benchmark::DoNotOptimize(avg);
+    }
+    destroy(inv);
+    set_elements(state, n);
+    state.SetBytesProcessed(static_cast<long long>(state.iterations()) * n * static_cast<long long>(sizeof(int)));
+}
+
+// --- StockMatrix ---------------------------------------------------------
+
+// n cells as (n / 1000) stores x 1000 items.
+const int MATRIX_ITEMS = 1000;
+
+bool filled_matrix(StockMatrix& m, long long n, MatrixLayout layout) {
+    int stores = static_cast<int>(std::max(1LL, n / MATRIX_ITEMS));
+    if (!create_matrix(m, stores, MATRIX_ITEMS, layout)) return false;
+    std::mt19937 rng(241);
+    for (int s = 0; s < stores; ++s) {
+        for (int i = 0; i < MATRIX_ITEMS; ++i) cell(m, s, i) = static_cast<int>(rng() % 1000);
+    }
+    return true;
+}
+
+void BM_MatrixItemTotals(benchmark::State& state, MatrixLayout layout) {
+    StockMatrix m;
+    if (!filled_matrix(m, state.range(0), layout)) {
+        state.SkipWithError("matrix allocation failed");
+        return;
+    }
+    std::vector<long long> totals(static_cast<size_t>(m.items));
+    for (auto _ : state) {
+        item_totals(m, totals.data());
+        benchmark::DoNotOptimize(totals.data());
+    }
+    set_elements(state, static_cast<long long>(m.stores) * m.items);
+    destroy_matrix(m);
+}
+
+void BM_MatrixStoreTotals(benchmark::State& state, MatrixLayout layout) {
+    StockMatrix m;
+    if (!filled_matrix(m, state.range(0), layout)) {
+        state.SkipWithError("matrix allocation failed");
+        return;
+    }
+    std::vector<long long> totals(static_cast<size_t>(m.stores));
+    for (auto _ : state) {
+        store_totals(m, totals.data());
+        benchmark::DoNotOptimize(totals.data());
+    }
+    set_elements(state, static_cast<long long>(m.stores) * m.items);
+    destroy_matrix(m);
+}
+
+// --- Pricing (bulk_arithmetic.hpp) -------------------------------------------
+
+void BM_BulkMulAdd(benchmark::State& state) {
+    const long long n = state.range(0);
+    std::vector<int> a = random_stock(n), b = random_stock(n), c = random_stock(n);
+    std::vector<double> out(static_cast<size_t>(n));
+    for (auto _ : state) {
+        bulk_mul_add(a.data(), b.data(), c.data(), out.data(), out.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    set_elements(state, n);
+}
+
+// Every 16th divisor is zero.
+void BM_BulkDivide(benchmark::State& state) {
+    const long long n = state.range(0);
+    std::vector<int> a = random_stock(n), b = random_stock(n);
+    for (size_t i = 0; i < b.size(); i += 16) b[i] = 0;
+    std::vector<double> out(b.size());
+    std::vector<std::uint64_t> valid(bulk_mask_words(b.size()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bulk_divide(a.data(), b.data(), out.data(), valid.data(), out.size()));
+    }
+    set_elements(state, n);
+}
+
+// --- Registration ----------------------------------------------------------
+
+void sizes(benchmark::internal::Benchmark* b) {
+    for (long long n = SMALLEST_SIZE; n <= LEDGER_BENCH_MAX_SIZE; n *= 10) b->Arg(n);
+    b->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_AppendGrowth)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_InsertAt, head, HEAD)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_InsertAt, middle, MIDDLE)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_InsertAt, tail, TAIL)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_DeleteAt, head, HEAD)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_DeleteAt, middle, MIDDLE)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_DeleteAt, tail, TAIL)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_Find, hit, true)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_Find, miss, false)->Apply(sizes);
+BENCHMARK(BM_SortAsc)->Apply(sizes);
+BENCHMARK(BM_Reverse)->Apply(sizes);
+BENCHMARK(BM_Stats)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_MatrixItemTotals, row_major, MatrixLayout::RowMajor)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_MatrixItemTotals, col_major, MatrixLayout::ColMajor)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_MatrixStoreTotals, row_major, MatrixLayout::RowMajor)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_MatrixStoreTotals, col_major, MatrixLayout::ColMajor)->Apply(sizes);
+
+BENCHMARK(BM_BulkMulAdd)->Apply(sizes);
+BENCHMARK(BM_BulkDivide)->Apply(sizes);
+
+BENCHMARK_MAIN();
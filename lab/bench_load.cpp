@@ -0,0 +1,139 @@
+// CENG241 - Benchmark: iostream parsing vs the mmap + from_chars loader
+// --------------------------------------------------------------------
+// Writes N stock values (one per line, every 1,000,000th line malformed)
+// to a text file, then loads it
+//   istream  `file >> value` with clear()/ignore() recovery, like read_int
+//            in lab_1.cpp, appending into an Inventory
+//   loader   load_inventory() from ledger_loader.hpp
+// and a stores x items CSV with load_matrix(). Both loaders must find the
+// same values and the same bad lines.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread -I251009 bench_load.cpp -o bench_load
+// ./bench_load [N] [dir]      (default 10000000 values in /tmp)
+
+#include <iostream>
+#include <iomanip>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "ledger_loader.hpp"
+
+const std::size_t BAD_EVERY = 1000000;
+
+double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// One value per line; line k (1-based) with k % BAD_EVERY == 0 is "12x".
+bool write_values(const std::string& path, std::size_t n) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::mt19937 rng(241);
+    std::vector<char> buf;
+    buf.reserve(1 << 20);
+    char num[16];
+    for (std::size_t k = 1; k <= n; ++k) {
+        if (k % BAD_EVERY == 0) {
+            buf.insert(buf.end(), {'1', '2', 'x', '\n'});
+        } else {
+            char* e = std::to_chars(num, num + sizeof num, static_cast<int>(rng() % 1000000)).ptr;
+            buf.insert(buf.end(), num, e);
+            buf.push_back('\n');
+        }
+        if (buf.size() > (1 << 20) - 32) {
+            std::fwrite(buf.data(), 1, buf.size(), f);
+            buf.clear();
+        }
+    }
+    std::fwrite(buf.data(), 1, buf.size(), f);
+    return std::fclose(f) == 0;
+}
+
+bool write_matrix(const std::string& path, int stores, int items) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    for (int s = 0; s < stores; ++s) {
+        for (int i = 0; i < items; ++i) std::fprintf(f, i ? ",%d" : "%d", (s * 31 + i * 7) % 500);
+        std::fputc('\n', f);
+    }
+    std::fputs("1,2,oops\n", f); // one malformed store row at the end
+    return std::fclose(f) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = (argc > 1) ? std::stoull(argv[1]) : 10000000;
+    std::string dir = (argc > 2) ? argv[2] : "/tmp";
+    std::string values_path = dir + "/bench_load_values.txt";
+    std::string matrix_path = dir + "/bench_load_matrix.csv";
+    if (!write_values(values_path, n) || !write_matrix(matrix_path, 2000, 500)) {
+        std::cerr << "cannot write test files in " << dir << "\n";
+        return 1;
+    }
+
+    // istream, one value at a time.
+    Inventory slow{nullptr, 0, 0};
+    create(slow, 1);
+    std::size_t slow_bad = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        std::ifstream in(values_path);
+        int v;
+        while (true) {
+            if (in >> v) {
+                append(slow, v);
+            } else if (in.eof()) {
+                break;
+            } else {
+                in.clear();
+                in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                ++slow_bad;
+            }
+        }
+    }
+    double slow_s = seconds_since(t0);
+
+    Inventory fast{nullptr, 0, 0};
+    LoadReport report;
+    t0 = std::chrono::steady_clock::now();
+    bool ok = load_inventory(fast, values_path.c_str(), report);
+    double fast_s = seconds_since(t0);
+
+    // "12x" reads as 12 and then fails on 'x' for the stream; the loader
+    // drops the whole line. Compare everything except those 12s.
+    std::size_t j = 0;
+    for (int i = 0; ok && i < slow.size; ++i) {
+        if (slow.data[i] == 12 && (j >= static_cast<std::size_t>(fast.size) || fast.data[j] != 12)) continue;
+        ok = j < static_cast<std::size_t>(fast.size) && slow.data[i] == fast.data[j++];
+    }
+    ok = ok && j == static_cast<std::size_t>(fast.size) && report.bad_lines == n / BAD_EVERY &&
+         (report.bad_lines == 0 || report.bad_line_numbers[0] == BAD_EVERY);
+
+    std::cout << std::fixed << std::setprecision(2) << n << " values (" << report.bad_lines
+              << " malformed lines reported, " << bulk_kernels().name << ")\n"
+              << "istream " << std::setw(8) << slow_s << " s" << std::setw(10) << n / slow_s / 1e6 << " M values/s\n"
+              << "loader  " << std::setw(8) << fast_s << " s" << std::setw(10) << n / fast_s / 1e6 << " M values/s\n";
+    destroy(slow);
+    destroy(fast);
+
+    StockMatrix m;
+    t0 = std::chrono::steady_clock::now();
+    bool mok = load_matrix(m, matrix_path.c_str(), report);
+    double m_s = seconds_since(t0);
+    mok = mok && m.stores == 2001 && m.items == 500 && report.bad_lines == 1 &&
+          report.bad_line_numbers[0] == 2001 && cell(m, 1999, 499) == (1999 * 31 + 499 * 7) % 500 &&
+          cell(m, 2000, 0) == 0;
+    std::cout << "matrix  " << std::setw(8) << m_s << " s  " << m.stores << " x " << m.items << " ("
+              << report.bad_lines << " malformed row)\n";
+    if (mok) destroy_matrix(m);
+
+    std::remove(values_path.c_str());
+    std::remove(matrix_path.c_str());
+    std::cout << (ok && mok ? "results match\n" : "RESULTS DIFFER\n");
+    return ok && mok ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+// CENG241 - Benchmark: requests/s and latency of the stock-ledger server
+// ---------------------------------------------------------------------
+// Starts a LedgerServer (ledger_server.hpp) in this process and connects C
+// client threads to it. Each client keeps D requests in flight (pipelining:
+// a new one is sent for every answer) with a mix of 45% ADD_STOCK, 45%
+// REDUCE_STOCK and 10% GET_STOCK on random cells, and times every request
+// from send to answer. Two runs: D = depth (throughput) and D = 1 (one
+// request at a time: the round-trip latency).
+//
+// Checks: every answer is OK and matches a request; afterwards the stock
+// summed over SHOW_STORE answers equals units added - units removed (the
+// REDUCE answers say how many were removed); a few Inventory requests
+// (APPEND, FIND, STATS) give the expected values.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread -I251009 bench_server.cpp -o bench_server
+// ./bench_server [clients] [depth] [requests_per_client] [shards]   (default 4 32 200000 2)
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ledger_server.hpp"
+
+const char* const BENCH_SOCKET = "/tmp/ceng241_bench_ledger.sock";
+const int BENCH_STORES = 64;
+const int BENCH_ITEMS = 256;
+
+struct ClientResult {
+    bool ok = true;
+    long long added = 0;
+    long long removed = 0;
+    std::vector<std::uint32_t> latency_ns;
+};
+
+std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+// One recv(2) appended to buf; false on EOF / error.
+bool receive_some(int fd, std::string& buf) {
+    char chunk[1 << 16];
+    ssize_t r = ::recv(fd, chunk, sizeof chunk, 0);
+    if (r <= 0) return false;
+    buf.append(chunk, static_cast<std::size_t>(r));
+    return true;
+}
+
+void run_client(int client, int depth, int requests, ClientResult& res) {
+    int fd = connect_ledger(BENCH_SOCKET);
+    if (fd < 0) {
+        res.ok = false;
+        return;
+    }
+    std::mt19937 rng(241 + client);
+    std::vector<unsigned char> ops(requests);
+    std::vector<int> qty(requests);
+    std::vector<std::uint64_t> sent(requests);
+    res.latency_ns.reserve(requests);
+
+    std::string out, in;
+    int next = 0;
+    auto queue_request = [&](int id) {
+        unsigned r = rng() % 100;
+        ops[id] = r < 45 ? LOP_ADD_STOCK : r < 90 ? LOP_REDUCE_STOCK : LOP_GET_STOCK;
+        qty[id] = 1 + static_cast<int>(rng() % 10);
+        int store = static_cast<int>(rng() % BENCH_STORES);
+        int item = static_cast<int>(rng() % BENCH_ITEMS);
+        encode_request(out, static_cast<std::uint32_t>(id), ops[id], store, item, qty[id]);
+        sent[id] = now_ns();
+    };
+
+    while (next < requests && next < depth) queue_request(next++);
+    int answered = 0;
+    while (res.ok && answered < requests) {
+        if (!out.empty()) {
+            res.ok = send_all(fd, out.data(), out.size());
+            out.clear();
+        }
+        if (!res.ok || !receive_some(fd, in)) {
+            res.ok = false;
+            break;
+        }
+        std::size_t pos = 0, len;
+        while ((len = complete_frame(in.data() + pos, in.size() - pos)) > 0) {
+            LedgerResponse r;
+            decode_response(in.data() + pos, len, r);
+            pos += len;
+            std::uint64_t t = now_ns();
+            if (r.id >= static_cast<std::uint32_t>(requests) || r.status != LEDGER_OK) {
+                res.ok = false;
+                break;
+            }
+            res.latency_ns.push_back(static_cast<std::uint32_t>(std::min<std::uint64_t>(t - sent[r.id], UINT32_MAX)));
+            if (ops[r.id] == LOP_ADD_STOCK) res.added += qty[r.id];
+            if (ops[r.id] == LOP_REDUCE_STOCK) res.removed += response_value(r, 1);
+            ++answered;
+            if (next < requests) queue_request(next++);
+        }
+        in.erase(0, pos);
+    }
+    ::close(fd);
+}
+
+// Total stock in the matrix, from one SHOW_STORE per store.
+bool total_stock(long long& total) {
+    int fd = connect_ledger(BENCH_SOCKET);
+    if (fd < 0) return false;
+    std::string out, in;
+    for (int s = 0; s < BENCH_STORES; ++s) encode_request(out, static_cast<std::uint32_t>(s), LOP_SHOW_STORE, s);
+    bool ok = send_all(fd, out.data(), out.size());
+    total = 0;
+    int answered = 0;
+    while (ok && answered < BENCH_STORES) {
+        ok = receive_some(fd, in);
+        std::size_t pos = 0, len;
+        while (ok && (len = complete_frame(in.data() + pos, in.size() - pos)) > 0) {
+            LedgerResponse r;
+            decode_response(in.data() + pos, len, r);
+            pos += len;
+            ok = r.status == LEDGER_OK && r.count == BENCH_ITEMS;
+            for (int i = 0; ok && i < r.count; ++i) total += response_value(r, i);
+            ++answered;
+        }
+        in.erase(0, pos);
+    }
+    ::close(fd);
+    return ok;
+}
+
+// Send one request and wait for its answer (a plain blocking client).
+bool call(int fd, LedgerResponse& r, std::string& in, unsigned char op, int a = 0, int b = 0) {
+    std::string out;
+    encode_request(out, 7, op, a, b);
+    if (!send_all(fd, out.data(), out.size())) return false;
+    in.clear();
+    std::size_t len;
+    while ((len = complete_frame(in.data(), in.size())) == 0) {
+        if (!receive_some(fd, in)) return false;
+    }
+    decode_response(in.data(), len, r);
+    return r.id == 7;
+}
+
+bool check_inventory_ops() {
+    int fd = connect_ledger(BENCH_SOCKET);
+    if (fd < 0) return false;
+    std::string in;
+    LedgerResponse r;
+    bool ok = true;
+    for (int v : {40, 10, 25}) ok = ok && call(fd, r, in, LOP_APPEND, v) && r.status == LEDGER_OK;
+    ok = ok && call(fd, r, in, LOP_INSERT_AT, 1, 99) && response_value(r, 0) == 4; // 40 99 10 25
+    ok = ok && call(fd, r, in, LOP_FIND, 10) && response_value(r, 0) == 2;
+    ok = ok && call(fd, r, in, LOP_STATS) && r.count == 5 && response_value(r, 0) == 10 &&
+         response_value(r, 1) == 99 && response_value(r, 2) == 4 && response_value(r, 3) == 174;
+    ok = ok && call(fd, r, in, LOP_DELETE_AT, 9) && r.status == LEDGER_REJECTED;
+    ::close(fd);
+    return ok;
+}
+
+bool run(int clients, int depth, int requests, long long& added, long long& removed) {
+    std::vector<ClientResult> results(clients);
+    std::vector<std::thread> threads;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int c = 0; c < clients; ++c) threads.emplace_back(run_client, c, depth, requests, std::ref(results[c]));
+    for (std::thread& t : threads) t.join();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    bool ok = true;
+    std::vector<std::uint32_t> all;
+    for (const ClientResult& r : results) {
+        ok = ok && r.ok;
+        added += r.added;
+        removed += r.removed;
+        all.insert(all.end(), r.latency_ns.begin(), r.latency_ns.end());
+    }
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double q) { return all.empty() ? 0.0 : all[static_cast<std::size_t>(q * (all.size() - 1))] / 1000.0; };
+    std::cout << std::setw(7) << clients << std::setw(7) << depth << std::setw(12) << std::setprecision(0)
+              << all.size() / s << std::setw(10) << std::setprecision(1) << pct(0.50) << std::setw(10) << pct(0.99)
+              << std::setw(10) << pct(0.999) << "\n";
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    int clients = argc > 1 ? std::stoi(argv[1]) : 4;
+    int depth = argc > 2 ? std::stoi(argv[2]) : 32;
+    int requests = argc > 3 ? std::stoi(argv[3]) : 200000;
+    int shards = argc > 4 ? std::stoi(argv[4]) : 2;
+
+    LedgerServer server;
+    if (!server.start(BENCH_SOCKET, BENCH_STORES, BENCH_ITEMS, shards)) {
+        std::cerr << "cannot start the server on " << BENCH_SOCKET << "\n";
+        return 1;
+    }
+    std::cout << std::fixed << shards << " shards, " << BENCH_STORES << " x " << BENCH_ITEMS << " cells, "
+              << requests << " requests per client\n"
+              << "clients  depth   requests/s   p50 us    p99 us  p99.9 us\n";
+    long long added = 0, removed = 0;
+    bool ok = run(clients, depth, requests, added, removed);
+    ok = run(clients, 1, requests / 10, added, removed) && ok;
+
+    long long total = 0;
+    ok = total_stock(total) && total == added - removed && ok;
+    ok = check_inventory_ops() && ok;
+    server.stop();
+    std::cout << (ok ? "results match\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+// CENG241 - Benchmark: reports during sales, with a lock vs with snapshots
+// -----------------------------------------------------------------------
+// One writer thread (the sales path) changes the data while one reporting
+// thread produces full reports back to back:
+//
+//   table   writer: random add_stock / reduce_stock on a stores x items table
+//           report: every store's total
+//   ledger  writer: random insert_at / delete_at on a ledger of N products
+//           report: min / max / sum, then the median of a copy
+//
+//   locked     StockMatrix / Inventory behind one std::mutex; a report holds
+//              it for its whole scan
+//   snapshots  VersionedStockMatrix / VersionedInventory
+//              (stock_matrix_snapshot.hpp, 251009/inventory_snapshot.hpp);
+//              a report takes an O(1) snapshot and scans it without the lock
+//
+// For each it prints the writer's rate alone and next to the reporter, the
+// reports finished per second, and the writer's slowest operations. Checks: both
+// methods end with the same data, and every snapshot report's total equals
+// the writer's running total at that snapshot's version.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread -I251009 bench_snapshot.cpp -o bench_snapshot
+// ./bench_snapshot [sales] [ledger_edits] [ledger_size]   (default 2000000 50000 200000)
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "inventory.hpp"
+#include "inventory_snapshot.hpp"
+#include "stock_matrix.hpp"
+#include "stock_matrix_snapshot.hpp"
+
+const int BENCH_STORES = 1000;
+const int BENCH_ITEMS = 1000;
+
+struct WriterTimes {
+    double ops_per_s;
+    double p999_us;
+    double max_us;
+};
+
+// Run op(k) for k = 0 .. ops-1 and time every call.
+template <typename Op>
+WriterTimes time_writer(int ops, Op op) {
+    std::vector<std::uint32_t> ns(ops);
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < ops; ++k) {
+        auto t0 = std::chrono::steady_clock::now();
+        op(k);
+        ns[k] = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count());
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::sort(ns.begin(), ns.end());
+    return WriterTimes{ops / s, ns[static_cast<std::size_t>(0.999 * (ops - 1))] / 1000.0, ns.back() / 1000.0};
+}
+
+// Time the writer while 'report' runs back to back on another thread.
+template <typename Op, typename Report>
+WriterTimes time_with_reports(int ops, Op op, Report report, long long& reports) {
+    std::atomic<bool> done{false};
+    reports = 0;
+    std::thread reporter([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            report();
+            ++reports;
+        }
+    });
+    WriterTimes t = time_writer(ops, op);
+    done = true;
+    reporter.join();
+    return t;
+}
+
+void print_row(const char* name, int ops, const WriterTimes& alone, const WriterTimes& shared, long long reports) {
+    std::cout << std::left << std::setw(11) << name << std::right << std::setw(14) << std::setprecision(0)
+              << alone.ops_per_s << std::setw(14) << shared.ops_per_s << std::setw(11) << std::setprecision(1)
+              << reports * shared.ops_per_s / ops
+              << std::setw(12) << std::setprecision(1) << shared.p999_us << std::setw(11) << shared.max_us << "\n";
+}
+
+void print_header() {
+    std::cout << "             ops/s alone  with reports  reports/s  p99.9 us    max us\n";
+}
+
+// One random sale: store, item, qty, add or reduce.
+struct Sale {
+    int store, item, qty;
+    bool add;
+};
+
+bool bench_table(int sales) {
+    std::mt19937 rng(241);
+    std::vector<Sale> plan(sales);
+    for (Sale& s : plan) {
+        s.store = static_cast<int>(rng() % BENCH_STORES);
+        s.item = static_cast<int>(rng() % BENCH_ITEMS);
+        s.qty = 1 + static_cast<int>(rng() % 10);
+        s.add = rng() % 2 == 0;
+    }
+    std::cout << "table: " << BENCH_STORES << " x " << BENCH_ITEMS << " cells, " << sales
+              << " sales, report = every store's total\n";
+    print_header();
+    std::vector<long long> totals(BENCH_STORES);
+
+    // Locked: the report holds the mutex for the whole scan.
+    StockMatrix m;
+    std::mutex mu;
+    auto locked_sale = [&](int k) {
+        const Sale& s = plan[k];
+        std::lock_guard<std::mutex> guard(mu);
+        int& c = cell(m, s.store, s.item);
+        c = s.add ? c + s.qty : std::max(0, c - s.qty);
+    };
+    auto locked_report = [&] {
+        std::lock_guard<std::mutex> guard(mu);
+        store_totals(m, totals.data());
+    };
+    if (!create_matrix(m, BENCH_STORES, BENCH_ITEMS)) return false;
+    WriterTimes alone = time_writer(sales, locked_sale);
+    destroy_matrix(m);
+    if (!create_matrix(m, BENCH_STORES, BENCH_ITEMS)) return false;
+    long long reports;
+    WriterTimes shared = time_with_reports(sales, locked_sale, locked_report, reports);
+    print_row("locked", sales, alone, shared, reports);
+
+    // Snapshots: the writer logs its running total after every sale; each
+    // report remembers (version, total) and is checked afterwards.
+    VersionedStockMatrix vm;
+    std::vector<long long> total_at(sales + 1, 0);
+    long long running = 0;
+    auto versioned_sale = [&](int k) {
+        const Sale& s = plan[k];
+        if (s.add) {
+            add_stock(vm, s.store, s.item, s.qty);
+            running += s.qty;
+        } else {
+            int removed;
+            reduce_stock(vm, s.store, s.item, s.qty, removed);
+            running -= removed;
+        }
+        total_at[k + 1] = running;
+    };
+    std::vector<std::pair<unsigned long long, long long>> seen;
+    auto versioned_report = [&] {
+        StockSnapshot snap = snapshot(vm);
+        store_totals(snap, totals.data());
+        long long total = 0;
+        for (long long t : totals) total += t;
+        seen.emplace_back(snapshot_version(snap), total);
+    };
+    create_versioned_matrix(vm, BENCH_STORES, BENCH_ITEMS);
+    alone = time_writer(sales, versioned_sale);
+    create_versioned_matrix(vm, BENCH_STORES, BENCH_ITEMS);
+    running = 0;
+    shared = time_with_reports(sales, versioned_sale, versioned_report, reports);
+    print_row("snapshots", sales, alone, shared, reports);
+
+    bool ok = true;
+    for (const auto& v : seen) ok = ok && v.first <= static_cast<unsigned long long>(sales) && v.second == total_at[v.first];
+    StockSnapshot last = snapshot(vm);
+    for (int s = 0; ok && s < BENCH_STORES; ++s) {
+        for (int i = 0; i < BENCH_ITEMS; ++i) ok = ok && cell(last, s, i) == cell(m, s, i);
+    }
+    destroy_matrix(m);
+    return ok;
+}
+
+// One random ledger edit; 'where' is scaled to the current size.
+struct Edit {
+    unsigned where;
+    int value;
+    bool insert;
+};
+
+// The scan part of a ledger report: min / max / sum of [data, data + n),
+// and a copy for the median.
+void report_block(const int* data, int n, std::vector<int>& copy, long long& sum) {
+    MinMaxSum r = inventory_kernels().minmaxsum(data, n);
+    sum += r.sum;
+    copy.insert(copy.end(), data, data + n);
+}
+
+void median_of(std::vector<int>& copy) {
+    if (!copy.empty()) std::nth_element(copy.begin(), copy.begin() + copy.size() / 2, copy.end());
+}
+
+bool bench_ledger(int edits, int n) {
+    std::mt19937 rng(2410);
+    std::vector<int> start(n);
+    for (int& v : start) v = static_cast<int>(rng() % 1000);
+    std::vector<Edit> plan(edits);
+    for (Edit& e : plan) {
+        e.where = rng();
+        e.value = static_cast<int>(rng() % 1000);
+        e.insert = rng() % 2 == 0;
+    }
+    std::cout << "\nledger: " << n << " products, " << edits
+              << " random insert_at / delete_at, report = min / max / sum + median\n";
+    print_header();
+    std::vector<int> copy;
+    copy.reserve(n + edits);
+
+    // Locked: scan and copy under the mutex, the median after unlocking.
+    Inventory inv{};
+    std::mutex mu;
+    auto locked_edit = [&](int k) {
+        const Edit& e = plan[k];
+        std::lock_guard<std::mutex> guard(mu);
+        if (e.insert || inv.size == 0) insert_at(inv, static_cast<int>(e.where % (inv.size + 1)), e.value);
+        else delete_at(inv, static_cast<int>(e.where % inv.size));
+    };
+    auto locked_report = [&] {
+        copy.clear();
+        long long sum = 0;
+        {
+            std::lock_guard<std::mutex> guard(mu);
+            if (inv.size > 0) report_block(inv.data, inv.size, copy, sum);
+        }
+        median_of(copy);
+    };
+    auto fill_locked = [&] {
+        destroy(inv);
+        create(inv, n + edits);
+        for (int v : start) append(inv, v);
+    };
+    fill_locked();
+    WriterTimes alone = time_writer(edits, locked_edit);
+    fill_locked();
+    long long reports;
+    WriterTimes shared = time_with_reports(edits, locked_edit, locked_report, reports);
+    print_row("locked", edits, alone, shared, reports);
+
+    VersionedInventory v;
+    std::vector<long long> sum_at(edits + 1, 0);
+    long long running = 0, base_version = 0;
+    int size = 0;
+    auto versioned_edit = [&](int k) {
+        const Edit& e = plan[k];
+        if (e.insert || size == 0) {
+            insert_at(v, static_cast<int>(e.where % (size + 1)), e.value);
+            running += e.value;
+            ++size;
+        } else {
+            int index = static_cast<int>(e.where % size), old = 0;
+            get(v, index, old);
+            delete_at(v, index);
+            running -= old;
+            --size;
+        }
+        sum_at[k + 1] = running;
+    };
+    std::vector<std::pair<unsigned long long, long long>> seen;
+    auto versioned_report = [&] {
+        InventorySnapshot snap = snapshot(v);
+        copy.clear();
+        long long sum = 0;
+        for (const CowChunkRef& chunk : snap.dir->chunks) report_block(chunk->items, chunk->count, copy, sum);
+        median_of(copy);
+        seen.emplace_back(snapshot_version(snap), sum);
+    };
+    auto fill_versioned = [&] {
+        create(v);
+        running = 0;
+        for (int x : start) {
+            append(v, x);
+            running += x;
+        }
+        size = n;
+        base_version = static_cast<long long>(snapshot_version(snapshot(v)));
+        sum_at[0] = running;
+    };
+    fill_versioned();
+    alone = time_writer(edits, versioned_edit);
+    fill_versioned();
+    shared = time_with_reports(edits, versioned_edit, versioned_report, reports);
+    print_row("snapshots", edits, alone, shared, reports);
+
+    bool ok = true;
+    for (const auto& s : seen) {
+        long long k = static_cast<long long>(s.first) - base_version;
+        ok = ok && k >= 0 && k <= edits && s.second == sum_at[k];
+    }
+    InventorySnapshot last = snapshot(v);
+    ok = ok && snapshot_size(last) == inv.size;
+    for (int i = 0; ok && i < inv.size; ++i) ok = get(last, i) == inv.data[i];
+    destroy(inv);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    int sales = argc > 1 ? std::stoi(argv[1]) : 2000000;
+    int edits = argc > 2 ? std::stoi(argv[2]) : 50000;
+    int n = argc > 3 ? std::stoi(argv[3]) : 200000;
+
+    std::cout << std::fixed;
+    bool ok = bench_table(sales);
+    ok = bench_ledger(edits, n) && ok;
+    std::cout << (ok ? "results match\n" : "RESULTS DIFFER\n");
+    return ok ? 0 : 1;
+}
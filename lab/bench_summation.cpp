@@ -0,0 +1,114 @@
+// CENG241 - Benchmark: accuracy vs speed of the summation modes
+// --------------------------------------------------------------
+// Sums two data sets, as float and as double, with every mode from
+// compensated_sum.hpp and prints the relative error against a long double
+// reference, and the throughput:
+//   tenths  0.1 repeated N times (float_vs_double_demo.cpp's loop)
+//   prices  N prices between 0.01 and 10000 with two decimals, plus one
+//           large transfer of 1e9 every 100000 values
+// It also checks that parallel_accurate_sum gives the same bits as
+// accurate_sum for 1 ... threads threads.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread -I251009 bench_summation.cpp -o bench_summation
+// ./bench_summation [N] [threads]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "compensated_sum.hpp"
+
+// Reference: Neumaier in long double (64-bit mantissa on x86).
+template <typename T>
+long double reference_sum(const std::vector<T>& x) {
+    long double s = 0, c = 0;
+    for (T v : x) neumaier_add(s, c, static_cast<long double>(v));
+    return s + c;
+}
+
+struct Result {
+    double error;  // relative
+    double mps;    // million values per second
+};
+
+template <typename T, typename Fn>
+Result measure(const std::vector<T>& x, long double ref, Fn sum) {
+    auto t0 = std::chrono::steady_clock::now();
+    long double got = sum(x.data(), x.size());
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return Result{static_cast<double>(std::fabs((got - ref) / ref)), x.size() / s / 1e6};
+}
+
+void print_row(const char* mode, const Result* f, const Result* d) {
+    std::cout << std::left << std::setw(10) << mode << std::right;
+    for (const Result* r : {f, d}) {
+        if (!r) {
+            std::cout << std::setw(12) << "-" << std::setw(10) << "-";
+            continue;
+        }
+        std::cout << std::scientific << std::setprecision(2) << std::setw(12) << r->error << std::fixed
+                  << std::setprecision(0) << std::setw(10) << r->mps;
+    }
+    std::cout << "\n";
+}
+
+bool run_set(const char* name, const std::vector<double>& values, ThreadPool& pool) {
+    std::vector<float> fvalues(values.begin(), values.end());
+    long double fref = reference_sum(fvalues), dref = reference_sum(values);
+
+    std::cout << "\n" << name << " (" << values.size() << " values)\n"
+              << std::left << std::setw(10) << "mode" << std::right << std::setw(12) << "float err"
+              << std::setw(10) << "M/s" << std::setw(12) << "double err" << std::setw(10) << "M/s" << "\n";
+
+    Result f, d;
+#define BENCH_MODE(label, fn)                                            \
+    f = measure(fvalues, fref, [](const float* x, std::size_t n) { return fn(x, n); });  \
+    d = measure(values, dref, [](const double* x, std::size_t n) { return fn(x, n); }); \
+    print_row(label, &f, &d);
+    BENCH_MODE("naive", sum_naive)
+    BENCH_MODE("kahan", sum_kahan)
+    BENCH_MODE("pairwise", sum_pairwise)
+    BENCH_MODE("neumaier", sum_neumaier)
+    BENCH_MODE("accurate", accurate_sum)
+#undef BENCH_MODE
+    f = measure(fvalues, fref, [&](const float* x, std::size_t n) { return parallel_accurate_sum(pool, x, n); });
+    d = measure(values, dref, [&](const double* x, std::size_t n) { return parallel_accurate_sum(pool, x, n); });
+    print_row("parallel", &f, &d);
+    f = measure(fvalues, fref, sum_widened);
+    print_row("widened", &f, nullptr);
+
+    // Same bits for every thread count.
+    bool same = true;
+    double expect = accurate_sum(values.data(), values.size());
+    float expect_f = accurate_sum(fvalues.data(), fvalues.size());
+    for (int t = 1; t <= pool.size(); ++t) {
+        ThreadPool p(t);
+        same = same && parallel_accurate_sum(p, values.data(), values.size()) == expect &&
+               parallel_accurate_sum(p, fvalues.data(), fvalues.size()) == expect_f;
+    }
+    std::cout << "parallel_accurate_sum, 1.." << pool.size() << " threads: "
+              << (same ? "identical" : "DIFFERENT") << "\n";
+    return same;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = (argc > 1) ? std::stoull(argv[1]) : 10000000;
+    int threads = (argc > 2) ? std::stoi(argv[2]) : 4;
+    ThreadPool pool(threads);
+    std::cout << bulk_kernels().name << " kernels, " << pool.size() << " thread(s)\n";
+
+    std::vector<double> tenths(n, 0.1);
+    std::vector<double> prices(n);
+    std::mt19937 rng(241);
+    for (std::size_t i = 0; i < n; ++i) {
+        prices[i] = (i % 100000 == 99999) ? 1e9 : static_cast<double>(1 + rng() % 1000000) / 100.0;
+    }
+
+    bool ok = run_set("tenths", tenths, pool);
+    ok = run_set("prices", prices, pool) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+// CENG241 - Bulk add/sub/mul/divide over whole arrays (SIMD + threads)
+// --------------------------------------------------------------------
+// week1_task1.cpp's add/sub/mul/divide handle ONE pair of ints per call.
+// Pricing millions of (quantity, unit price) pairs that way pays a function
+// call, two int->double conversions and (for divide) a branch per pair.
+// The bulk versions here take whole arrays:
+//
+//   bulk_add(a, b, out, n)          out[i] = a[i] + b[i]
+//   bulk_sub(a, b, out, n)          out[i] = a[i] - b[i]
+//   bulk_mul(a, b, out, n)          out[i] = a[i] * b[i]
+//   bulk_mul_add(a, b, c, out, n)   out[i] = a[i] * b[i] + c[i]   (one pass)
+//   bulk_divide(a, b, out, valid, n)
+//
+// All results are doubles, exactly as in week1_task1 (convert, then compute).
+//
+// Divide by zero: instead of one bool per call, bulk_divide writes a bit
+// mask: bit i of valid[i / 64] is 1 if out[i] is a real quotient and 0 if
+// b[i] was zero (out[i] is then 0.0). It returns the number of zero
+// divisors, so the common "none" case needs no mask scan at all.
+//
+// Fused: a*b + c as one loop reads every input once and writes once; three
+// separate bulk calls would stream the arrays through memory three times.
+// It uses fused multiply-add (one rounding, std::fma), in every flavour.
+//
+// Like inventory_kernels.hpp, every kernel has a scalar version and an AVX2
+// version (4 doubles per instruction) picked once at runtime; set
+// BULK_SIMD=scalar to force the scalar one. The parallel_bulk_* functions
+// split very large arrays over a ThreadPool (251009/inventory_parallel.hpp).
+
+#ifndef CENG241_BULK_ARITHMETIC_HPP
+#define CENG241_BULK_ARITHMETIC_HPP
+
+#include <algorithm> // std::min
+#include <atomic>
+#include <cmath>   // std::fma
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib> // std::getenv
+#include <cstring> // std::strcmp, std::memset
+#include "251009/inventory_parallel.hpp" // ThreadPool
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BULK_ARITHMETIC_X86 1
+#include <immintrin.h>
+#else
+#define BULK_ARITHMETIC_X86 0
+#endif
+
+// Words needed for the divide mask of n elements.
+inline std::size_t bulk_mask_words(std::size_t n) {
+    return (n + 63) / 64;
+}
+
+inline bool bulk_mask_valid(const std::uint64_t* valid, std::size_t i) {
+    return (valid[i / 64] >> (i % 64)) & 1;
+}
+
+// --- Scalar ----------------------------------------------------------------
+
+inline void bulk_add_scalar(const int* a, const int* b, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = static_cast<double>(a[i]) + static_cast<double>(b[i]);
+}
+
+inline void bulk_sub_scalar(const int* a, const int* b, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = static_cast<double>(a[i]) - static_cast<double>(b[i]);
+}
+
+inline void bulk_mul_scalar(const int* a, const int* b, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = static_cast<double>(a[i]) * static_cast<double>(b[i]);
+}
+
+inline void bulk_mul_add_scalar(const int* a, const int* b, const int* c, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = std::fma(static_cast<double>(a[i]), static_cast<double>(b[i]), static_cast<double>(c[i]));
+    }
+}
+
+// 'valid' must be zeroed by the caller (bulk_divide does it); bits are ORed in.
+inline std::size_t bulk_divide_scalar(const int* a, const int* b, double* out, std::uint64_t* valid, std::size_t n) {
+    std::size_t zeros = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        bool ok = b[i] != 0;
+        // Divide by 1 instead of 0 and throw the result away: no branch.
+        double q = static_cast<double>(a[i]) / static_cast<double>(ok ? b[i] : 1);
+        out[i] = ok ? q : 0.0;
+        valid[i / 64] |= static_cast<std::uint64_t>(ok) << (i % 64);
+        zeros += !ok;
+    }
+    return zeros;
+}
+
+#if BULK_ARITHMETIC_X86
+
+// --- AVX2 (4 doubles per register) -------------------------------------------
+
+__attribute__((target("avx2")))
+inline __m256d load4_as_double(const int* p) {
+    return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+__attribute__((target("avx2")))
+inline void bulk_add_avx2(const int* a, const int* b, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_add_pd(load4_as_double(a + i), load4_as_double(b + i)));
+    bulk_add_scalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline void bulk_sub_avx2(const int* a, const int* b, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_sub_pd(load4_as_double(a + i), load4_as_double(b + i)));
+    bulk_sub_scalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline void bulk_mul_avx2(const int* a, const int* b, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(load4_as_double(a + i), load4_as_double(b + i)));
+    bulk_mul_scalar(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+inline void bulk_mul_add_avx2(const int* a, const int* b, const int* c, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, _mm256_fmadd_pd(load4_as_double(a + i), load4_as_double(b + i), load4_as_double(c + i)));
+    }
+    bulk_mul_add_scalar(a + i, b + i, c + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t bulk_divide_avx2(const int* a, const int* b, double* out, std::uint64_t* valid, std::size_t n) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    std::size_t zeros = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = load4_as_double(a + i);
+        __m256d vb = load4_as_double(b + i);
+        __m256d is_zero = _mm256_cmp_pd(vb, zero, _CMP_EQ_OQ);
+        // Lanes with b == 0 divide by 1 (no inf/NaN), then get 0.0.
+        __m256d q = _mm256_div_pd(va, _mm256_blendv_pd(vb, one, is_zero));
+        _mm256_storeu_pd(out + i, _mm256_blendv_pd(q, zero, is_zero));
+        int bad = _mm256_movemask_pd(is_zero); // 4 bits, 1 = zero divisor
+        valid[i / 64] |= static_cast<std::uint64_t>(~bad & 0xF) << (i % 64);
+        zeros += static_cast<std::size_t>(__builtin_popcount(bad));
+    }
+    // i is a multiple of 4, so the tail's bits land in the right word.
+    for (; i < n; ++i) {
+        bool ok = b[i] != 0;
+        out[i] = ok ? static_cast<double>(a[i]) / static_cast<double>(b[i]) : 0.0;
+        valid[i / 64] |= static_cast<std::uint64_t>(ok) << (i % 64);
+        zeros += !ok;
+    }
+    return zeros;
+}
+
+#endif // BULK_ARITHMETIC_X86
+
+// --- Runtime dispatch ----------------------------------------------------------
+
+struct BulkKernels {
+    const char* name;
+    void (*add)(const int*, const int*, double*, std::size_t);
+    void (*sub)(const int*, const int*, double*, std::size_t);
+    void (*mul)(const int*, const int*, double*, std::size_t);
+    void (*mul_add)(const int*, const int*, const int*, double*, std::size_t);
+    std::size_t (*divide)(const int*, const int*, double*, std::uint64_t*, std::size_t);
+};
+
+inline BulkKernels select_bulk_kernels() {
+    BulkKernels scalar{"scalar", bulk_add_scalar, bulk_sub_scalar, bulk_mul_scalar, bulk_mul_add_scalar,
+                       bulk_divide_scalar};
+#if BULK_ARITHMETIC_X86
+    __builtin_cpu_init();
+    const char* forced = std::getenv("BULK_SIMD");
+    if (forced && std::strcmp(forced, "scalar") == 0) return scalar;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return BulkKernels{"avx2", bulk_add_avx2, bulk_sub_avx2, bulk_mul_avx2, bulk_mul_add_avx2, bulk_divide_avx2};
+    }
+#endif
+    return scalar;
+}
+
+inline const BulkKernels& bulk_kernels() {
+    static const BulkKernels k = select_bulk_kernels();
+    return k;
+}
+
+// --- Public API (single thread) --------------------------------------------------
+
+inline void bulk_add(const int* a, const int* b, double* out, std::size_t n) { bulk_kernels().add(a, b, out, n); }
+inline void bulk_sub(const int* a, const int* b, double* out, std::size_t n) { bulk_kernels().sub(a, b, out, n); }
+inline void bulk_mul(const int* a, const int* b, double* out, std::size_t n) { bulk_kernels().mul(a, b, out, n); }
+
+inline void bulk_mul_add(const int* a, const int* b, const int* c, double* out, std::size_t n) {
+    bulk_kernels().mul_add(a, b, c, out, n);
+}
+
+// 'valid' holds bulk_mask_words(n) words. Returns how many b[i] were zero.
+inline std::size_t bulk_divide(const int* a, const int* b, double* out, std::uint64_t* valid, std::size_t n) {
+    std::memset(valid, 0, bulk_mask_words(n) * sizeof(std::uint64_t));
+    return bulk_kernels().divide(a, b, out, valid, n);
+}
+
+// --- Multi-threaded ----------------------------------------------------------------
+
+// Below this many elements one core is faster than waking the pool.
+const std::size_t PARALLEL_BULK_MIN_ELEMENTS = 1 << 18;
+
+// Run fn(begin, end) over [0, n) in blocks. Block borders are multiples of
+// 64, so no two threads ever write the same divide-mask word.
+template <typename Fn>
+void parallel_bulk_blocks(ThreadPool& pool, std::size_t n, Fn fn) {
+    if (n < PARALLEL_BULK_MIN_ELEMENTS || pool.size() == 1) {
+        fn(0, n);
+        return;
+    }
+    const int parts = pool.size() * 4;
+    std::size_t words = bulk_mask_words(n);
+    pool.run(parts, [&](int t) {
+        std::size_t begin = std::min(n, words * t / parts * 64);
+        std::size_t end = std::min(n, words * (t + 1) / parts * 64);
+        if (begin < end) fn(begin, end);
+    });
+}
+
+inline void parallel_bulk_add(ThreadPool& pool, const int* a, const int* b, double* out, std::size_t n) {
+    parallel_bulk_blocks(pool, n, [&](std::size_t s, std::size_t e) { bulk_add(a + s, b + s, out + s, e - s); });
+}
+
+inline void parallel_bulk_sub(ThreadPool& pool, const int* a, const int* b, double* out, std::size_t n) {
+    parallel_bulk_blocks(pool, n, [&](std::size_t s, std::size_t e) { bulk_sub(a + s, b + s, out + s, e - s); });
+}
+
+inline void parallel_bulk_mul(ThreadPool& pool, const int* a, const int* b, double* out, std::size_t n) {
+    parallel_bulk_blocks(pool, n, [&](std::size_t s, std::size_t e) { bulk_mul(a + s, b + s, out + s, e - s); });
+}
+
+inline void parallel_bulk_mul_add(ThreadPool& pool, const int* a, const int* b, const int* c, double* out, std::size_t n) {
+    parallel_bulk_blocks(pool, n, [&](std::size_t s, std::size_t e) {
+        bulk_mul_add(a + s, b + s, c + s, out + s, e - s);
+    });
+}
+
+inline std::size_t parallel_bulk_divide(ThreadPool& pool, const int* a, const int* b, double* out,
+                                        std::uint64_t* valid, std::size_t n) {
+    std::memset(valid, 0, bulk_mask_words(n) * sizeof(std::uint64_t));
+    std::atomic<std::size_t> zeros{0};
+    parallel_bulk_blocks(pool, n, [&](std::size_t s, std::size_t e) {
+        // s is a multiple of 64: the block's mask starts at word s / 64.
+        zeros += bulk_kernels().divide(a + s, b + s, out + s, valid + s / 64, e - s);
+    });
+    return zeros.load();
+}
+
+#endif // CENG241_BULK_ARITHMETIC_HPP
@@ -0,0 +1,414 @@
+// CENG241 - Compressed columns: each block stored in the narrowest width
+// ----------------------------------------------------------------------
+// float_vs_double_demo.cpp shows that a float takes half the bytes of a
+// double, yet Inventory always stores 4-byte ints and StockMatrix one int
+// per cell, even when every quantity is below 200. Scans over such data
+// mostly wait for memory, so fewer bytes means faster scans.
+//
+// A packed column cuts the values into blocks of PACK_BLOCK and stores each
+// block in its own width:
+//
+//   PackedIntColumn (quantities) - "frame of reference": the block keeps its
+//     minimum ('base') and every value is stored as value - base in 1, 2 or
+//     4 bytes, whichever fits the block's max - min. Stock counts between
+//     1000 and 1200 take one byte each.
+//   PackedRealColumn (prices)    - a block is stored as float when every
+//     value survives the round trip double -> float -> double within the
+//     caller's max_abs_error (the precision-loss guard), otherwise as
+//     double. The default 0 only accepts exact round trips.
+//
+// Every block also remembers its min and max (a "zone map"). stats() reads
+// min / max from there without touching the values, find() skips blocks
+// whose [min, max] cannot contain the target, and sums run directly on the
+// narrow deltas (AVX2 versions picked like in bulk_arithmetic.hpp).
+//
+// Columns are built once (pack_*) and then read; to change a value, unpack,
+// edit and pack again. Inventory and StockMatrix stay the editable forms:
+//
+//   PackedIntColumn col;
+//   pack_inventory(inv, col);             // or pack_ints(col, data, n)
+//   stats(col, mn, mx, avg);              // same contract as stats(inv, ...)
+//   ColumnarStock cs;
+//   pack_matrix(m, cs);                   // one packed column per item
+//   columnar_item_totals(cs, totals);
+
+#ifndef CENG241_COLUMNAR_STOCK_HPP
+#define CENG241_COLUMNAR_STOCK_HPP
+
+#include <algorithm> // std::min
+#include <cmath>   // std::fabs
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy, std::memchr
+#include <vector>
+#include "compensated_sum.hpp" // accurate double sums, dispatch
+#include "stock_matrix.hpp"
+
+const std::size_t PACK_BLOCK = 4096; // values per block
+
+// --- Integer columns -------------------------------------------------------------
+
+struct PackedIntBlock {
+    int           base;   // block minimum; stored values are value - base
+    int           max;    // block maximum (zone map)
+    unsigned char width;  // bytes per stored value: 1, 2 or 4
+    std::size_t   offset; // where the block starts in 'bytes'
+};
+
+struct PackedIntColumn {
+    std::vector<PackedIntBlock> blocks;
+    std::vector<unsigned char>  bytes;
+    std::size_t                 size = 0;
+};
+
+inline unsigned char pack_width(int min, int max) {
+    std::uint32_t range = static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min);
+    if (range <= 0xFF) return 1;
+    if (range <= 0xFFFF) return 2;
+    return 4;
+}
+
+template <typename U>
+void pack_deltas(const int* v, std::size_t n, int base, unsigned char* out) {
+    for (std::size_t i = 0; i < n; ++i) {
+        U d = static_cast<U>(static_cast<std::uint32_t>(v[i]) - static_cast<std::uint32_t>(base));
+        std::memcpy(out + i * sizeof(U), &d, sizeof(U));
+    }
+}
+
+inline bool pack_ints(PackedIntColumn& col, const int* v, std::size_t n) {
+    col.blocks.clear();
+    col.bytes.clear();
+    col.size = n;
+    std::size_t nblocks = (n + PACK_BLOCK - 1) / PACK_BLOCK;
+    col.blocks.reserve(nblocks);
+    for (std::size_t b = 0; b < nblocks; ++b) {
+        const int* p = v + b * PACK_BLOCK;
+        std::size_t len = std::min(PACK_BLOCK, n - b * PACK_BLOCK);
+        int mn = p[0], mx = p[0];
+        for (std::size_t i = 1; i < len; ++i) {
+            mn = p[i] < mn ? p[i] : mn;
+            mx = p[i] > mx ? p[i] : mx;
+        }
+        PackedIntBlock blk{mn, mx, pack_width(mn, mx), col.bytes.size()};
+        col.bytes.resize(col.bytes.size() + len * blk.width);
+        unsigned char* out = col.bytes.data() + blk.offset;
+        if (blk.width == 1) pack_deltas<std::uint8_t>(p, len, mn, out);
+        else if (blk.width == 2) pack_deltas<std::uint16_t>(p, len, mn, out);
+        else pack_deltas<std::uint32_t>(p, len, mn, out);
+        col.blocks.push_back(blk);
+    }
+    col.bytes.shrink_to_fit();
+    return true;
+}
+
+inline bool pack_inventory(const Inventory& inv, PackedIntColumn& col) {
+    if (inv.size < 0 || (inv.size > 0 && !inv.data)) return false;
+    return pack_ints(col, inv.data, static_cast<std::size_t>(inv.size));
+}
+
+inline std::size_t block_length(std::size_t total, std::size_t b) {
+    return std::min(PACK_BLOCK, total - b * PACK_BLOCK);
+}
+
+// Stored value k of a block (0 <= k < block length).
+inline std::uint32_t block_delta(const PackedIntColumn& col, const PackedIntBlock& blk, std::size_t k) {
+    const unsigned char* p = col.bytes.data() + blk.offset + k * blk.width;
+    if (blk.width == 1) return *p;
+    if (blk.width == 2) {
+        std::uint16_t d;
+        std::memcpy(&d, p, 2);
+        return d;
+    }
+    std::uint32_t d;
+    std::memcpy(&d, p, 4);
+    return d;
+}
+
+inline int delta_to_int(int base, std::uint32_t d) {
+    return static_cast<int>(static_cast<std::uint32_t>(base) + d);
+}
+
+inline int packed_at(const PackedIntColumn& col, std::size_t i) {
+    const PackedIntBlock& blk = col.blocks[i / PACK_BLOCK];
+    return delta_to_int(blk.base, block_delta(col, blk, i % PACK_BLOCK));
+}
+
+inline void unpack_ints(const PackedIntColumn& col, int* out) {
+    for (std::size_t b = 0; b < col.blocks.size(); ++b) {
+        const PackedIntBlock& blk = col.blocks[b];
+        std::size_t len = block_length(col.size, b);
+        for (std::size_t k = 0; k < len; ++k) out[b * PACK_BLOCK + k] = delta_to_int(blk.base, block_delta(col, blk, k));
+    }
+}
+
+// Bytes the column occupies (values plus block headers).
+inline std::size_t packed_bytes(const PackedIntColumn& col) {
+    return col.bytes.size() + col.blocks.size() * sizeof(PackedIntBlock);
+}
+
+// --- Sums of stored deltas (scalar + AVX2) -----------------------------------------
+
+inline std::uint64_t delta_sum_scalar(const unsigned char* p, std::size_t n, unsigned char width) {
+    std::uint64_t s = 0;
+    if (width == 1) {
+        for (std::size_t i = 0; i < n; ++i) s += p[i];
+    } else if (width == 2) {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint16_t d;
+            std::memcpy(&d, p + 2 * i, 2);
+            s += d;
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint32_t d;
+            std::memcpy(&d, p + 4 * i, 4);
+            s += d;
+        }
+    }
+    return s;
+}
+
+#if BULK_ARITHMETIC_X86
+__attribute__((target("avx2")))
+inline std::uint64_t delta_sum_avx2(const unsigned char* p, std::size_t n, unsigned char width) {
+    __m256i acc = _mm256_setzero_si256(); // four 64-bit partial sums
+    std::size_t i = 0;
+    if (width == 1) {
+        // sad_epu8 against zero adds 8 bytes at a time into 64-bit lanes.
+        for (; i + 32 <= n; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, _mm256_setzero_si256()));
+        }
+    } else if (width == 2) {
+        for (; i + 8 <= n; i += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2 * i));
+            __m256i w = _mm256_cvtepu16_epi32(v);
+            acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(_mm_add_epi32(_mm256_castsi256_si128(w),
+                                                                              _mm256_extracti128_si256(w, 1))));
+        }
+    } else {
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4 * i));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(v));
+        }
+    }
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + delta_sum_scalar(p + i * width, n - i, width);
+}
+#endif
+
+inline std::uint64_t delta_sum(const unsigned char* p, std::size_t n, unsigned char width) {
+#if BULK_ARITHMETIC_X86
+    if (sum_use_avx2()) return delta_sum_avx2(p, n, width);
+#endif
+    return delta_sum_scalar(p, n, width);
+}
+
+// --- Scans on the packed form ----------------------------------------------------------
+
+inline long long packed_sum(const PackedIntColumn& col) {
+    long long total = 0;
+    for (std::size_t b = 0; b < col.blocks.size(); ++b) {
+        const PackedIntBlock& blk = col.blocks[b];
+        std::size_t len = block_length(col.size, b);
+        total += static_cast<long long>(blk.base) * static_cast<long long>(len) +
+                 static_cast<long long>(delta_sum(col.bytes.data() + blk.offset, len, blk.width));
+    }
+    return total;
+}
+
+// Same contract as stats(const Inventory&, ...): false if empty.
+inline bool stats(const PackedIntColumn& col, int& out_min, int& out_max, double& out_avg) {
+    if (col.size == 0) return false;
+    out_min = col.blocks[0].base;
+    out_max = col.blocks[0].max;
+    for (const PackedIntBlock& blk : col.blocks) { // zone map only
+        out_min = blk.base < out_min ? blk.base : out_min;
+        out_max = blk.max > out_max ? blk.max : out_max;
+    }
+    out_avg = static_cast<double>(packed_sum(col)) / static_cast<double>(col.size);
+    return true;
+}
+
+// First index holding 'value', or -1 (like find(const Inventory&, int)).
+inline long long find(const PackedIntColumn& col, int value) {
+    for (std::size_t b = 0; b < col.blocks.size(); ++b) {
+        const PackedIntBlock& blk = col.blocks[b];
+        if (value < blk.base || value > blk.max) continue; // cannot be in this block
+        std::uint32_t target = static_cast<std::uint32_t>(value) - static_cast<std::uint32_t>(blk.base);
+        std::size_t len = block_length(col.size, b);
+        const unsigned char* p = col.bytes.data() + blk.offset;
+        if (blk.width == 1) {
+            const void* hit = std::memchr(p, static_cast<int>(target), len);
+            if (hit) return static_cast<long long>(b * PACK_BLOCK + (static_cast<const unsigned char*>(hit) - p));
+            continue;
+        }
+        for (std::size_t k = 0; k < len; ++k) {
+            if (block_delta(col, blk, k) == target) return static_cast<long long>(b * PACK_BLOCK + k);
+        }
+    }
+    return -1;
+}
+
+// --- Real columns (prices) ---------------------------------------------------------------
+
+struct PackedRealBlock {
+    double        min;
+    double        max;
+    unsigned char is_float; // 1: stored as float, 0: as double
+    std::size_t   offset;
+};
+
+struct PackedRealColumn {
+    std::vector<PackedRealBlock> blocks;
+    std::vector<unsigned char>   bytes;
+    std::size_t                  size = 0;
+    std::size_t                  float_blocks = 0;
+};
+
+// The precision-loss guard: may this block be stored as float?
+inline bool fits_float(const double* v, std::size_t n, double max_abs_error) {
+    for (std::size_t i = 0; i < n; ++i) {
+        double back = static_cast<double>(static_cast<float>(v[i]));
+        if (!(std::fabs(back - v[i]) <= max_abs_error)) return false; // also rejects NaN / overflow
+    }
+    return true;
+}
+
+inline bool pack_reals(PackedRealColumn& col, const double* v, std::size_t n, double max_abs_error = 0.0) {
+    if (max_abs_error < 0) return false;
+    col.blocks.clear();
+    col.bytes.clear();
+    col.size = n;
+    col.float_blocks = 0;
+    std::size_t nblocks = (n + PACK_BLOCK - 1) / PACK_BLOCK;
+    col.blocks.reserve(nblocks);
+    for (std::size_t b = 0; b < nblocks; ++b) {
+        const double* p = v + b * PACK_BLOCK;
+        std::size_t len = block_length(n, b);
+        PackedRealBlock blk{p[0], p[0], 0, col.bytes.size()};
+        for (std::size_t i = 1; i < len; ++i) {
+            blk.min = p[i] < blk.min ? p[i] : blk.min;
+            blk.max = p[i] > blk.max ? p[i] : blk.max;
+        }
+        blk.is_float = fits_float(p, len, max_abs_error);
+        if (blk.is_float) {
+            col.bytes.resize(col.bytes.size() + len * sizeof(float));
+            for (std::size_t i = 0; i < len; ++i) {
+                float f = static_cast<float>(p[i]);
+                std::memcpy(col.bytes.data() + blk.offset + i * sizeof(float), &f, sizeof(float));
+            }
+            ++col.float_blocks;
+        } else {
+            col.bytes.resize(col.bytes.size() + len * sizeof(double));
+            std::memcpy(col.bytes.data() + blk.offset, p, len * sizeof(double));
+        }
+        col.blocks.push_back(blk);
+    }
+    col.bytes.shrink_to_fit();
+    return true;
+}
+
+inline double packed_real_at(const PackedRealColumn& col, std::size_t i) {
+    const PackedRealBlock& blk = col.blocks[i / PACK_BLOCK];
+    const unsigned char* p = col.bytes.data() + blk.offset;
+    std::size_t k = i % PACK_BLOCK;
+    if (blk.is_float) {
+        float f;
+        std::memcpy(&f, p + k * sizeof(float), sizeof(float));
+        return f;
+    }
+    double d;
+    std::memcpy(&d, p + k * sizeof(double), sizeof(double));
+    return d;
+}
+
+// Block b as doubles into out (PACK_BLOCK values of room).
+inline std::size_t unpack_real_block(const PackedRealColumn& col, std::size_t b, double* out) {
+    const PackedRealBlock& blk = col.blocks[b];
+    std::size_t len = block_length(col.size, b);
+    const unsigned char* p = col.bytes.data() + blk.offset;
+    if (blk.is_float) {
+        for (std::size_t k = 0; k < len; ++k) {
+            float f;
+            std::memcpy(&f, p + k * sizeof(float), sizeof(float));
+            out[k] = f;
+        }
+    } else {
+        std::memcpy(out, p, len * sizeof(double));
+    }
+    return len;
+}
+
+inline void unpack_reals(const PackedRealColumn& col, double* out) {
+    for (std::size_t b = 0; b < col.blocks.size(); ++b) unpack_real_block(col, b, out + b * PACK_BLOCK);
+}
+
+inline std::size_t packed_bytes(const PackedRealColumn& col) {
+    return col.bytes.size() + col.blocks.size() * sizeof(PackedRealBlock);
+}
+
+// Accurate total (compensated_sum.hpp), one small decode buffer per block.
+inline double packed_real_sum(const PackedRealColumn& col) {
+    std::vector<PartialSum<double>> partials(col.blocks.size());
+    double buf[PACK_BLOCK];
+    for (std::size_t b = 0; b < col.blocks.size(); ++b) {
+        std::size_t len = unpack_real_block(col, b, buf);
+        neumaier_block(buf, len, partials[b].s, partials[b].c);
+    }
+    return finish_accurate_sum(partials);
+}
+
+inline bool stats(const PackedRealColumn& col, double& out_min, double& out_max, double& out_avg) {
+    if (col.size == 0) return false;
+    out_min = col.blocks[0].min;
+    out_max = col.blocks[0].max;
+    for (const PackedRealBlock& blk : col.blocks) {
+        out_min = blk.min < out_min ? blk.min : out_min;
+        out_max = blk.max > out_max ? blk.max : out_max;
+    }
+    out_avg = packed_real_sum(col) / static_cast<double>(col.size);
+    return true;
+}
+
+// --- Columnar stock table ------------------------------------------------------------------
+
+// A read-only, compressed copy of a StockMatrix: one packed column per item
+// (the stock of that item across all stores).
+struct ColumnarStock {
+    int stores = 0;
+    int items = 0;
+    std::vector<PackedIntColumn> item_columns;
+};
+
+inline bool pack_matrix(const StockMatrix& m, ColumnarStock& cs) {
+    if (!m.cells || m.stores <= 0 || m.items <= 0) return false;
+    cs.stores = m.stores;
+    cs.items = m.items;
+    cs.item_columns.assign(static_cast<std::size_t>(m.items), PackedIntColumn());
+    std::vector<int> column(static_cast<std::size_t>(m.stores));
+    for (int i = 0; i < m.items; ++i) {
+        StockView v = item_column(m, i); // contiguous in column-major, strided in row-major
+        for (int s = 0; s < m.stores; ++s) column[s] = v[s];
+        pack_ints(cs.item_columns[i], column.data(), column.size());
+    }
+    return true;
+}
+
+inline int columnar_cell(const ColumnarStock& cs, int store, int item) {
+    return packed_at(cs.item_columns[item], static_cast<std::size_t>(store));
+}
+
+inline void columnar_item_totals(const ColumnarStock& cs, long long* out) {
+    for (int i = 0; i < cs.items; ++i) out[i] = packed_sum(cs.item_columns[i]);
+}
+
+inline std::size_t packed_bytes(const ColumnarStock& cs) {
+    std::size_t total = 0;
+    for (const PackedIntColumn& c : cs.item_columns) total += packed_bytes(c);
+    return total;
+}
+
+#endif // CENG241_COLUMNAR_STOCK_HPP
@@ -0,0 +1,248 @@
+// CENG241 - Accurate sums of float / double arrays (Kahan, Neumaier, pairwise)
+// ---------------------------------------------------------------------------
+// float_vs_double_demo.cpp adds 0.1f one million times and gets about
+// 100958 instead of 100000: once the total is large, every small addend
+// loses most of its digits to rounding, and the lost parts pile up. Money
+// totals over millions of prices (e.g. the doubles from ledger_expr.hpp)
+// drift the same way, only in later digits. (Inventory's stats() has no
+// such problem: it sums ints exactly in a long long.)
+//
+//   sum_naive     s += x                       error grows with n
+//   sum_kahan     also keeps the rounding error of each step in 'c' and
+//                 feeds it back into the next addend
+//   sum_neumaier  Kahan, fixed for addends larger than the running total
+//                 (e.g. 1e100 + 1 - 1e100); AVX2 version below
+//   sum_pairwise  add halves recursively: the error grows with log n,
+//                 at naive speed
+//   sum_widened   floats added in a double (extended precision for floats)
+//
+// accurate_sum() is what the ledger code should call: Neumaier per block of
+// ACCURATE_SUM_CHUNK values, then the block results are combined in a fixed
+// pairwise tree. parallel_accurate_sum() computes the same blocks on a
+// ThreadPool and combines them in the same tree, so the result is
+// bit-for-bit the same for ANY thread count (and with BULK_SIMD=scalar):
+// a total does not change because the machine has more cores.
+//
+// The vector kernels keep 4 (double) or 8 (float) independent Neumaier
+// accumulators, one per SIMD lane. The scalar fallback uses the same lanes
+// in the same order, which is why both give identical results.
+
+#ifndef CENG241_COMPENSATED_SUM_HPP
+#define CENG241_COMPENSATED_SUM_HPP
+
+#include <algorithm> // std::min
+#include <cmath>     // std::fabs
+#include <cstddef>
+#include <cstring>   // std::strcmp
+#include <vector>
+#include "bulk_arithmetic.hpp" // bulk_kernels() dispatch, ThreadPool
+
+// --- Simple modes --------------------------------------------------------------
+
+template <typename T>
+T sum_naive(const T* x, std::size_t n) {
+    T s = 0;
+    for (std::size_t i = 0; i < n; ++i) s += x[i];
+    return s;
+}
+
+template <typename T>
+T sum_kahan(const T* x, std::size_t n) {
+    T s = 0, c = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        T y = x[i] - c;  // add back what was lost last time
+        T t = s + y;
+        c = (t - s) - y; // what got lost now (algebraically 0)
+        s = t;
+    }
+    return s;
+}
+
+inline double sum_widened(const float* x, std::size_t n) {
+    double s = 0;
+    for (std::size_t i = 0; i < n; ++i) s += x[i];
+    return s;
+}
+
+// Below this many values the pairwise sum just loops.
+const std::size_t PAIRWISE_BLOCK = 128;
+
+template <typename T>
+T sum_pairwise(const T* x, std::size_t n) {
+    if (n <= PAIRWISE_BLOCK) return sum_naive(x, n);
+    std::size_t half = n / 2;
+    return sum_pairwise(x, half) + sum_pairwise(x + half, n - half);
+}
+
+// --- Neumaier ----------------------------------------------------------------------
+
+// One step: s + x, with the rounding error added to c.
+template <typename T>
+void neumaier_add(T& s, T& c, T x) {
+    T t = s + x;
+    if (std::fabs(s) >= std::fabs(x)) c += (s - t) + x;
+    else c += (x - t) + s;
+    s = t;
+}
+
+// Lanes per accumulator set: one 256-bit register.
+template <typename T>
+struct SumLanes {
+    static const int count = 32 / sizeof(T); // 4 doubles, 8 floats
+};
+
+// Fold the lanes (in order 0, 1, ...) and the tail into one (s, c) pair.
+template <typename T>
+void neumaier_finish(const T* lane_s, const T* lane_c, const T* tail, std::size_t tail_n, T& s, T& c) {
+    s = lane_s[0];
+    c = lane_c[0];
+    for (int l = 1; l < SumLanes<T>::count; ++l) {
+        neumaier_add(s, c, lane_s[l]);
+        c += lane_c[l];
+    }
+    for (std::size_t i = 0; i < tail_n; ++i) neumaier_add(s, c, tail[i]);
+}
+
+template <typename T>
+void neumaier_block_scalar(const T* x, std::size_t n, T& s, T& c) {
+    const int L = SumLanes<T>::count;
+    T lane_s[L] = {}, lane_c[L] = {};
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        for (int l = 0; l < L; ++l) neumaier_add(lane_s[l], lane_c[l], x[i + l]);
+    }
+    neumaier_finish(lane_s, lane_c, x + i, n - i, s, c);
+}
+
+#if BULK_ARITHMETIC_X86
+
+__attribute__((target("avx2")))
+inline void neumaier_block_avx2(const double* x, std::size_t n, double& s, double& c) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d vs = _mm256_setzero_pd(), vc = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d t = _mm256_add_pd(vs, vx);
+        __m256d s_big = _mm256_cmp_pd(_mm256_andnot_pd(sign, vs), _mm256_andnot_pd(sign, vx), _CMP_GE_OQ);
+        __m256d if_s = _mm256_add_pd(_mm256_sub_pd(vs, t), vx);
+        __m256d if_x = _mm256_add_pd(_mm256_sub_pd(vx, t), vs);
+        vc = _mm256_add_pd(vc, _mm256_blendv_pd(if_x, if_s, s_big));
+        vs = t;
+    }
+    alignas(32) double lane_s[4], lane_c[4];
+    _mm256_store_pd(lane_s, vs);
+    _mm256_store_pd(lane_c, vc);
+    neumaier_finish(lane_s, lane_c, x + i, n - i, s, c);
+}
+
+__attribute__((target("avx2")))
+inline void neumaier_block_avx2(const float* x, std::size_t n, float& s, float& c) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 vs = _mm256_setzero_ps(), vc = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 vx = _mm256_loadu_ps(x + i);
+        __m256 t = _mm256_add_ps(vs, vx);
+        __m256 s_big = _mm256_cmp_ps(_mm256_andnot_ps(sign, vs), _mm256_andnot_ps(sign, vx), _CMP_GE_OQ);
+        __m256 if_s = _mm256_add_ps(_mm256_sub_ps(vs, t), vx);
+        __m256 if_x = _mm256_add_ps(_mm256_sub_ps(vx, t), vs);
+        vc = _mm256_add_ps(vc, _mm256_blendv_ps(if_x, if_s, s_big));
+        vs = t;
+    }
+    alignas(32) float lane_s[8], lane_c[8];
+    _mm256_store_ps(lane_s, vs);
+    _mm256_store_ps(lane_c, vc);
+    neumaier_finish(lane_s, lane_c, x + i, n - i, s, c);
+}
+
+#endif // BULK_ARITHMETIC_X86
+
+inline bool sum_use_avx2() {
+    static const bool on = std::strcmp(bulk_kernels().name, "avx2") == 0;
+    return on;
+}
+
+// Neumaier sum of one block as (s, c); the value is s + c.
+template <typename T>
+void neumaier_block(const T* x, std::size_t n, T& s, T& c) {
+#if BULK_ARITHMETIC_X86
+    if (sum_use_avx2()) {
+        neumaier_block_avx2(x, n, s, c);
+        return;
+    }
+#endif
+    neumaier_block_scalar(x, n, s, c);
+}
+
+template <typename T>
+T sum_neumaier(const T* x, std::size_t n) {
+    T s, c;
+    neumaier_block(x, n, s, c);
+    return s + c;
+}
+
+// --- Deterministic blocked sum (single- and multi-threaded) -------------------------
+
+// Fixed block size: the blocks, and so the result, never depend on threads.
+const std::size_t ACCURATE_SUM_CHUNK = 1 << 15;
+
+template <typename T>
+struct PartialSum {
+    T s;
+    T c;
+};
+
+// Combine partials [begin, end) as a balanced tree, always split the same way.
+template <typename T>
+PartialSum<T> combine_partials(const std::vector<PartialSum<T>>& p, std::size_t begin, std::size_t end) {
+    if (end - begin == 1) return p[begin];
+    std::size_t mid = begin + (end - begin) / 2;
+    PartialSum<T> a = combine_partials(p, begin, mid);
+    PartialSum<T> b = combine_partials(p, mid, end);
+    neumaier_add(a.s, a.c, b.s);
+    a.c += b.c;
+    return a;
+}
+
+template <typename T>
+void accurate_sum_chunks(const T* x, std::size_t n, std::size_t first, std::size_t last,
+                         std::vector<PartialSum<T>>& partials) {
+    for (std::size_t k = first; k < last; ++k) {
+        std::size_t begin = k * ACCURATE_SUM_CHUNK;
+        std::size_t len = std::min(ACCURATE_SUM_CHUNK, n - begin);
+        neumaier_block(x + begin, len, partials[k].s, partials[k].c);
+    }
+}
+
+template <typename T>
+T finish_accurate_sum(const std::vector<PartialSum<T>>& partials) {
+    if (partials.empty()) return 0;
+    PartialSum<T> total = combine_partials(partials, 0, partials.size());
+    return total.s + total.c;
+}
+
+template <typename T>
+T accurate_sum(const T* x, std::size_t n) {
+    std::vector<PartialSum<T>> partials((n + ACCURATE_SUM_CHUNK - 1) / ACCURATE_SUM_CHUNK);
+    accurate_sum_chunks(x, n, 0, partials.size(), partials);
+    return finish_accurate_sum(partials);
+}
+
+// Same value as accurate_sum(x, n), bit for bit.
+template <typename T>
+T parallel_accurate_sum(ThreadPool& pool, const T* x, std::size_t n) {
+    std::vector<PartialSum<T>> partials((n + ACCURATE_SUM_CHUNK - 1) / ACCURATE_SUM_CHUNK);
+    const std::size_t chunks = partials.size();
+    if (n < PARALLEL_BULK_MIN_ELEMENTS || pool.size() == 1) {
+        accurate_sum_chunks(x, n, 0, chunks, partials);
+    } else {
+        const int parts = pool.size() * 4;
+        pool.run(parts, [&](int t) {
+            accurate_sum_chunks(x, n, chunks * t / parts, chunks * (t + 1) / parts, partials);
+        });
+    }
+    return finish_accurate_sum(partials);
+}
+
+#endif // CENG241_COMPENSATED_SUM_HPP
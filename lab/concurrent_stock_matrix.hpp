@@ -0,0 +1,159 @@
+// CENG241 - ConcurrentStockMatrix: lock-free add/reduce from many threads
+// -----------------------------------------------------------------------
+// add_stock / reduce_stock in week1_task2.cpp do `stock += qty` and a
+// check-then-set clamp to zero. With several point-of-sale threads that is
+// a data race: two threads can read the same old value and one update is
+// lost, or both pass the "enough stock?" check and the stock goes negative.
+//
+// Here every cell is a std::atomic<int>:
+//   - add:    a CAS loop that refuses to pass INT_MAX (a plain fetch_add
+//             would wrap the cell negative), no lock, never loses an update.
+//   - reduce: a compare-and-swap (CAS) loop. Read the current value, compute
+//             max(0, current - qty), and store it ONLY if nobody changed the
+//             cell in the meantime; otherwise retry with the fresh value.
+//   - orders: reduce_order takes several (store, item, qty) lines and
+//             applies ALL of them or NONE. Each line is reserved with a CAS
+//             that refuses to go below zero; if a later line cannot be
+//             served, the lines already taken are given back. Stock is never
+//             oversold. The price of staying lock-free: another thread can
+//             briefly see a half-applied order, and an order racing with it
+//             may fail when it would have fit a moment later.
+//
+// False sharing: two hot cells on the same 64-byte cache line make the
+// cores fight over that line even though they touch different cells.
+// `cells_per_line` controls the spacing. The default, 1, gives every cell
+// its own cache line (best for the small tables of hot cells this is made
+// for); 16 packs cells tightly, which uses 16x less memory for big,
+// mostly-cold tables.
+
+#ifndef CENG241_CONCURRENT_STOCK_MATRIX_HPP
+#define CENG241_CONCURRENT_STOCK_MATRIX_HPP
+
+#include <atomic>
+#include <climits> // INT_MAX
+#include <cstddef> // std::size_t
+#include <new>     // std::align_val_t, std::nothrow
+
+const int CACHE_LINE_BYTES = 64;
+const int INTS_PER_LINE = CACHE_LINE_BYTES / sizeof(std::atomic<int>); // 16
+
+struct ConcurrentStockMatrix {
+    std::atomic<int>* slots;  // stores * items * spacing atomics
+    int               stores;
+    int               items;
+    int               spacing; // slots between neighbouring cells (1 = packed)
+};
+
+// One line of an order: take 'qty' units of 'item' from 'store'.
+struct OrderLine {
+    int store;
+    int item;
+    int qty;
+};
+
+inline bool create_concurrent_matrix(ConcurrentStockMatrix& m, int stores, int items, int cells_per_line = 1) {
+    m.slots = nullptr;
+    m.stores = 0;
+    m.items = 0;
+    m.spacing = 1;
+    if (stores <= 0 || items <= 0 || cells_per_line <= 0 || cells_per_line > INTS_PER_LINE) return false;
+
+    int spacing = INTS_PER_LINE / cells_per_line;
+    std::size_t count = static_cast<std::size_t>(stores) * items * spacing;
+    void* p = ::operator new(count * sizeof(std::atomic<int>), std::align_val_t(CACHE_LINE_BYTES), std::nothrow);
+    if (!p) return false;
+    m.slots = static_cast<std::atomic<int>*>(p);
+    for (std::size_t k = 0; k < count; ++k) new (&m.slots[k]) std::atomic<int>(0);
+    m.stores = stores;
+    m.items = items;
+    m.spacing = spacing;
+    return true;
+}
+
+inline void destroy_concurrent_matrix(ConcurrentStockMatrix& m) {
+    if (m.slots) ::operator delete(m.slots, std::align_val_t(CACHE_LINE_BYTES));
+    m.slots = nullptr;
+    m.stores = 0;
+    m.items = 0;
+}
+
+inline std::atomic<int>& atomic_cell(const ConcurrentStockMatrix& m, int store, int item) {
+    return m.slots[(static_cast<std::size_t>(store) * m.items + item) * m.spacing];
+}
+
+// Read one cell (a snapshot: other threads may change it right after).
+inline int load_stock(const ConcurrentStockMatrix& m, int store, int item) {
+    return atomic_cell(m, store, item).load(std::memory_order_relaxed);
+}
+
+// Add qty units unless that would pass INT_MAX. Returns the new stock, or
+// -1 (nothing changed) if the add would overflow.
+inline int try_put(std::atomic<int>& c, int qty) {
+    int current = c.load(std::memory_order_relaxed);
+    do {
+        if (qty > INT_MAX - current) return -1;
+    } while (!c.compare_exchange_weak(current, current + qty, std::memory_order_relaxed));
+    return current + qty;
+}
+
+// Add qty (> 0) units; returns the new stock, or -1 (nothing changed) for
+// a quantity that is not positive or an add that would overflow the cell.
+inline int add_stock(ConcurrentStockMatrix& m, int store, int item, int qty) {
+    if (qty <= 0) return -1;
+    return try_put(atomic_cell(m, store, item), qty);
+}
+
+// Remove up to qty units, clamping at zero like week1_task2's reduce_stock.
+// Returns the new stock; 'removed' receives how many units were really taken.
+// A quantity that is not positive is rejected like in add_stock (-1), so
+// reduce_stock(-5) cannot add units.
+inline int reduce_stock(ConcurrentStockMatrix& m, int store, int item, int qty, int& removed) {
+    removed = 0;
+    if (qty <= 0) return -1;
+    std::atomic<int>& c = atomic_cell(m, store, item);
+    int current = c.load(std::memory_order_relaxed);
+    int next;
+    do {
+        next = (qty > current) ? 0 : current - qty;
+        // On failure compare_exchange_weak reloads 'current' for us.
+    } while (!c.compare_exchange_weak(current, next, std::memory_order_relaxed));
+    removed = current - next;
+    return next;
+}
+
+// Take exactly qty units or nothing. Returns false (and changes nothing)
+// if the cell holds fewer than qty units.
+inline bool try_take(std::atomic<int>& c, int qty) {
+    int current = c.load(std::memory_order_relaxed);
+    do {
+        if (current < qty) return false;
+    } while (!c.compare_exchange_weak(current, current - qty, std::memory_order_acq_rel));
+    return true;
+}
+
+// Give back qty units taken by try_take. An add racing with us may have
+// refilled the cell since, so stop at INT_MAX instead of wrapping; the
+// excess is dropped, as add_stock would have refused it.
+inline void put_back(std::atomic<int>& c, int qty) {
+    int current = c.load(std::memory_order_relaxed);
+    while (!c.compare_exchange_weak(current, qty > INT_MAX - current ? INT_MAX : current + qty,
+                                    std::memory_order_acq_rel, std::memory_order_relaxed)) {
+    }
+}
+
+// All-or-nothing reduce for a multi-item order. Returns true if every line
+// was served; on false the stock is as before (lines taken are given back).
+inline bool reduce_order(ConcurrentStockMatrix& m, const OrderLine* lines, int count) {
+    for (int k = 0; k < count; ++k) {
+        if (lines[k].qty < 0) return false;
+    }
+    for (int k = 0; k < count; ++k) {
+        if (!try_take(atomic_cell(m, lines[k].store, lines[k].item), lines[k].qty)) {
+            for (int u = 0; u < k; ++u) put_back(atomic_cell(m, lines[u].store, lines[u].item), lines[u].qty);
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // CENG241_CONCURRENT_STOCK_MATRIX_HPP
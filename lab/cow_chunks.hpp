@@ -0,0 +1,61 @@
+// CENG241 - Copy-on-write chunks: the building block of snapshots
+// ---------------------------------------------------------------
+// A report that scans the whole ledger while sales keep changing it needs a
+// CONSISTENT view: every number from the same moment. Locking the ledger for
+// the whole scan gives that, but stops every sale until the scan is done.
+//
+// Copy-on-write (COW) gives each reader its own frozen VERSION instead:
+//
+//   - The data is cut into chunks of COW_CHUNK_INTS ints, and a version is
+//     just a directory of pointers to chunks.
+//   - Taking a snapshot copies ONE pointer (to the directory): O(1), no data
+//     is copied.
+//   - A writer never changes a chunk that a snapshot can still see. Before a
+//     write it asks "am I the only owner?"; if not, it copies that one chunk
+//     (4 KiB) and changes the copy. Old versions keep the old chunk.
+//   - Chunks and directories are std::shared_ptr: when the last snapshot
+//     that uses an old chunk is dropped, the reference count reaches zero
+//     and the chunk is freed. No reader has to tell the writer it is done.
+//
+// The only shared counter a writer reads is use_count(). Other threads can
+// only LOWER it (by dropping their snapshots), so a stale value can make the
+// writer copy a chunk it did not need to copy, never change one in place
+// that a snapshot still reads.
+//
+// Users: inventory_snapshot.hpp (lab_1 ledger) and stock_matrix_snapshot.hpp
+// (week1_task2 stock table). Out of memory throws std::bad_alloc, as the
+// std::vector based headers do.
+
+#ifndef CENG241_COW_CHUNKS_HPP
+#define CENG241_COW_CHUNKS_HPP
+
+#include <atomic>
+#include <memory> // std::shared_ptr, std::make_shared
+
+const int COW_CHUNK_INTS = 1024; // ints per chunk (4 KiB, one page)
+
+struct CowChunk {
+    int count;                 // used slots (fixed-size users keep it full)
+    int items[COW_CHUNK_INTS];
+};
+
+using CowChunkRef = std::shared_ptr<CowChunk>;
+
+// True if 'p' is the only owner, so the writer may change *p in place.
+template <class T>
+inline bool cow_unique(const std::shared_ptr<T>& p) {
+    if (p.use_count() != 1) return false;
+    // The reader that dropped the last other reference did so with a release
+    // decrement; this fence makes its reads of *p happen before our writes.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+}
+
+// Make *p private to the writer: copy it first if a snapshot still shares it.
+template <class T>
+inline T& cow_writable(std::shared_ptr<T>& p) {
+    if (!cow_unique(p)) p = std::make_shared<T>(*p);
+    return *p;
+}
+
+#endif // CENG241_COW_CHUNKS_HPP
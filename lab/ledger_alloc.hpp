@@ -0,0 +1,196 @@
+// CENG241 - Pluggable allocators for ledger buffers (arena and pool)
+// ------------------------------------------------------------------
+// create / reserve (Inventory) and create_matrix (StockMatrix) normally get
+// their memory from the global heap: `new int[n]` / aligned operator new.
+// A program that creates and destroys tens of thousands of small ledgers
+// per minute then spends much of its time inside malloc/free, and threads
+// doing so at the same time compete for the heap's internal locks.
+//
+// A LedgerAllocator is passed to create / create_matrix and remembered in
+// the ledger, so reserve and destroy use it too. Two are provided:
+//
+//   ArenaAllocator  "bump" allocation: hand out the next free bytes of a big
+//                   block, nothing else. release() does nothing; reset()
+//                   frees EVERYTHING at once by rewinding to the start. A
+//                   whole batch of ledgers is torn down with one reset()
+//                   instead of one free per ledger.
+//
+//   PoolAllocator   size classes (64 B, 128 B, 256 B, ... 1 MiB). Freed
+//                   buffers go onto a free list for their class and are
+//                   handed out again; for ledgers created and destroyed one
+//                   by one. Larger requests go straight to the heap.
+//
+// thread_arena() / thread_pool_allocator() return one allocator per thread
+// (thread_local), so threads never share, and never lock. Rule: release a
+// buffer on the thread that allocated it, and do not use ledgers from an
+// arena after reset() (they point into reused memory; simply forget them,
+// calling destroy() is also allowed but not needed).
+//
+// Every buffer is 64-byte aligned (one cache line), as StockMatrix needs.
+
+#ifndef CENG241_LEDGER_ALLOC_HPP
+#define CENG241_LEDGER_ALLOC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>    // std::align_val_t, std::nothrow
+#include <vector>
+
+const std::size_t LEDGER_ALLOC_ALIGN = 64;
+
+// The interface: allocate returns nullptr on failure (like new (std::nothrow));
+// release gets the same size that was requested.
+class LedgerAllocator {
+public:
+    virtual ~LedgerAllocator() = default;
+    virtual void* allocate(std::size_t bytes) = 0;
+    virtual void release(void* p, std::size_t bytes) = 0;
+};
+
+inline void* aligned_heap_allocate(std::size_t bytes) {
+    return ::operator new(bytes, std::align_val_t(LEDGER_ALLOC_ALIGN), std::nothrow);
+}
+
+inline void aligned_heap_release(void* p) {
+    ::operator delete(p, std::align_val_t(LEDGER_ALLOC_ALIGN));
+}
+
+inline std::size_t round_up_align(std::size_t bytes) {
+    return (bytes + LEDGER_ALLOC_ALIGN - 1) & ~(LEDGER_ALLOC_ALIGN - 1);
+}
+
+// --- Arena ---------------------------------------------------------------
+
+class ArenaAllocator : public LedgerAllocator {
+public:
+    explicit ArenaAllocator(std::size_t block_bytes = 1 << 20) : block_bytes_(round_up_align(block_bytes)) {}
+    ~ArenaAllocator() override { free_blocks(); }
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    void* allocate(std::size_t bytes) override {
+        bytes = round_up_align(bytes == 0 ? 1 : bytes);
+        // Move on through the blocks kept from before the last reset().
+        while (current_ < blocks_.size() && used_ + bytes > blocks_[current_].bytes) {
+            ++current_;
+            used_ = 0;
+        }
+        if (current_ == blocks_.size()) {
+            std::size_t size = bytes > block_bytes_ ? bytes : block_bytes_; // big requests get their own block
+            char* p = static_cast<char*>(aligned_heap_allocate(size));
+            if (!p) return nullptr;
+            blocks_.push_back(Block{p, size});
+            used_ = 0;
+        }
+        char* p = blocks_[current_].base + used_;
+        used_ += bytes;
+        return p;
+    }
+
+    // Individual buffers are never freed; see reset().
+    void release(void*, std::size_t) override {}
+
+    // Forget every allocation at once. The blocks stay for reuse, so the
+    // next batch of ledgers needs no heap calls at all.
+    void reset() {
+        current_ = 0;
+        used_ = 0;
+    }
+
+    // reset() and return the blocks to the heap.
+    void release_all() {
+        free_blocks();
+        reset();
+    }
+
+    std::size_t reserved_bytes() const {
+        std::size_t total = 0;
+        for (const Block& b : blocks_) total += b.bytes;
+        return total;
+    }
+
+private:
+    struct Block {
+        char*       base;
+        std::size_t bytes;
+    };
+
+    std::size_t block_bytes_;
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0; // block we are carving from
+    std::size_t used_ = 0;    // bytes used in that block
+
+    void free_blocks() {
+        for (const Block& b : blocks_) aligned_heap_release(b.base);
+        blocks_.clear();
+    }
+};
+
+// --- Size-class pool -------------------------------------------------------
+
+const int POOL_MIN_SHIFT = 6;  // smallest class: 64 bytes
+const int POOL_MAX_SHIFT = 20; // largest class: 1 MiB
+const int POOL_CLASSES = POOL_MAX_SHIFT - POOL_MIN_SHIFT + 1;
+
+class PoolAllocator : public LedgerAllocator {
+public:
+    explicit PoolAllocator(std::size_t slab_bytes = 256 * 1024) : slabs_(slab_bytes) {}
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* allocate(std::size_t bytes) override {
+        int c = size_class(bytes);
+        if (c < 0) return aligned_heap_allocate(bytes);
+        if (FreeNode* node = free_[c]) { // reuse a returned buffer
+            free_[c] = node->next;
+            return node;
+        }
+        return slabs_.allocate(std::size_t(1) << (c + POOL_MIN_SHIFT));
+    }
+
+    void release(void* p, std::size_t bytes) override {
+        if (!p) return;
+        int c = size_class(bytes);
+        if (c < 0) {
+            aligned_heap_release(p);
+            return;
+        }
+        // The freed buffer itself stores the list link: no extra memory.
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = free_[c];
+        free_[c] = node;
+    }
+
+    // Index of the smallest class that fits, or -1 if too big for the pool.
+    static int size_class(std::size_t bytes) {
+        int c = 0;
+        while ((std::size_t(1) << (c + POOL_MIN_SHIFT)) < bytes) {
+            if (++c == POOL_CLASSES) return -1;
+        }
+        return c;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    FreeNode* free_[POOL_CLASSES] = {};
+    ArenaAllocator slabs_; // carves new buffers; memory returns to the heap with the pool
+};
+
+// --- Per-thread instances ----------------------------------------------------
+
+inline ArenaAllocator& thread_arena() {
+    thread_local ArenaAllocator arena;
+    return arena;
+}
+
+inline PoolAllocator& thread_pool_allocator() {
+    thread_local PoolAllocator pool;
+    return pool;
+}
+
+#endif // CENG241_LEDGER_ALLOC_HPP
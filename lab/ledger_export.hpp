@@ -0,0 +1,146 @@
+// CENG241 - Fast export of ledgers: one buffer, few write(2) calls
+// ----------------------------------------------------------------
+// Writing a 10M-entry ledger through std::cout spends almost all of its
+// time in stream overhead. These exporters format into an OutBuffer
+// (out_buffer.hpp): std::to_chars into one reusable block, one write(2)
+// per MiB.
+//
+// Formats (ExportFormat):
+//   EXPORT_CSV     Inventory: one value per line (readable by
+//                  load_inventory); StockMatrix: one line per store
+//                  "v,v,...,v" (readable by load_matrix)
+//   EXPORT_JSONL   one JSON object per line:
+//                  {"index":7,"stock":120} / {"store":3,"stock":[...]}
+//   EXPORT_BINARY  raw little-endian int32 values (a matrix row by row,
+//                  without the padding), for other programs to mmap
+//
+// Ranges: every export takes [first, first + count), so operators can look
+// at a window (print_inventory_page) without formatting the whole ledger.
+
+#ifndef CENG241_LEDGER_EXPORT_HPP
+#define CENG241_LEDGER_EXPORT_HPP
+
+#include <cstddef>
+#include <iostream> // std::cout.flush() before writing to fd 1
+#include <fcntl.h>  // open
+#include <unistd.h> // close
+#include "out_buffer.hpp"
+#include "251009/inventory.hpp"
+#include "stock_matrix.hpp"
+
+enum ExportFormat { EXPORT_CSV, EXPORT_JSONL, EXPORT_BINARY };
+
+// --- Inventory -------------------------------------------------------------------------
+
+// Clamp [first, first + count) to the ledger; false if first is past the end.
+inline bool clamp_range(long long size, long long& first, long long& count) {
+    if (first < 0 || count < 0 || first > size) return false;
+    if (count > size - first) count = size - first;
+    return true;
+}
+
+inline bool export_inventory(OutBuffer& out, const Inventory& inv, ExportFormat format, long long first = 0,
+                             long long count = -1) {
+    if (count < 0) count = inv.size;
+    if (!clamp_range(inv.size, first, count)) return false;
+    const int* v = inv.data + first;
+    if (format == EXPORT_BINARY) {
+        out_bytes(out, v, static_cast<std::size_t>(count) * sizeof(int));
+    } else if (format == EXPORT_CSV) {
+        for (long long i = 0; i < count; ++i) {
+            out_int(out, v[i]);
+            out_char(out, '\n');
+        }
+    } else {
+        for (long long i = 0; i < count; ++i) {
+            out_str(out, "{\"index\":");
+            out_int(out, first + i);
+            out_str(out, ",\"stock\":");
+            out_int(out, v[i]);
+            out_str(out, "}\n");
+        }
+    }
+    return out_flush(out);
+}
+
+// --- StockMatrix -------------------------------------------------------------------------
+
+// Stores [first, first + count), every item.
+inline bool export_matrix(OutBuffer& out, const StockMatrix& m, ExportFormat format, long long first = 0,
+                          long long count = -1) {
+    if (count < 0) count = m.stores;
+    if (!clamp_range(m.stores, first, count)) return false;
+    for (long long s = first; s < first + count; ++s) {
+        StockView row = store_row(m, static_cast<int>(s));
+        if (format == EXPORT_BINARY) {
+            if (row.stride == 1) {
+                out_bytes(out, row.base, static_cast<std::size_t>(row.length) * sizeof(int));
+            } else {
+                for (int i = 0; i < row.length; ++i) out_bytes(out, &row[i], sizeof(int));
+            }
+            continue;
+        }
+        if (format == EXPORT_JSONL) {
+            out_str(out, "{\"store\":");
+            out_int(out, s);
+            out_str(out, ",\"stock\":[");
+        }
+        for (int i = 0; i < row.length; ++i) {
+            if (i) out_char(out, ',');
+            out_int(out, row[i]);
+        }
+        out_str(out, format == EXPORT_JSONL ? "]}\n" : "\n");
+    }
+    return out_flush(out);
+}
+
+// --- Files -------------------------------------------------------------------------------
+
+inline bool export_inventory_file(const Inventory& inv, const char* path, ExportFormat format) {
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    OutBuffer out;
+    bool ok = out_init(out, fd) && export_inventory(out, inv, format);
+    out_free(out);
+    return ::close(fd) == 0 && ok;
+}
+
+inline bool export_matrix_file(const StockMatrix& m, const char* path, ExportFormat format) {
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    OutBuffer out;
+    bool ok = out_init(out, fd) && export_matrix(out, m, format);
+    out_free(out);
+    return ::close(fd) == 0 && ok;
+}
+
+// --- Human-readable pages on stdout ----------------------------------------------------------
+
+// "[first] v" lines for one page of the ledger; page numbers start at 0.
+inline bool print_inventory_page(const Inventory& inv, long long page, long long page_size) {
+    if (page_size <= 0) return false;
+    long long first = page * page_size;
+    long long count = page_size;
+    if (first >= inv.size || !clamp_range(inv.size, first, count)) return false;
+    std::cout.flush();
+    OutBuffer& out = stdout_buffer();
+    out_str(out, "Page ");
+    out_int(out, page + 1);
+    out_char(out, '/');
+    out_int(out, (inv.size + page_size - 1) / page_size);
+    out_str(out, " (items ");
+    out_int(out, first);
+    out_str(out, "..");
+    out_int(out, first + count - 1);
+    out_str(out, "):\n");
+    for (long long i = first; i < first + count; ++i) {
+        out_str(out, "  [");
+        out_int(out, i);
+        out_str(out, "] ");
+        out_int(out, inv.data[i]);
+        out_char(out, '\n');
+    }
+    return out_flush(out);
+}
+
+#endif // CENG241_LEDGER_EXPORT_HPP
@@ -0,0 +1,291 @@
+// CENG241 - Expression templates: whole-array formulas in ONE loop
+// -----------------------------------------------------------------
+// With the bulk functions (bulk_arithmetic.hpp) a formula such as
+//
+//   total = qty * price - discount / rate
+//
+// runs as three passes with two temporary double arrays:
+//
+//   bulk_mul(qty, price, t1, n);               read 2 arrays, write t1
+//   bulk_divide(discount, rate, t2, valid, n); read 2 arrays, write t2
+//   for (i) total[i] = t1[i] - t2[i];          read t1, t2, write total
+//
+// For 100M rows, t1 and t2 are 800 MB each and the memory traffic of
+// writing and re-reading them costs more than the arithmetic itself.
+//
+// Here `qty * price - discount / rate` does NOT compute anything. Each
+// operator returns a small object that only remembers what to compute (its
+// operation and its two operands), so the whole formula becomes a tree of
+// types known at compile time:
+//
+//   Binary<SubOp, Binary<MulOp, Column<int>, Column<int>>,
+//                 Binary<DivOp, Column<int>, Column<int>>>
+//
+// evaluate(expr, total, n) then runs one loop; for every row the compiler
+// inlines the whole tree into straight-line code: read four ints, compute,
+// write one double. No temporaries, no allocation.
+//
+// Usage:
+//   using namespace ledger;
+//   auto qty = column(qty_ptr, n), price = column(price_ptr, n), ...;
+//   evaluate(qty * price - discount / rate, total, n);
+//   evaluate(qty * 1.18 + 5, total, n);           // numbers work too
+//
+// Semantics match week1_task1.cpp: ints are converted to double first,
+// then +, -, *, / as doubles (no fused multiply-add, so results are
+// bit-for-bit the same as the step-by-step version). A zero divisor makes
+// that division 0.0 (as in bulk_divide) and marks the ROW invalid: pass a
+// mask of bulk_mask_words(n) words to see which rows, and/or a counter.
+//
+// The nodes keep their operands BY VALUE (a leaf is just pointer + size),
+// so `auto e = a * b + c;` stays valid after the statement ends.
+//
+// Like bulk_arithmetic.hpp there is an AVX2 version of every node (4 rows
+// per step), used when bulk_kernels() picked AVX2 (BULK_SIMD=scalar turns
+// it off), and parallel_evaluate() splits large arrays over a ThreadPool.
+
+#ifndef CENG241_LEDGER_EXPR_HPP
+#define CENG241_LEDGER_EXPR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memset, std::strcmp
+#include "bulk_arithmetic.hpp"
+
+namespace ledger {
+
+// --- Sizes -------------------------------------------------------------------
+
+const std::size_t EXPR_BROADCAST = SIZE_MAX;         // a number: fits any size
+const std::size_t EXPR_SIZE_MISMATCH = SIZE_MAX - 1; // columns of different sizes
+
+inline std::size_t expr_combine_size(std::size_t a, std::size_t b) {
+    if (a == EXPR_BROADCAST) return b;
+    if (b == EXPR_BROADCAST) return a;
+    return a == b ? a : EXPR_SIZE_MISMATCH;
+}
+
+// --- Node base ---------------------------------------------------------------
+// Every node derives from Expr<itself> ("CRTP"). The operators below only
+// accept Expr<...>, so they never hijack + - * / of other types.
+
+template <typename E>
+struct Expr {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+#if BULK_ARITHMETIC_X86
+__attribute__((target("avx2")))
+inline __m256d expr_load4(const int* p) {
+    return load4_as_double(p);
+}
+
+__attribute__((target("avx2")))
+inline __m256d expr_load4(const double* p) {
+    return _mm256_loadu_pd(p);
+}
+#endif
+
+// --- Leaves ------------------------------------------------------------------
+
+// An existing array of int or double. Does not own the memory.
+template <typename T>
+struct Column : Expr<Column<T>> {
+    const T*    data;
+    std::size_t n;
+
+    Column(const T* d, std::size_t count) : data(d), n(count) {}
+    std::size_t size() const { return n; }
+    double at(std::size_t i, bool&) const { return static_cast<double>(data[i]); }
+#if BULK_ARITHMETIC_X86
+    __attribute__((target("avx2")))
+    __m256d at4(std::size_t i, __m256d&) const { return expr_load4(data + i); }
+#endif
+};
+
+template <typename T>
+Column<T> column(const T* data, std::size_t n) {
+    return Column<T>(data, n);
+}
+
+// A plain number, the same for every row.
+struct Constant : Expr<Constant> {
+    double value;
+
+    explicit Constant(double v) : value(v) {}
+    std::size_t size() const { return EXPR_BROADCAST; }
+    double at(std::size_t, bool&) const { return value; }
+#if BULK_ARITHMETIC_X86
+    __attribute__((target("avx2")))
+    __m256d at4(std::size_t, __m256d&) const { return _mm256_set1_pd(value); }
+#endif
+};
+
+// --- Operations ----------------------------------------------------------------
+// apply() is one row, apply4() four rows. 'bad' collects zero divisors.
+
+struct AddOp {
+    static double apply(double l, double r, bool&) { return l + r; }
+#if BULK_ARITHMETIC_X86
+    __attribute__((target("avx2")))
+    static __m256d apply4(__m256d l, __m256d r, __m256d&) { return _mm256_add_pd(l, r); }
+#endif
+};
+
+struct SubOp {
+    static double apply(double l, double r, bool&) { return l - r; }
+#if BULK_ARITHMETIC_X86
+    __attribute__((target("avx2")))
+    static __m256d apply4(__m256d l, __m256d r, __m256d&) { return _mm256_sub_pd(l, r); }
+#endif
+};
+
+struct MulOp {
+    static double apply(double l, double r, bool&) { return l * r; }
+#if BULK_ARITHMETIC_X86
+    __attribute__((target("avx2")))
+    static __m256d apply4(__m256d l, __m256d r, __m256d&) { return _mm256_mul_pd(l, r); }
+#endif
+};
+
+struct DivOp {
+    static double apply(double l, double r, bool& bad) {
+        bool zero = r == 0.0;
+        bad = bad || zero;
+        double q = l / (zero ? 1.0 : r); // never actually divides by 0
+        return zero ? 0.0 : q;
+    }
+#if BULK_ARITHMETIC_X86
+    __attribute__((target("avx2")))
+    static __m256d apply4(__m256d l, __m256d r, __m256d& bad) {
+        const __m256d zero = _mm256_setzero_pd();
+        __m256d is_zero = _mm256_cmp_pd(r, zero, _CMP_EQ_OQ);
+        bad = _mm256_or_pd(bad, is_zero);
+        __m256d q = _mm256_div_pd(l, _mm256_blendv_pd(r, _mm256_set1_pd(1.0), is_zero));
+        return _mm256_blendv_pd(q, zero, is_zero);
+    }
+#endif
+};
+
+// --- Inner node ------------------------------------------------------------------
+
+template <typename Op, typename L, typename R>
+struct Binary : Expr<Binary<Op, L, R>> {
+    L left;
+    R right;
+
+    Binary(const L& l, const R& r) : left(l), right(r) {}
+    std::size_t size() const { return expr_combine_size(left.size(), right.size()); }
+    double at(std::size_t i, bool& bad) const { return Op::apply(left.at(i, bad), right.at(i, bad), bad); }
+#if BULK_ARITHMETIC_X86
+    __attribute__((target("avx2")))
+    __m256d at4(std::size_t i, __m256d& bad) const {
+        return Op::apply4(left.at4(i, bad), right.at4(i, bad), bad);
+    }
+#endif
+};
+
+// --- Operators -------------------------------------------------------------------
+// expr OP expr, expr OP number, number OP expr.
+
+#define LEDGER_EXPR_OPERATOR(sym, Op)                                               \
+    template <typename L, typename R>                                               \
+    Binary<Op, L, R> operator sym(const Expr<L>& l, const Expr<R>& r) {             \
+        return Binary<Op, L, R>(l.self(), r.self());                                \
+    }                                                                               \
+    template <typename L>                                                           \
+    Binary<Op, L, Constant> operator sym(const Expr<L>& l, double r) {              \
+        return Binary<Op, L, Constant>(l.self(), Constant(r));                      \
+    }                                                                               \
+    template <typename R>                                                           \
+    Binary<Op, Constant, R> operator sym(double l, const Expr<R>& r) {              \
+        return Binary<Op, Constant, R>(Constant(l), r.self());                      \
+    }
+
+LEDGER_EXPR_OPERATOR(+, AddOp)
+LEDGER_EXPR_OPERATOR(-, SubOp)
+LEDGER_EXPR_OPERATOR(*, MulOp)
+LEDGER_EXPR_OPERATOR(/, DivOp)
+
+#undef LEDGER_EXPR_OPERATOR
+
+// --- Evaluation ----------------------------------------------------------------------
+
+// Rows [begin, end); begin must be a multiple of 4 so each group of four
+// mask bits stays inside one word. Returns the number of invalid rows.
+template <typename E>
+std::size_t evaluate_range_scalar(const E& e, double* out, std::size_t begin, std::size_t end,
+                                  std::uint64_t* valid) {
+    std::size_t bad_rows = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+        bool bad = false;
+        out[i] = e.at(i, bad);
+        if (valid) valid[i / 64] |= static_cast<std::uint64_t>(!bad) << (i % 64);
+        bad_rows += bad;
+    }
+    return bad_rows;
+}
+
+#if BULK_ARITHMETIC_X86
+template <typename E>
+__attribute__((target("avx2")))
+std::size_t evaluate_range_avx2(const E& e, double* out, std::size_t begin, std::size_t end,
+                                std::uint64_t* valid) {
+    std::size_t bad_rows = 0;
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m256d bad = _mm256_setzero_pd();
+        _mm256_storeu_pd(out + i, e.at4(i, bad));
+        int bits = _mm256_movemask_pd(bad); // 1 = row hit a zero divisor
+        if (valid) valid[i / 64] |= static_cast<std::uint64_t>(~bits & 0xF) << (i % 64);
+        bad_rows += static_cast<std::size_t>(__builtin_popcount(bits));
+    }
+    return bad_rows + evaluate_range_scalar(e, out, i, end, valid);
+}
+#endif
+
+inline bool expr_use_avx2() {
+    static const bool on = std::strcmp(bulk_kernels().name, "avx2") == 0;
+    return on;
+}
+
+template <typename E>
+std::size_t evaluate_range(const E& e, double* out, std::size_t begin, std::size_t end, std::uint64_t* valid) {
+#if BULK_ARITHMETIC_X86
+    if (expr_use_avx2()) return evaluate_range_avx2(e, out, begin, end, valid);
+#endif
+    return evaluate_range_scalar(e, out, begin, end, valid);
+}
+
+// out[i] = expr at row i, for i in [0, n). Returns false (and writes
+// nothing) if the columns in expr are not all n long. 'valid' (optional,
+// bulk_mask_words(n) words) gets bit i = 0 for rows that divided by zero;
+// 'bad_rows' (optional) gets how many there were.
+template <typename E>
+bool evaluate(const Expr<E>& expr, double* out, std::size_t n, std::uint64_t* valid = nullptr,
+              std::size_t* bad_rows = nullptr) {
+    const E& e = expr.self();
+    if (e.size() != n && e.size() != EXPR_BROADCAST) return false;
+    if (valid) std::memset(valid, 0, bulk_mask_words(n) * sizeof(std::uint64_t));
+    std::size_t bad = evaluate_range(e, out, 0, n, valid);
+    if (bad_rows) *bad_rows = bad;
+    return true;
+}
+
+// The same split over a thread pool (one fused loop per block).
+template <typename E>
+bool parallel_evaluate(ThreadPool& pool, const Expr<E>& expr, double* out, std::size_t n,
+                       std::uint64_t* valid = nullptr, std::size_t* bad_rows = nullptr) {
+    const E& e = expr.self();
+    if (e.size() != n && e.size() != EXPR_BROADCAST) return false;
+    if (valid) std::memset(valid, 0, bulk_mask_words(n) * sizeof(std::uint64_t));
+    std::atomic<std::size_t> bad{0};
+    parallel_bulk_blocks(pool, n, [&](std::size_t s, std::size_t end) { bad += evaluate_range(e, out, s, end, valid); });
+    if (bad_rows) *bad_rows = bad.load();
+    return true;
+}
+
+} // namespace ledger
+
+#endif // CENG241_LEDGER_EXPR_HPP
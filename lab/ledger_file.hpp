@@ -0,0 +1,237 @@
+// CENG241 - Memory-mapped ledger files (shared by Inventory and StockMatrix)
+// -------------------------------------------------------------------------
+// Everything the lab programs keep in memory disappears at exit. Writing it
+// out and reading it back element by element would make restarts slow for
+// multi-GB ledgers. Instead we *map* the file into memory with mmap(): the
+// file's bytes appear as an ordinary array, the operating system loads
+// pages lazily on first touch and writes changed pages back by itself.
+// Opening a 10 GB ledger is therefore nearly instant.
+//
+// File layout (version 1), all little-endian as on x86/ARM:
+//
+//   offset 0   LedgerFileHeader (64 bytes, see below)
+//   offset 64  payload: the raw int cells (Inventory data or StockMatrix cells)
+//
+// Because mmap returns page-aligned memory and the header is exactly one
+// cache line, the payload starts 64-byte aligned, as StockMatrix expects.
+//
+// Checksum: verifying multi-GB data on every start would defeat the point,
+// so the payload checksum is computed when the file is synced/closed
+// cleanly and FLAG_CLEAN is set. While a writer has the file open the flag
+// is cleared; after a crash the header still opens but the checksum is
+// known to be stale. ledger_file_open(..., verify = true) re-checks it.
+//
+// Growing: ledger_file_resize() extends the file with ftruncate() and the
+// mapping with mremap() (Linux), which usually remaps pages in place
+// instead of copying the data.
+//
+// POSIX only (Linux, macOS). Functions return false on failure, like the
+// rest of the lab code.
+
+#ifndef CENG241_LEDGER_FILE_HPP
+#define CENG241_LEDGER_FILE_HPP
+
+#include <cerrno>   // ENOENT
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, mremap, msync, munmap
+#include <sys/stat.h> // fstat, stat
+#include <unistd.h>   // ftruncate, close
+
+const char LEDGER_FILE_MAGIC[8] = {'C', 'E', 'N', 'G', 'L', 'D', 'G', 'R'};
+const std::uint32_t LEDGER_FILE_VERSION = 1;
+
+enum LedgerFileKind : std::uint32_t {
+    LEDGER_KIND_INVENTORY = 1,
+    LEDGER_KIND_STOCK_MATRIX = 2
+};
+
+const std::uint32_t FLAG_CLEAN = 1; // checksum matches the payload
+
+struct LedgerFileHeader {
+    char          magic[8];   // "CENGLDGR"
+    std::uint32_t version;    // LEDGER_FILE_VERSION
+    std::uint32_t kind;       // LedgerFileKind
+    std::uint64_t size;       // Inventory: used elements
+    std::uint64_t capacity;   // ints the payload can hold
+    std::uint32_t stores;     // StockMatrix: rows
+    std::uint32_t items;      // StockMatrix: columns
+    std::uint32_t layout;     // StockMatrix: 0 = row-major, 1 = column-major
+    std::uint32_t ld;         // StockMatrix: padded row/column length
+    std::uint64_t checksum;   // of the payload, valid when FLAG_CLEAN is set
+    std::uint32_t flags;
+    std::uint32_t generation; // snapshot number, used by the write-ahead log (ledger_wal.hpp)
+};
+static_assert(sizeof(LedgerFileHeader) == 64, "header must stay one cache line");
+
+struct MappedFile {
+    int               fd;
+    void*             base;   // start of the mapping (the header)
+    std::size_t       length; // mapped bytes = 64 + payload bytes
+    LedgerFileHeader* header;
+    int*              payload;
+};
+
+// Word-at-a-time FNV-1a style hash: 8 bytes per step instead of 1.
+inline std::uint64_t ledger_checksum(const void* data, std::size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t h = 1469598103934665603ull;
+    std::size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        std::uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        h = (h ^ w) * 1099511628211ull;
+    }
+    for (; i < bytes; ++i) h = (h ^ p[i]) * 1099511628211ull;
+    return h;
+}
+
+inline std::size_t ledger_payload_bytes(const MappedFile& f) {
+    return f.length - sizeof(LedgerFileHeader);
+}
+
+inline void ledger_file_reset(MappedFile& f) {
+    f.fd = -1;
+    f.base = nullptr;
+    f.length = 0;
+    f.header = nullptr;
+    f.payload = nullptr;
+}
+
+inline bool ledger_file_map(MappedFile& f, std::size_t length) {
+    void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, f.fd, 0);
+    if (p == MAP_FAILED) return false;
+    f.base = p;
+    f.length = length;
+    f.header = static_cast<LedgerFileHeader*>(p);
+    f.payload = reinterpret_cast<int*>(static_cast<char*>(p) + sizeof(LedgerFileHeader));
+    return true;
+}
+
+// False only if 'path' does not exist. Decide between open and create with
+// this, not with "open failed": create truncates, so a file that exists but
+// cannot be opened (wrong kind, damaged, no permission) would be wiped.
+inline bool ledger_file_exists(const char* path) {
+    struct stat st;
+    return ::stat(path, &st) == 0 || errno != ENOENT;
+}
+
+// Create (or overwrite) a file with room for capacity_ints zeroed ints.
+inline bool ledger_file_create(MappedFile& f, const char* path, LedgerFileKind kind, std::size_t capacity_ints) {
+    ledger_file_reset(f);
+    f.fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (f.fd < 0) return false;
+    std::size_t length = sizeof(LedgerFileHeader) + capacity_ints * sizeof(int);
+    // ftruncate extends with zeros (a sparse file: no disk blocks until written).
+    if (::ftruncate(f.fd, static_cast<off_t>(length)) != 0 || !ledger_file_map(f, length)) {
+        ::close(f.fd);
+        ledger_file_reset(f);
+        return false;
+    }
+    LedgerFileHeader& h = *f.header;
+    std::memcpy(h.magic, LEDGER_FILE_MAGIC, sizeof h.magic);
+    h.version = LEDGER_FILE_VERSION;
+    h.kind = kind;
+    h.capacity = capacity_ints;
+    h.flags = 0; // not clean until the first sync
+    return true;
+}
+
+// Open an existing file. Fails on wrong magic/version/kind or a bad size.
+// With verify = true a cleanly closed file must also match its checksum.
+inline bool ledger_file_open(MappedFile& f, const char* path, LedgerFileKind kind, bool verify = false) {
+    ledger_file_reset(f);
+    f.fd = ::open(path, O_RDWR);
+    if (f.fd < 0) return false;
+    struct stat st;
+    bool ok = ::fstat(f.fd, &st) == 0
+           && static_cast<std::size_t>(st.st_size) >= sizeof(LedgerFileHeader)
+           && ledger_file_map(f, static_cast<std::size_t>(st.st_size));
+    if (ok) {
+        const LedgerFileHeader& h = *f.header;
+        ok = std::memcmp(h.magic, LEDGER_FILE_MAGIC, sizeof h.magic) == 0
+          && h.version == LEDGER_FILE_VERSION
+          && h.kind == static_cast<std::uint32_t>(kind)
+          && h.capacity * sizeof(int) == ledger_payload_bytes(f)
+          && h.size <= h.capacity;
+        if (ok && verify && (h.flags & FLAG_CLEAN)) {
+            ok = ledger_checksum(f.payload, ledger_payload_bytes(f)) == h.checksum;
+        }
+    }
+    if (!ok) {
+        if (f.base) ::munmap(f.base, f.length);
+        ::close(f.fd);
+        ledger_file_reset(f);
+        return false;
+    }
+    // From now on the payload may change: the stored checksum is stale.
+    f.header->flags &= ~FLAG_CLEAN;
+    return true;
+}
+
+// Grow or shrink the payload to capacity_ints. The mapping may move, so
+// callers must re-read f.payload afterwards.
+inline bool ledger_file_resize(MappedFile& f, std::size_t capacity_ints) {
+    std::size_t length = sizeof(LedgerFileHeader) + capacity_ints * sizeof(int);
+    if (length == f.length) return true;
+    // The file is resized first (growing: the new mapping needs the bytes;
+    // shrinking: a failed truncate then changes nothing). A failed remap
+    // must not leave the file at a length header->capacity does not match,
+    // or the next open rejects it: put the old length back.
+    if (::ftruncate(f.fd, static_cast<off_t>(length)) != 0) return false;
+    auto undo_resize = [&] {
+        (void)::ftruncate(f.fd, static_cast<off_t>(f.length));
+        return false;
+    };
+#ifdef __linux__
+    void* p = ::mremap(f.base, f.length, length, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED) return undo_resize();
+    f.base = p;
+    f.length = length;
+    f.header = static_cast<LedgerFileHeader*>(p);
+    f.payload = reinterpret_cast<int*>(static_cast<char*>(p) + sizeof(LedgerFileHeader));
+#else
+    std::size_t old_length = f.length;
+    void* old_base = f.base;
+    if (!ledger_file_map(f, length)) return undo_resize();
+    ::munmap(old_base, old_length);
+#endif
+    f.header->capacity = capacity_ints; // only now do file, mapping and header agree
+    return true;
+}
+
+// Compute the checksum, mark the file clean and flush it to disk.
+inline bool ledger_file_sync(MappedFile& f) {
+    f.header->checksum = ledger_checksum(f.payload, ledger_payload_bytes(f));
+    f.header->flags |= FLAG_CLEAN;
+    bool ok = ::msync(f.base, f.length, MS_SYNC) == 0;
+    // The file stays open for writing, so clear the flag again in memory.
+    // The kernel may write that page back at any time, which errs on the
+    // safe side: a later crash then leaves a file marked "not clean".
+    f.header->flags &= ~FLAG_CLEAN;
+    return ok;
+}
+
+// Release a file that was judged invalid after opening: unmap and close
+// only. ledger_file_close would checksum it and mark it clean.
+inline void ledger_file_discard(MappedFile& f) {
+    if (f.base) ::munmap(f.base, f.length);
+    if (f.fd >= 0) ::close(f.fd);
+    ledger_file_reset(f);
+}
+
+// Store the checksum, mark the file clean, flush it and release it.
+inline bool ledger_file_close(MappedFile& f) {
+    if (!f.base) return true;
+    f.header->checksum = ledger_checksum(f.payload, ledger_payload_bytes(f));
+    f.header->flags |= FLAG_CLEAN;
+    bool ok = ::msync(f.base, f.length, MS_SYNC) == 0;
+    ok = (::munmap(f.base, f.length) == 0) && ok;
+    ok = (::close(f.fd) == 0) && ok;
+    ledger_file_reset(f);
+    return ok;
+}
+
+#endif // CENG241_LEDGER_FILE_HPP
@@ -0,0 +1,353 @@
+// CENG241 - Ingest: read a replay file in large blocks, reads kept in flight
+// -------------------------------------------------------------------------
+// `std::cin >> x` asks for the next few bytes only when the program wants
+// them, so the disk (or page cache) and the CPU take turns. The first stage
+// of the replay pipeline (ledger_pipeline.hpp) instead reads the input in
+// INGEST_BLOCK_BYTES blocks and hands each finished block to the parser
+// while the next reads are already under way. Three backends:
+//
+//   io_uring  (regular files) the kernel's submission/completion rings:
+//             INGEST_DEPTH reads at increasing offsets are queued with ONE
+//             system call; each completion is collected from a shared ring
+//             without another call and its slot is reused for the next
+//             block. Written against <linux/io_uring.h> directly (no
+//             liburing): a ring is two mmap'ed arrays plus head/tail
+//             indexes shared with the kernel.
+//   read      (regular files) plain read(2) of one block at a time; used
+//             when io_uring_setup is not allowed (old kernel, seccomp,
+//             io_uring_disabled), when the kernel has io_uring but not its
+//             READ opcode (before 5.6), or when LEDGER_IO=read is set.
+//   epoll     (pipes, sockets, a terminal: `./week1_task2 --replay - < ops`)
+//             a non-blocking descriptor, epoll_wait until it is readable,
+//             then read(2) what is there. epoll cannot wait on regular files
+//             (they are always "ready"), so it is the fallback for streams.
+//
+// ingest_fd calls sink(std::string&& block) for every block, in file
+// order, and returns false on a read error.
+
+#ifndef CENG241_LEDGER_INGEST_HPP
+#define CENG241_LEDGER_INGEST_HPP
+
+#include <algorithm> // std::min
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>  // std::getenv
+#include <cstring>  // std::memset, std::strcmp
+#include <memory>   // std::unique_ptr
+#include <string>
+#include <utility>  // std::move
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+const std::size_t INGEST_BLOCK_BYTES = 256 * 1024;
+const unsigned INGEST_DEPTH = 4; // io_uring reads in flight
+
+enum class IngestBackend { IoUring, Read, Epoll };
+
+inline const char* ingest_backend_name(IngestBackend b) {
+    switch (b) {
+        case IngestBackend::IoUring: return "io_uring";
+        case IngestBackend::Read: return "read";
+        default: return "epoll";
+    }
+}
+
+// --- io_uring (raw system calls) ------------------------------------------------
+
+struct IoRing {
+    int fd = -1;
+    void* sq_map = nullptr;
+    void* cq_map = nullptr;
+    std::size_t sq_map_bytes = 0, cq_map_bytes = 0;
+    io_uring_sqe* sqes = nullptr;
+    std::size_t sqes_bytes = 0;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    io_uring_cqe* cqes;
+};
+
+inline void io_ring_close(IoRing& r) {
+    if (r.sqes) munmap(r.sqes, r.sqes_bytes);
+    if (r.cq_map && r.cq_map != r.sq_map) munmap(r.cq_map, r.cq_map_bytes);
+    if (r.sq_map) munmap(r.sq_map, r.sq_map_bytes);
+    if (r.fd >= 0) ::close(r.fd);
+    r = IoRing{};
+}
+
+inline bool io_ring_open(IoRing& r, unsigned entries) {
+    io_uring_params p;
+    std::memset(&p, 0, sizeof p);
+    r.fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &p));
+    if (r.fd < 0) return false;
+    r.sq_map_bytes = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r.cq_map_bytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && r.cq_map_bytes > r.sq_map_bytes) r.sq_map_bytes = r.cq_map_bytes;
+    r.sq_map = mmap(nullptr, r.sq_map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r.fd,
+                    IORING_OFF_SQ_RING);
+    if (r.sq_map == MAP_FAILED) {
+        r.sq_map = nullptr;
+        io_ring_close(r);
+        return false;
+    }
+    r.cq_map = single ? r.sq_map
+                      : mmap(nullptr, r.cq_map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r.fd,
+                             IORING_OFF_CQ_RING);
+    r.sqes_bytes = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, r.sqes_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r.fd,
+                      IORING_OFF_SQES);
+    if (r.cq_map == MAP_FAILED || sqes == MAP_FAILED) {
+        if (r.cq_map == MAP_FAILED) r.cq_map = nullptr;
+        if (sqes != MAP_FAILED) munmap(sqes, r.sqes_bytes);
+        io_ring_close(r);
+        return false;
+    }
+    r.sqes = static_cast<io_uring_sqe*>(sqes);
+    char* sq = static_cast<char*>(r.sq_map);
+    char* cq = static_cast<char*>(r.cq_map);
+    r.sq_head = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+    r.sq_tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    r.sq_mask = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    r.sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    r.cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    r.cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    r.cq_mask = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    r.cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+    return true;
+}
+
+// Queue a read of n bytes at 'offset' into buf; the kernel sees it at the
+// next io_ring_enter. 'tag' comes back in the completion.
+inline void io_ring_queue_read(IoRing& r, int fd, char* buf, unsigned n, std::uint64_t offset, std::uint64_t tag) {
+    unsigned tail = *r.sq_tail; // only we write the tail
+    unsigned index = tail & *r.sq_mask;
+    io_uring_sqe& sqe = r.sqes[index];
+    std::memset(&sqe, 0, sizeof sqe);
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(buf);
+    sqe.len = n;
+    sqe.off = offset;
+    sqe.user_data = tag;
+    r.sq_array[index] = index;
+    __atomic_store_n(r.sq_tail, tail + 1, __ATOMIC_RELEASE); // the kernel may read the entry now
+}
+
+// Submit 'submit' queued reads and wait until at least one has completed.
+inline bool io_ring_enter(IoRing& r, unsigned submit) {
+    while (true) {
+        long rc = syscall(__NR_io_uring_enter, r.fd, submit, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (rc >= 0) return true;
+        if (errno != EINTR) return false;
+    }
+}
+
+// Whether the kernel knows 'op'. IORING_REGISTER_PROBE arrived in Linux 5.6
+// together with IORING_OP_READ, so on 5.1-5.5 the probe itself fails and
+// the answer is no (io_uring_setup works there, but every read would
+// complete with -EINVAL).
+inline bool io_ring_supports(IoRing& r, unsigned op) {
+    const unsigned max_ops = 256;
+    std::string space(sizeof(io_uring_probe) + max_ops * sizeof(io_uring_probe_op), '\0');
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(&space[0]);
+    if (syscall(__NR_io_uring_register, r.fd, IORING_REGISTER_PROBE, probe, max_ops) < 0) return false;
+    return op <= probe->last_op && op < max_ops && (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+// Take one completion if there is one.
+inline bool io_ring_reap(IoRing& r, std::uint64_t& tag, int& result) {
+    unsigned head = *r.cq_head;
+    if (head == __atomic_load_n(r.cq_tail, __ATOMIC_ACQUIRE)) return false;
+    const io_uring_cqe& cqe = r.cqes[head & *r.cq_mask];
+    tag = cqe.user_data;
+    result = cqe.res;
+    __atomic_store_n(r.cq_head, head + 1, __ATOMIC_RELEASE); // the kernel may reuse the entry
+    return true;
+}
+
+// Blocks 0, 1, 2, ... of a regular file; up to INGEST_DEPTH reads in flight,
+// delivered in order even when they complete out of order.
+template <typename Sink>
+bool ingest_uring(IoRing& ring, int fd, std::uint64_t size, Sink& sink) {
+    struct Slot {
+        std::string buf;
+        std::uint64_t offset = 0;
+        unsigned want = 0, got = 0;
+        bool busy = false, done = false;
+    };
+    // On the heap so that, if the ring cannot be drained, the buffers the
+    // kernel may still write into can be left alive (see 'fail' below).
+    std::unique_ptr<Slot[]> slots(new Slot[INGEST_DEPTH]);
+    std::uint64_t next_offset = 0;  // next block to queue
+    std::uint64_t deliver = 0;      // next block to hand to the sink
+    unsigned queued = 0;            // queued, not yet submitted
+    unsigned outstanding = 0;       // queued or submitted, not yet completed
+
+    auto queue_block = [&](unsigned s) {
+        Slot& slot = slots[s];
+        slot.offset = next_offset;
+        slot.want = static_cast<unsigned>(std::min<std::uint64_t>(INGEST_BLOCK_BYTES, size - next_offset));
+        slot.got = 0;
+        slot.buf.resize(slot.want);
+        slot.busy = true;
+        slot.done = false;
+        next_offset += slot.want;
+        io_ring_queue_read(ring, fd, &slot.buf[0], slot.want, slot.offset, s);
+        ++queued;
+        ++outstanding;
+    };
+    // Every read handed to the kernel targets a slot buffer, so none of them
+    // may be freed before its completion has come back.
+    auto fail = [&] {
+        std::uint64_t tag;
+        int res;
+        while (outstanding > 0) {
+            if (!io_ring_enter(ring, queued)) {
+                slots.release(); // can't tell when the kernel is done: leak rather than corrupt
+                return false;
+            }
+            queued = 0;
+            while (io_ring_reap(ring, tag, res)) --outstanding;
+        }
+        return false;
+    };
+    for (unsigned s = 0; s < INGEST_DEPTH && next_offset < size; ++s) queue_block(s);
+
+    while (deliver < size) {
+        if (!io_ring_enter(ring, queued)) return fail();
+        queued = 0;
+        std::uint64_t tag;
+        int res;
+        bool bad = false;
+        while (io_ring_reap(ring, tag, res)) {
+            --outstanding;
+            Slot& slot = slots[tag];
+            if (res <= 0) { // error, or the file shrank under us
+                bad = true;
+                continue;
+            }
+            if (bad) continue;
+            slot.got += static_cast<unsigned>(res);
+            if (slot.got < slot.want) { // short read: ask for the rest
+                io_ring_queue_read(ring, fd, &slot.buf[slot.got], slot.want - slot.got, slot.offset + slot.got, tag);
+                ++queued;
+                ++outstanding;
+            } else {
+                slot.done = true;
+            }
+        }
+        if (bad) return fail();
+        // Hand over finished blocks in file order, then reuse their slots.
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            for (unsigned s = 0; s < INGEST_DEPTH; ++s) {
+                Slot& slot = slots[s];
+                if (slot.busy && slot.done && slot.offset == deliver) {
+                    deliver += slot.want;
+                    slot.busy = false;
+                    sink(std::move(slot.buf));
+                    slot.buf = std::string();
+                    if (next_offset < size) queue_block(s);
+                    progress = true;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// --- Fallbacks ---------------------------------------------------------------------
+
+template <typename Sink>
+bool ingest_read(int fd, Sink& sink) {
+    while (true) {
+        std::string block(INGEST_BLOCK_BYTES, '\0');
+        std::size_t got = 0;
+        while (got < block.size()) {
+            ssize_t r = ::read(fd, &block[got], block.size() - got);
+            if (r < 0 && errno == EINTR) continue;
+            if (r < 0) return false;
+            if (r == 0) break;
+            got += static_cast<std::size_t>(r);
+        }
+        block.resize(got);
+        if (got == 0) return true;
+        sink(std::move(block));
+    }
+}
+
+template <typename Sink>
+bool ingest_epoll(int fd, Sink& sink) {
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) return ingest_read(fd, sink);
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof ev);
+    ev.events = EPOLLIN;
+    if (ep < 0 || epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        if (ep >= 0) ::close(ep);
+        fcntl(fd, F_SETFL, flags);
+        return ingest_read(fd, sink);
+    }
+    bool ok = true;
+    std::string block;
+    while (true) {
+        if (block.empty()) block.resize(INGEST_BLOCK_BYTES);
+        ssize_t r = ::read(fd, &block[0], block.size());
+        if (r > 0) {
+            block.resize(static_cast<std::size_t>(r));
+            sink(std::move(block));
+            block = std::string();
+            continue;
+        }
+        if (r == 0) break;
+        if (errno == EINTR) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            ok = false;
+            break;
+        }
+        epoll_event ready;
+        if (epoll_wait(ep, &ready, 1, -1) < 0 && errno != EINTR) {
+            ok = false;
+            break;
+        }
+    }
+    ::close(ep);
+    fcntl(fd, F_SETFL, flags);
+    return ok;
+}
+
+// --- Entry point ------------------------------------------------------------------------
+
+// Read all of fd; 'used' tells which backend did it.
+template <typename Sink>
+bool ingest_fd(int fd, Sink sink, IngestBackend& used) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) return false;
+    if (!S_ISREG(st.st_mode)) {
+        used = IngestBackend::Epoll;
+        return ingest_epoll(fd, sink);
+    }
+    const char* forced = std::getenv("LEDGER_IO");
+    IoRing ring;
+    if (!(forced && std::strcmp(forced, "read") == 0) && io_ring_open(ring, INGEST_DEPTH * 2)) {
+        if (io_ring_supports(ring, IORING_OP_READ)) {
+            used = IngestBackend::IoUring;
+            bool ok = ingest_uring(ring, fd, static_cast<std::uint64_t>(st.st_size), sink);
+            io_ring_close(ring);
+            return ok;
+        }
+        io_ring_close(ring); // kernel older than 5.6: no IORING_OP_READ
+    }
+    used = IngestBackend::Read;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    return ingest_read(fd, sink);
+}
+
+#endif // CENG241_LEDGER_INGEST_HPP
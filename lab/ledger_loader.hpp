@@ -0,0 +1,314 @@
+// CENG241 - Bulk loader: numbers from a text file straight into a ledger
+// ----------------------------------------------------------------------
+// read_int (lab_1.cpp), read_int_in_range (week1_task2.cpp) and the
+// `cin >> numbers[i]` loop (week_1.cpp) are right for a person typing at a
+// prompt. Loading 100 million stock values the same way costs a virtual
+// call, a locale lookup and a stream state check per number, plus a copy of
+// every byte into the stream's buffer.
+//
+// load_inventory / load_matrix instead:
+//   1. mmap the file read-only: the text is used in place, nothing is copied
+//      or read() into a buffer;
+//   2. count the separators (',' ' ' '\t' '\n') with AVX2, 32 bytes per
+//      step: there can be at most that many + 1 numbers, so capacity is
+//      reserved ONCE and parsing never reallocates;
+//   3. parse each number straight into inv.data / the matrix cells: 8 bytes
+//      at a time for numbers up to 7 digits (parse_int), std::from_chars
+//      (no locale, no allocation, no exceptions) for longer ones.
+//
+// File format: one or more integers per line, separated by commas and/or
+// spaces ("12,7,0" or "12 7 0"); blank lines are skipped and "\r\n" line
+// ends are accepted. For a StockMatrix every non-blank line is one store and
+// the first line decides the number of items.
+//
+// Malformed lines ("12x", "1,,2", a number outside int, a matrix row with
+// the wrong number of fields) are skipped as a whole and counted in
+// LoadReport; the first LOAD_REPORT_MAX_LINES line numbers are kept so the
+// caller can show them. Nothing falls back to slower parsing. Functions
+// return false only when the file cannot be opened or memory runs out.
+
+#ifndef CENG241_LEDGER_LOADER_HPP
+#define CENG241_LEDGER_LOADER_HPP
+
+#include <charconv> // std::from_chars
+#include <cstddef>
+#include <cstdint>
+#include <cstring>  // std::memchr, std::strcmp
+#include <limits>
+#include <vector>
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, madvise, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#include "bulk_arithmetic.hpp" // bulk_kernels() dispatch
+#include "stock_matrix.hpp"
+
+const std::size_t LOAD_REPORT_MAX_LINES = 100;
+
+struct LoadReport {
+    std::size_t values = 0;    // numbers stored
+    std::size_t lines = 0;     // lines read (including blank and bad ones)
+    std::size_t bad_lines = 0; // lines skipped as malformed
+    std::vector<std::size_t> bad_line_numbers; // 1-based, first LOAD_REPORT_MAX_LINES
+};
+
+// --- Read-only mapping -------------------------------------------------------------
+
+struct MappedText {
+    const char* data = nullptr;
+    std::size_t size = 0;
+};
+
+inline bool map_text_file(MappedText& t, const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    t.size = static_cast<std::size_t>(st.st_size);
+    t.data = nullptr;
+    if (t.size > 0) {
+        void* p = ::mmap(nullptr, t.size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        ::madvise(p, t.size, MADV_SEQUENTIAL); // read-ahead aggressively
+        t.data = static_cast<const char*>(p);
+    }
+    ::close(fd); // the mapping stays valid without the descriptor
+    return true;
+}
+
+inline void unmap_text_file(MappedText& t) {
+    if (t.data) ::munmap(const_cast<char*>(t.data), t.size);
+    t.data = nullptr;
+    t.size = 0;
+}
+
+// --- Separator count (capacity bound) --------------------------------------------------
+
+inline bool is_load_separator(char c) {
+    return c == ',' || c == ' ' || c == '\t' || c == '\n';
+}
+
+inline std::size_t count_separators_scalar(const char* p, std::size_t n) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) count += is_load_separator(p[i]);
+    return count;
+}
+
+#if BULK_ARITHMETIC_X86
+__attribute__((target("avx2")))
+inline std::size_t count_separators_avx2(const char* p, std::size_t n) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, comma), _mm256_cmpeq_epi8(v, space)),
+                                      _mm256_or_si256(_mm256_cmpeq_epi8(v, tab), _mm256_cmpeq_epi8(v, newline)));
+        count += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(hit))));
+    }
+    return count + count_separators_scalar(p + i, n - i);
+}
+#endif
+
+// Upper bound on the numbers in [p, p + n): separators + 1.
+inline std::size_t max_values_in(const char* p, std::size_t n) {
+#if BULK_ARITHMETIC_X86
+    if (std::strcmp(bulk_kernels().name, "avx2") == 0) return count_separators_avx2(p, n) + 1;
+#endif
+    return count_separators_scalar(p, n) + 1;
+}
+
+// --- Line parser -------------------------------------------------------------------------
+
+inline void note_bad_line(LoadReport& report) {
+    ++report.bad_lines;
+    if (report.bad_line_numbers.size() < LOAD_REPORT_MAX_LINES) report.bad_line_numbers.push_back(report.lines);
+}
+
+// Digits -> int for [p, end): like std::from_chars for base 10 (optional
+// '-', then digits; false on no digits or out of int range). Moves p to the
+// first character after the number.
+//
+// Numbers of up to 7 digits (all stock counts) are parsed 8 bytes at a time
+// without a loop ("SWAR", SIMD within a register): one load, a few
+// subtractions and masks find where the digits end, and three multiplies
+// combine them. A per-digit loop instead costs one hard-to-predict branch
+// per number, because numbers have different lengths.
+inline bool parse_int_slow(const char*& p, const char* end, int& out) {
+    std::from_chars_result r = std::from_chars(p, end, out);
+    if (r.ec != std::errc()) return false;
+    p = r.ptr;
+    return true;
+}
+
+inline bool parse_int(const char*& p, const char* end, int& out) {
+    bool negative = *p == '-';
+    const char* q = p + negative;
+    if (end - q < 8) return parse_int_slow(p, end, out);
+    std::uint64_t chunk;
+    std::memcpy(&chunk, q, 8); // q[0] is the lowest byte (little-endian)
+    // High bit of a byte of 'stop' is set if that byte is not '0'..'9'. A
+    // borrow/carry only travels towards LATER bytes, so the first
+    // non-digit is always detected correctly.
+    std::uint64_t x = chunk - 0x3030303030303030ull;
+    std::uint64_t stop = (x | (x + 0x7676767676767676ull)) & 0x8080808080808080ull;
+    if (stop == 0) return parse_int_slow(p, end, out); // 8+ digits: rare
+    int len = __builtin_ctzll(stop) / 8;                 // digits before it
+    if (len == 0) return false;
+    // Move the digits to the top bytes (the bottom becomes leading zeros),
+    // then add neighbouring digits pairwise: 1+1 -> 2 -> 4 -> 8 digits.
+    std::uint64_t v = chunk << (8 * (8 - len));
+    v = ((v & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    v = ((v & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    v = ((v & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+    out = negative ? -static_cast<int>(v) : static_cast<int>(v); // 7 digits always fit
+    p = q + len;
+    return true;
+}
+
+inline bool is_blank_char(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Parse the numbers of the line starting at p (up to '\n' or end) into out,
+// which has room for max_count. Moves p to the start of the next line.
+// Returns how many numbers, or -1 if the line is malformed or holds more
+// than max_count (out may then hold garbage; the caller ignores it).
+// The line end is found while parsing, so there is no separate search for
+// '\n' except to skip the rest of a bad line.
+inline long long parse_line(const char*& p, const char* end, int* out, std::size_t max_count) {
+    long long count = 0;
+    bool need_value = false; // just saw a comma
+    while (true) {
+        while (p < end && is_blank_char(*p)) ++p;
+        if (p == end || *p == '\n') {
+            if (p < end) ++p;
+            return need_value ? -1 : count; // "1,2," is malformed
+        }
+        if (static_cast<std::size_t>(count) == max_count) break;
+        if (!parse_int(p, end, out[count])) break; // not a number, or out of int range
+        ++count;
+        bool spaced = p < end && is_blank_char(*p);
+        while (p < end && is_blank_char(*p)) ++p;
+        need_value = p < end && *p == ',';
+        if (need_value) ++p;
+        else if (p < end && *p != '\n' && !spaced) break; // "12x"
+    }
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+    p = nl ? nl + 1 : end;
+    return -1;
+}
+
+// Call fn(line_begin, line_end) for every line of the text.
+template <typename Fn>
+void for_each_line(const MappedText& t, Fn fn) {
+    const char* p = t.data;
+    const char* end = t.data + t.size;
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        const char* eol = nl ? nl : end;
+        fn(p, eol);
+        p = nl ? nl + 1 : end;
+    }
+}
+
+inline bool is_blank_line(const char* p, const char* eol) {
+    for (; p < eol; ++p) {
+        if (!is_blank_char(*p)) return false;
+    }
+    return true;
+}
+
+// --- Inventory -----------------------------------------------------------------------------
+
+// Append every number in the file to inv (created if inv.data is null).
+inline bool load_inventory(Inventory& inv, const char* path, LoadReport& report) {
+    report = LoadReport();
+    MappedText t;
+    if (!map_text_file(t, path)) return false;
+    std::size_t bound = max_values_in(t.data, t.size);
+    if (static_cast<std::size_t>(inv.size) + bound > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        unmap_text_file(t);
+        return false;
+    }
+    int want = inv.size + static_cast<int>(bound);
+    bool ok = inv.data ? (want <= inv.capacity || reserve(inv, want)) : create(inv, want);
+    if (!ok) {
+        unmap_text_file(t);
+        return false;
+    }
+    int size_before = inv.size; // appending: count only the new values
+    const char* p = t.data;
+    const char* end = t.data + t.size;
+    while (p < end) {
+        ++report.lines;
+        long long n = parse_line(p, end, inv.data + inv.size, static_cast<std::size_t>(inv.capacity - inv.size));
+        if (n < 0) note_bad_line(report);
+        else inv.size += static_cast<int>(n);
+    }
+    report.values = static_cast<std::size_t>(inv.size - size_before);
+    unmap_text_file(t);
+    return true;
+}
+
+// --- StockMatrix ------------------------------------------------------------------------------
+
+// Build m (stores = non-blank lines, items = numbers on the first one).
+// Rows that are malformed or have a different length stay zero.
+inline bool load_matrix(StockMatrix& m, const char* path, LoadReport& report,
+                        MatrixLayout layout = MatrixLayout::RowMajor) {
+    report = LoadReport();
+    MappedText t;
+    if (!map_text_file(t, path)) return false;
+
+    // Pass 1 (memchr per line, only the first row parsed): shape of the table.
+    int stores = 0;
+    long long items = -1;
+    std::vector<int> row;
+    for_each_line(t, [&](const char* p, const char* eol) {
+        if (is_blank_line(p, eol)) return;
+        if (items < 0) {
+            row.resize(static_cast<std::size_t>(eol - p) / 2 + 1);
+            const char* q = p;
+            items = parse_line(q, eol, row.data(), row.size());
+        }
+        ++stores;
+    });
+    if (items <= 0 || items > std::numeric_limits<int>::max() ||
+        !create_matrix(m, stores, static_cast<int>(items), layout)) {
+        unmap_text_file(t);
+        return false;
+    }
+
+    // Pass 2: parse every row into a scratch row, then into the matrix.
+    row.resize(static_cast<std::size_t>(items));
+    int s = 0;
+    const char* p = t.data;
+    const char* end = t.data + t.size;
+    while (p < end) {
+        ++report.lines;
+        long long n = parse_line(p, end, row.data(), row.size()); // -1 if too long
+        if (n == 0) continue; // blank line
+        if (n != items) {
+            note_bad_line(report);
+        } else {
+            StockView v = store_row(m, s);
+            for (int i = 0; i < m.items; ++i) v[i] = row[i];
+            report.values += static_cast<std::size_t>(items);
+        }
+        ++s;
+    }
+    unmap_text_file(t);
+    return true;
+}
+
+#endif // CENG241_LEDGER_LOADER_HPP
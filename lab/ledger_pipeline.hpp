@@ -0,0 +1,409 @@
+// CENG241 - Replay pipeline: ingest, parse, validate, apply and emit at once
+// -------------------------------------------------------------------------
+// The week1_task2 menu does one thing at a time: wait for std::cin, check
+// the numbers (read_int_in_range), change one cell, print one line with
+// std::cout, repeat. Replaying a day of recorded operations that way costs
+// the SUM of the five steps for every line.
+//
+// run_replay splits the work into stages, each on its own thread, joined by
+// bounded single-producer/single-consumer queues (spsc_queue.hpp):
+//
+//   ingest --blocks--> parse --ops--> validate --ops--> apply --results--> emit
+//   (ledger_ingest.hpp)                (int_in_range)   (StockMatrix)   (OutBuffer)
+//
+// While 'apply' works on batch k, 'validate' checks batch k+1, 'parse' cuts
+// batch k+2 out of the text, and the next blocks are being read. Once the
+// queues are full every stage runs at the pace of the slowest one, so the
+// time per line is the MAX of the stage times instead of their sum (given a
+// core per stage). Stages pass BATCHES of PIPELINE_BATCH_OPS operations, so
+// a queue operation is paid once per batch, not once per line.
+//
+// Replay file format, one operation per line (numbers are 1-based as in the
+// menu; blank lines and lines starting with '#' are skipped):
+//   add S I Q       add Q units of item I in store S
+//   reduce S I Q    remove up to Q units (clamped at 0, as in the menu)
+//   show S          print every item of store S
+// Lines that do not parse or fail validation are reported by line number
+// and skipped. The output is the same text the menu prints for each step.
+//
+// PipelineMode::Sequential runs the same stage functions one after another
+// on the calling thread: same output, for comparison.
+
+#ifndef CENG241_LEDGER_PIPELINE_HPP
+#define CENG241_LEDGER_PIPELINE_HPP
+
+#include <chrono>
+#include <climits> // INT_MAX
+#include <cstddef>
+#include <cstring> // std::memchr, std::strlen, std::strncmp
+#include <string>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+#include "ledger_ingest.hpp"
+#include "ledger_loader.hpp" // parse_line, is_blank_char
+#include "out_buffer.hpp"
+#include "spsc_queue.hpp"
+#include "stock_matrix.hpp"
+
+const std::size_t PIPELINE_BATCH_OPS = 1024;   // operations per batch
+const std::size_t PIPELINE_QUEUE_BATCHES = 16; // batches a queue can hold
+
+enum ReplayKind : unsigned char {
+    REPLAY_SHOW,
+    REPLAY_ADD,
+    REPLAY_REDUCE,
+    REPLAY_BAD_LINE,  // unknown command or wrong number of arguments
+    REPLAY_BAD_STORE, // set by validate
+    REPLAY_BAD_ITEM,
+    REPLAY_BAD_QTY,
+    REPLAY_OVERFLOW   // set by apply: the add would pass INT_MAX
+};
+
+enum PipelineStage { STAGE_INGEST, STAGE_PARSE, STAGE_VALIDATE, STAGE_APPLY, STAGE_EMIT, STAGE_COUNT };
+
+const char* const PIPELINE_STAGE_NAMES[STAGE_COUNT] = {"ingest", "parse", "validate", "apply", "emit"};
+
+enum class PipelineMode { Sequential, Pipelined };
+
+struct ReplayOp {
+    unsigned char kind;
+    int store, item, qty; // as written in the file (1-based)
+    int value;            // after apply: new stock, or the stock before a clamped reduce,
+                          // or (show) the offset of the row in ReplayBatch::rows
+    bool clamped;         // reduce asked for more than there was
+    long long line;
+};
+
+struct ReplayBatch {
+    std::vector<ReplayOp> ops;
+    std::vector<int> rows; // copies of shown store rows, filled by apply
+};
+
+struct ReplayReport {
+    bool ok = true;                    // false on a read error
+    long long lines = 0;               // operations read (comments / blanks excluded)
+    long long rejected = 0;            // skipped as malformed or out of range
+    double seconds = 0;
+    double busy[STAGE_COUNT] = {};     // seconds each stage spent working (not waiting)
+    long long full_waits[STAGE_COUNT] = {}; // stage found its output queue full
+    IngestBackend backend = IngestBackend::Read;
+};
+
+// The rule read_int_in_range (week1_task2.cpp) enforces at the prompt.
+inline bool int_in_range(int x, int low, int high) {
+    return x >= low && x <= high;
+}
+
+// --- Parse -------------------------------------------------------------------------------
+
+struct ReplayParser {
+    std::string carry;  // an incomplete last line, waiting for the next block
+    long long line = 0; // lines seen so far
+    ReplayBatch batch;
+};
+
+inline bool replay_word(const char*& p, const char* eol, const char* word) {
+    std::size_t n = std::strlen(word);
+    if (static_cast<std::size_t>(eol - p) < n || std::strncmp(p, word, n) != 0) return false;
+    if (p + n < eol && !is_blank_char(p[n])) return false; // "added" is not "add"
+    p += n;
+    return true;
+}
+
+inline void parse_replay_line(ReplayParser& ps, const char* p, const char* eol) {
+    ++ps.line;
+    while (p < eol && is_blank_char(*p)) ++p;
+    if (p == eol || *p == '#') return;
+    ReplayOp op{REPLAY_BAD_LINE, 0, 0, 0, 0, false, ps.line};
+    int want = 0;
+    if (replay_word(p, eol, "add")) {
+        op.kind = REPLAY_ADD;
+        want = 3;
+    } else if (replay_word(p, eol, "reduce")) {
+        op.kind = REPLAY_REDUCE;
+        want = 3;
+    } else if (replay_word(p, eol, "show")) {
+        op.kind = REPLAY_SHOW;
+        want = 1;
+    }
+    if (want > 0) {
+        int args[3];
+        if (parse_line(p, eol, args, 3) == want) {
+            op.store = args[0];
+            op.item = want == 3 ? args[1] : 0;
+            op.qty = want == 3 ? args[2] : 0;
+        } else {
+            op.kind = REPLAY_BAD_LINE;
+        }
+    }
+    ps.batch.ops.push_back(op);
+}
+
+// Parse every complete line of 'block' (plus the carried-over start of the
+// first one); call out(ReplayBatch&&) for each full batch. last = no more
+// blocks: the final line needs no '\n' and the partial batch goes out too.
+template <typename Out>
+void parse_block(ReplayParser& ps, const std::string& block, bool last, Out& out) {
+    const char* p = block.data();
+    const char* end = p + block.size();
+    auto flush_if_full = [&] {
+        if (ps.batch.ops.size() >= PIPELINE_BATCH_OPS) {
+            out(std::move(ps.batch));
+            ps.batch = ReplayBatch();
+            ps.batch.ops.reserve(PIPELINE_BATCH_OPS);
+        }
+    };
+    if (!ps.carry.empty()) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', block.size()));
+        ps.carry.append(p, nl ? nl : end);
+        p = nl ? nl + 1 : end;
+        if (nl || last) {
+            parse_replay_line(ps, ps.carry.data(), ps.carry.data() + ps.carry.size());
+            ps.carry.clear();
+            flush_if_full();
+        }
+    }
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (!nl && !last) {
+            ps.carry.assign(p, end);
+            break;
+        }
+        const char* eol = nl ? nl : end;
+        parse_replay_line(ps, p, eol);
+        flush_if_full();
+        p = eol + 1;
+    }
+    if (last && !ps.batch.ops.empty()) {
+        out(std::move(ps.batch));
+        ps.batch = ReplayBatch();
+    }
+}
+
+// --- Validate, apply, emit ---------------------------------------------------------------
+
+inline void validate_batch(ReplayBatch& b, int stores, int items) {
+    for (ReplayOp& op : b.ops) {
+        if (op.kind > REPLAY_REDUCE) continue;
+        if (!int_in_range(op.store, 1, stores)) op.kind = REPLAY_BAD_STORE;
+        else if (op.kind != REPLAY_SHOW && !int_in_range(op.item, 1, items)) op.kind = REPLAY_BAD_ITEM;
+        else if (op.kind != REPLAY_SHOW && op.qty <= 0) op.kind = REPLAY_BAD_QTY;
+    }
+}
+
+inline void apply_batch(StockMatrix& m, ReplayBatch& b) {
+    for (ReplayOp& op : b.ops) {
+        if (op.kind == REPLAY_ADD) {
+            int& c = cell(m, op.store - 1, op.item - 1);
+            if (op.qty > INT_MAX - c) { // the file is not trusted: no signed overflow
+                op.kind = REPLAY_OVERFLOW;
+                continue;
+            }
+            c += op.qty;
+            op.value = c;
+        } else if (op.kind == REPLAY_REDUCE) {
+            int& c = cell(m, op.store - 1, op.item - 1);
+            op.clamped = op.qty > c;
+            op.value = op.clamped ? c : c - op.qty;
+            c = op.clamped ? 0 : c - op.qty;
+        } else if (op.kind == REPLAY_SHOW) {
+            StockView row = store_row(m, op.store - 1);
+            op.value = static_cast<int>(b.rows.size());
+            for (int j = 0; j < row.length; ++j) b.rows.push_back(row[j]);
+        }
+    }
+}
+
+// The menu's messages (week1_task2.cpp), one per operation.
+inline void emit_batch(OutBuffer& out, const ReplayBatch& b, int stores, int items, long long& rejected) {
+    for (const ReplayOp& op : b.ops) {
+        switch (op.kind) {
+            case REPLAY_ADD:
+                out_str(out, "Added ");
+                out_int(out, op.qty);
+                out_str(out, " to store ");
+                out_int(out, op.store);
+                out_str(out, ", item ");
+                out_int(out, op.item);
+                out_str(out, ". New stock: ");
+                out_int(out, op.value);
+                out_char(out, '\n');
+                break;
+            case REPLAY_REDUCE:
+                if (op.clamped) {
+                    out_str(out, "Cannot reduce by ");
+                    out_int(out, op.qty);
+                    out_str(out, " because current stock is ");
+                    out_int(out, op.value);
+                    out_str(out, ". Setting stock to 0.\n");
+                } else {
+                    out_str(out, "Reduced ");
+                    out_int(out, op.qty);
+                    out_str(out, " from store ");
+                    out_int(out, op.store);
+                    out_str(out, ", item ");
+                    out_int(out, op.item);
+                    out_str(out, ". New stock: ");
+                    out_int(out, op.value);
+                    out_char(out, '\n');
+                }
+                break;
+            case REPLAY_SHOW:
+                out_str(out, "Stock for store ");
+                out_int(out, op.store);
+                out_str(out, ":\n");
+                for (int j = 0; j < items; ++j) {
+                    out_str(out, "  Item ");
+                    out_int(out, j + 1);
+                    out_str(out, ": ");
+                    out_int(out, b.rows[op.value + j]);
+                    out_char(out, '\n');
+                }
+                break;
+            default:
+                ++rejected;
+                out_str(out, "Line ");
+                out_int(out, op.line);
+                if (op.kind == REPLAY_BAD_STORE) {
+                    out_str(out, ": invalid store, expected 1-");
+                    out_int(out, stores);
+                } else if (op.kind == REPLAY_BAD_ITEM) {
+                    out_str(out, ": invalid item, expected 1-");
+                    out_int(out, items);
+                } else if (op.kind == REPLAY_BAD_QTY) {
+                    out_str(out, ": invalid quantity, expected a positive integer");
+                } else if (op.kind == REPLAY_OVERFLOW) {
+                    out_str(out, ": quantity would overflow the stock (max ");
+                    out_int(out, INT_MAX);
+                    out_char(out, ')');
+                } else {
+                    out_str(out, ": expected 'add S I Q', 'reduce S I Q' or 'show S'");
+                }
+                out_str(out, ". Skipped.\n");
+                break;
+        }
+    }
+}
+
+// --- Running the stages ------------------------------------------------------------------
+
+// Seconds spent in fn(), added to 'total'.
+template <typename Fn>
+void timed(double& total, Fn fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    total += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Replay the operations read from in_fd into m, writing the messages to
+// out_fd. Returns false (report.ok) on a read error; bad lines are not errors.
+inline bool run_replay(StockMatrix& m, int in_fd, int out_fd, PipelineMode mode, ReplayReport& report) {
+    report = ReplayReport();
+    OutBuffer out;
+    if (!out_init(out, out_fd)) {
+        report.ok = false;
+        return false;
+    }
+    ReplayParser ps;
+    ps.batch.ops.reserve(PIPELINE_BATCH_OPS);
+    auto start = std::chrono::steady_clock::now();
+    double* busy = report.busy;
+
+    if (mode == PipelineMode::Sequential) {
+        // ingest calls parse, parse calls the later stages: subtract the
+        // inner times so every stage is counted once.
+        double parse_in_ingest = 0, later = 0;
+        auto finish = [&](ReplayBatch&& b) {
+            timed(later, [&] {
+                timed(busy[STAGE_VALIDATE], [&] { validate_batch(b, m.stores, m.items); });
+                timed(busy[STAGE_APPLY], [&] { apply_batch(m, b); });
+                timed(busy[STAGE_EMIT], [&] { emit_batch(out, b, m.stores, m.items, report.rejected); });
+            });
+            report.lines += static_cast<long long>(b.ops.size());
+        };
+        auto parse = [&](std::string&& block) {
+            timed(parse_in_ingest, [&] { parse_block(ps, block, false, finish); });
+        };
+        timed(busy[STAGE_INGEST], [&] { report.ok = ingest_fd(in_fd, parse, report.backend); });
+        timed(busy[STAGE_PARSE], [&] { parse_block(ps, std::string(), true, finish); });
+        busy[STAGE_INGEST] -= parse_in_ingest;
+        busy[STAGE_PARSE] += parse_in_ingest - later;
+    } else {
+        SpscQueue<std::string> blocks(PIPELINE_QUEUE_BATCHES);
+        SpscQueue<ReplayBatch> parsed(PIPELINE_QUEUE_BATCHES), valid(PIPELINE_QUEUE_BATCHES),
+            applied(PIPELINE_QUEUE_BATCHES);
+        // Each stage's busy time is its thread's time minus the time spent
+        // waiting on its queues.
+        std::thread ingest([&] {
+            double waiting = 0;
+            auto push = [&](std::string&& block) { timed(waiting, [&] { blocks.push(std::move(block)); }); };
+            timed(busy[STAGE_INGEST], [&] { report.ok = ingest_fd(in_fd, push, report.backend); });
+            blocks.close();
+            busy[STAGE_INGEST] -= waiting;
+        });
+        std::thread parse([&] {
+            double waiting = 0;
+            auto push = [&](ReplayBatch&& b) { timed(waiting, [&] { parsed.push(std::move(b)); }); };
+            timed(busy[STAGE_PARSE], [&] {
+                std::string block;
+                while (true) {
+                    bool more;
+                    timed(waiting, [&] { more = blocks.pop(block); });
+                    if (!more) break;
+                    parse_block(ps, block, false, push);
+                }
+                parse_block(ps, std::string(), true, push);
+            });
+            parsed.close();
+            busy[STAGE_PARSE] -= waiting;
+        });
+        // validate and apply: pop a batch, work on it, pass it on.
+        auto relay = [&](SpscQueue<ReplayBatch>& in, SpscQueue<ReplayBatch>& to, PipelineStage stage, auto work) {
+            double waiting = 0;
+            timed(busy[stage], [&] {
+                ReplayBatch b;
+                while (true) {
+                    bool more;
+                    timed(waiting, [&] { more = in.pop(b); });
+                    if (!more) break;
+                    work(b);
+                    timed(waiting, [&] { to.push(std::move(b)); });
+                }
+            });
+            to.close();
+            busy[stage] -= waiting;
+        };
+        std::thread validate([&] {
+            relay(parsed, valid, STAGE_VALIDATE, [&](ReplayBatch& b) { validate_batch(b, m.stores, m.items); });
+        });
+        std::thread apply([&] { relay(valid, applied, STAGE_APPLY, [&](ReplayBatch& b) { apply_batch(m, b); }); });
+
+        double waiting = 0;
+        timed(busy[STAGE_EMIT], [&] {
+            ReplayBatch b;
+            while (true) {
+                bool more;
+                timed(waiting, [&] { more = applied.pop(b); });
+                if (!more) break;
+                emit_batch(out, b, m.stores, m.items, report.rejected);
+                report.lines += static_cast<long long>(b.ops.size());
+            }
+        });
+        busy[STAGE_EMIT] -= waiting;
+        ingest.join();
+        parse.join();
+        validate.join();
+        apply.join();
+        report.full_waits[STAGE_INGEST] = blocks.full_waits();
+        report.full_waits[STAGE_PARSE] = parsed.full_waits();
+        report.full_waits[STAGE_VALIDATE] = valid.full_waits();
+        report.full_waits[STAGE_APPLY] = applied.full_waits();
+    }
+    timed(busy[STAGE_EMIT], [&] { out_flush(out); });
+    out_free(out);
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report.ok;
+}
+
+#endif // CENG241_LEDGER_PIPELINE_HPP
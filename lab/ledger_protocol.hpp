@@ -0,0 +1,206 @@
+// CENG241 - Wire format of the stock-ledger server (ledger_server.hpp)
+// --------------------------------------------------------------------
+// Every message is a FRAME: a 4-byte length, then that many bytes. The
+// length prefix lets the reader cut a byte stream into messages without
+// looking inside them, so a client may send many requests back to back
+// without waiting for answers (PIPELINING) and read the answers later.
+//
+//   request:   u32 length | u32 id | u8 op | i32 args[arity(op)]
+//   response:  u32 length | u32 id | u8 status | i32 values[...]
+//
+// All integers are little-endian. 'id' is chosen by the client and copied
+// into the response: requests for different stores are served by different
+// worker threads, so answers can come back in a different order than the
+// requests were sent. Requests for the SAME store are answered in order.
+//
+// Operations (arguments -> values on success):
+//   matrix (week1_task2.cpp; store and item are 0-based)
+//     ADD_STOCK     store item qty  -> new stock
+//     REDUCE_STOCK  store item qty  -> new stock, units removed (clamped at 0)
+//     GET_STOCK     store item      -> stock
+//     SHOW_STORE    store           -> stock of every item
+//   inventory (lab_1.cpp)
+//     APPEND        value           -> new size
+//     INSERT_AT     index value     -> new size
+//     DELETE_AT     index           -> new size
+//     FIND          value           -> index or -1
+//     STATS                         -> min, max, size, sum low 32 bits, sum high 32 bits
+//
+// status: 0 = ok, 1 = malformed request, 2 = rejected (bad index / empty).
+
+#ifndef CENG241_LEDGER_PROTOCOL_HPP
+#define CENG241_LEDGER_PROTOCOL_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>    // std::memcpy, std::strncpy
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>   // sockaddr_un
+#include <unistd.h>   // close
+
+enum LedgerOp : unsigned char {
+    LOP_ADD_STOCK = 1,
+    LOP_REDUCE_STOCK,
+    LOP_GET_STOCK,
+    LOP_SHOW_STORE,
+    LOP_APPEND,
+    LOP_INSERT_AT,
+    LOP_DELETE_AT,
+    LOP_FIND,
+    LOP_STATS,
+    LOP_COUNT // number of ops + 1
+};
+
+enum LedgerStatus : unsigned char { LEDGER_OK = 0, LEDGER_MALFORMED = 1, LEDGER_REJECTED = 2 };
+
+const int LEDGER_MAX_ARGS = 3;
+const std::size_t LEDGER_REQUEST_HEAD = 4 + 4 + 1;   // length, id, op
+const std::size_t LEDGER_RESPONSE_HEAD = 4 + 4 + 1;  // length, id, status
+const std::uint32_t LEDGER_MAX_FRAME = 1 << 24;      // larger lengths close the connection
+
+// How many i32 arguments each op takes (-1 for unknown ops).
+inline int ledger_op_arity(unsigned op) {
+    static const int arity[LOP_COUNT] = {-1, 3, 3, 2, 1, 1, 2, 1, 1, 0};
+    return op < LOP_COUNT ? arity[op] : -1;
+}
+
+// True for ops on the StockMatrix (their first argument is the store).
+inline bool ledger_op_is_matrix(unsigned op) {
+    return op >= LOP_ADD_STOCK && op <= LOP_SHOW_STORE;
+}
+
+// --- Little-endian integers ---------------------------------------------------------
+
+inline void put_u32(char* p, std::uint32_t v) {
+    p[0] = static_cast<char>(v);
+    p[1] = static_cast<char>(v >> 8);
+    p[2] = static_cast<char>(v >> 16);
+    p[3] = static_cast<char>(v >> 24);
+}
+
+inline std::uint32_t get_u32(const char* p) {
+    const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<std::uint32_t>(u[0]) | (static_cast<std::uint32_t>(u[1]) << 8) |
+           (static_cast<std::uint32_t>(u[2]) << 16) | (static_cast<std::uint32_t>(u[3]) << 24);
+}
+
+inline void put_i32(char* p, int v) {
+    std::uint32_t u;
+    std::memcpy(&u, &v, sizeof u);
+    put_u32(p, u);
+}
+
+inline int get_i32(const char* p) {
+    std::uint32_t u = get_u32(p);
+    int v;
+    std::memcpy(&v, &u, sizeof v);
+    return v;
+}
+
+// --- Frames ------------------------------------------------------------------------------
+
+struct LedgerRequest {
+    std::uint32_t id;
+    unsigned char op;
+    int           args[LEDGER_MAX_ARGS];
+};
+
+// Append one request frame to 'out'; arguments past the op's arity are ignored.
+inline void encode_request(std::string& out, std::uint32_t id, unsigned char op, int a = 0, int b = 0, int c = 0) {
+    int arity = ledger_op_arity(op);
+    if (arity < 0) arity = 0;
+    const int args[LEDGER_MAX_ARGS] = {a, b, c};
+    char frame[LEDGER_REQUEST_HEAD + 4 * LEDGER_MAX_ARGS];
+    put_u32(frame, static_cast<std::uint32_t>(5 + 4 * arity));
+    put_u32(frame + 4, id);
+    frame[8] = static_cast<char>(op);
+    for (int k = 0; k < LEDGER_MAX_ARGS; ++k) put_i32(frame + LEDGER_REQUEST_HEAD + 4 * k, args[k]);
+    out.append(frame, LEDGER_REQUEST_HEAD + 4 * static_cast<std::size_t>(arity));
+}
+
+// Length of the frame at p (including the 4-byte prefix) if all of it is in
+// [p, p + n), 0 if more bytes are needed.
+inline std::size_t complete_frame(const char* p, std::size_t n) {
+    if (n < 4) return 0;
+    std::size_t len = 4 + static_cast<std::size_t>(get_u32(p));
+    return n >= len ? len : 0;
+}
+
+// Decode a request frame of 'len' bytes; false if it is malformed (the id
+// is still filled in when the frame is long enough to hold one).
+inline bool decode_request(const char* p, std::size_t len, LedgerRequest& r) {
+    r.id = len >= 8 ? get_u32(p + 4) : 0;
+    if (len < LEDGER_REQUEST_HEAD) return false;
+    r.op = static_cast<unsigned char>(p[8]);
+    int arity = ledger_op_arity(r.op);
+    if (arity < 0 || len != LEDGER_REQUEST_HEAD + 4 * static_cast<std::size_t>(arity)) return false;
+    for (int k = 0; k < LEDGER_MAX_ARGS; ++k) r.args[k] = k < arity ? get_i32(p + LEDGER_REQUEST_HEAD + 4 * k) : 0;
+    return true;
+}
+
+// Append a response frame with 'count' values.
+inline void encode_response(std::string& out, std::uint32_t id, unsigned char status, const int* values, int count) {
+    char head[LEDGER_RESPONSE_HEAD];
+    put_u32(head, static_cast<std::uint32_t>(5 + 4 * count));
+    put_u32(head + 4, id);
+    head[8] = static_cast<char>(status);
+    out.append(head, sizeof head);
+    char v[4];
+    for (int k = 0; k < count; ++k) {
+        put_i32(v, values[k]);
+        out.append(v, 4);
+    }
+}
+
+// A decoded response; values point into the receive buffer.
+struct LedgerResponse {
+    std::uint32_t id;
+    unsigned char status;
+    int           count;  // number of values
+    const char*   values; // count little-endian i32s
+};
+
+inline void decode_response(const char* p, std::size_t len, LedgerResponse& r) {
+    r.id = get_u32(p + 4);
+    r.status = static_cast<unsigned char>(p[8]);
+    r.count = static_cast<int>((len - LEDGER_RESPONSE_HEAD) / 4);
+    r.values = p + LEDGER_RESPONSE_HEAD;
+}
+
+inline int response_value(const LedgerResponse& r, int k) {
+    return get_i32(r.values + 4 * k);
+}
+
+// --- Client side ----------------------------------------------------------------------------
+
+// Connect to a server's socket; returns the fd or -1.
+inline int connect_ledger(const char* path) {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof addr.sun_path) return -1;
+    std::strncpy(addr.sun_path, path, sizeof addr.sun_path - 1);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// write(2) all of [p, p + n) to a blocking socket.
+inline bool send_all(int fd, const char* p, std::size_t n) {
+    while (n > 0) {
+        ssize_t w = ::send(fd, p, n, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+#endif // CENG241_LEDGER_PROTOCOL_HPP
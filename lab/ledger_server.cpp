@@ -0,0 +1,48 @@
+// CENG241 - Stock-ledger server program
+// -------------------------------------
+// Serves a stores x items StockMatrix and an Inventory on a Unix domain
+// socket until Ctrl+C (SIGINT) or SIGTERM. Protocol: ledger_protocol.hpp;
+// threads and sharding: ledger_server.hpp. bench_server.cpp is a client
+// that measures throughput and latency.
+//
+// Build & Run:
+// g++ -std=c++17 -O2 -Wall -Wextra -pedantic -pthread -I251009 ledger_server.cpp -o ledger_server
+// ./ledger_server [socket] [stores items] [shards]
+//   (defaults: /tmp/ceng241_ledger.sock, 50 x 200, one shard per core)
+
+#include <iostream>
+#include <csignal>
+#include <cstdlib>
+#include <pthread.h>
+#include "ledger_server.hpp"
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : "/tmp/ceng241_ledger.sock";
+    int stores = argc > 3 ? std::atoi(argv[2]) : 50;
+    int items = argc > 3 ? std::atoi(argv[3]) : 200;
+    int shards = argc > 4 ? std::atoi(argv[4]) : 0;
+
+    // Block the stop signals BEFORE the server threads start (they inherit
+    // the mask), then wait for one here: no handler runs inside a thread
+    // that holds a lock.
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+    LedgerServer server;
+    if (!server.start(path, stores, items, shards)) {
+        std::cout << "Could not start the server on " << path << "\n";
+        return 1;
+    }
+    std::cout << "Serving " << stores << " stores x " << items << " items on " << path
+              << " (Ctrl+C to stop)" << std::endl;
+
+    int sig = 0;
+    sigwait(&stop_signals, &sig);
+    long long served = server.requests_served();
+    server.stop();
+    std::cout << "\nStopped after " << served << " requests.\n";
+    return 0;
+}
@@ -0,0 +1,445 @@
+// CENG241 - Stock-ledger server: the lab operations over a Unix socket
+// --------------------------------------------------------------------
+// The menu programs serve one person at a keyboard. LedgerServer keeps a
+// StockMatrix (week1_task2.cpp) and an Inventory (lab_1.cpp) in memory and
+// serves their operations to any number of local clients, e.g. the
+// point-of-sale terminals, using the binary protocol of ledger_protocol.hpp.
+//
+// Threads:
+//   event loop   ONE thread waits on all sockets with epoll(7): new
+//                connections, readable data, room to write. It cuts the
+//                received bytes into request frames (a read often holds
+//                dozens of pipelined requests) and hands them to a shard.
+//   shards       W worker threads. Store s belongs to shard s % W and
+//                ONLY that thread ever touches its row of the matrix, so the
+//                cells are plain ints: no locks or atomics around the data
+//                (compare concurrent_stock_matrix.hpp). The Inventory
+//                belongs to shard 0. A shard takes all its queued requests
+//                at once, runs them, and sends the answers for one
+//                connection with a single write.
+//
+// Both hand-offs are batched: the loop moves a whole read's worth of
+// requests into a shard queue under one lock, and a shard answers a whole
+// batch per write, so the per-request cost is a few hundred nanoseconds of
+// work, not a system call and a thread wake-up each.
+//
+// If a client stops reading, its answers queue up in the connection's out
+// buffer and the loop writes them when epoll reports room (EPOLLOUT).
+// There is no limit on that buffer; a real server would stop reading from
+// such a client. Changes are not logged to disk (see stock_matrix_wal.hpp).
+//
+// Usage:
+//   LedgerServer server;
+//   server.start("/tmp/ledger.sock", 50, 200, 4);   // stores, items, shards
+//   ...                                             // serve until
+//   server.stop();
+
+#ifndef CENG241_LEDGER_SERVER_HPP
+#define CENG241_LEDGER_SERVER_HPP
+
+#include <atomic>
+#include <climits>  // INT_MAX
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "ledger_protocol.hpp"
+#include "stock_matrix.hpp"
+#include "251009/inventory.hpp"
+
+class LedgerServer {
+public:
+    LedgerServer() = default;
+    ~LedgerServer() { stop(); }
+
+    LedgerServer(const LedgerServer&) = delete;
+    LedgerServer& operator=(const LedgerServer&) = delete;
+
+    // Create the ledgers and start serving on the socket 'path' (an old
+    // socket file there is replaced). 'shards' <= 0 means one per core.
+    bool start(const char* path, int stores, int items, int shards = 0) {
+        if (running_) return false;
+        if (shards <= 0) shards = static_cast<int>(std::thread::hardware_concurrency());
+        if (shards <= 0) shards = 1;
+        if (!create_matrix(stock_, stores, items)) return false;
+        if (!create(inv_, 16)) {
+            destroy_matrix(stock_);
+            return false;
+        }
+        path_ = path;
+        if (!open_sockets()) {
+            close_sockets();
+            destroy_matrix(stock_);
+            destroy(inv_);
+            return false;
+        }
+        stopping_ = false;
+        shards_.reset(new Shard[shards]);
+        shard_count_ = shards;
+        for (int w = 0; w < shards; ++w) shards_[w].thread = std::thread([this, w] { shard_loop(w); });
+        loop_thread_ = std::thread([this] { event_loop(); });
+        running_ = true;
+        return true;
+    }
+
+    // Close every connection, stop the threads and free the ledgers.
+    void stop() {
+        if (!running_) return;
+        stopping_ = true;
+        std::uint64_t one = 1;
+        ssize_t woke = ::write(wake_fd_, &one, sizeof one); // wakes epoll_wait
+        (void)woke;
+        loop_thread_.join();
+        for (int w = 0; w < shard_count_; ++w) {
+            {
+                // A shard between its check of stopping_ and its wait holds
+                // this lock, so it cannot miss the notify below.
+                std::lock_guard<std::mutex> lock(shards_[w].mutex);
+            }
+            shards_[w].cv.notify_one();
+            shards_[w].thread.join();
+        }
+        for (std::shared_ptr<Connection>& c : conns_) { // no shard is running now
+            if (c) close_connection(*c);
+        }
+        conns_.clear();
+        shards_.reset();
+        close_sockets();
+        destroy_matrix(stock_);
+        destroy(inv_);
+        running_ = false;
+    }
+
+    // Requests answered so far (all shards).
+    long long requests_served() const { return served_.load(std::memory_order_relaxed); }
+
+private:
+    struct Connection {
+        int         fd = -1;
+        std::string in;               // received bytes not yet cut into frames (loop thread only)
+        std::mutex  out_mutex;        // guards everything below
+        std::string out;              // answers the socket had no room for
+        bool        closed = false;
+        bool        want_write = false; // EPOLLOUT armed
+    };
+
+    struct Job {
+        std::shared_ptr<Connection> conn;
+        LedgerRequest               request; // op 0 = malformed frame
+    };
+
+    struct Shard {
+        std::mutex              mutex;
+        std::condition_variable cv;
+        std::vector<Job>        jobs;
+        std::thread             thread;
+    };
+
+    std::string path_;
+    int listen_fd_ = -1;
+    int wake_fd_ = -1;
+    int epoll_fd_ = -1;
+    bool running_ = false;
+    std::atomic<bool> stopping_{false};
+    std::atomic<long long> served_{0};
+
+    StockMatrix stock_{};
+    Inventory inv_{nullptr, 0, 0};
+
+    std::unique_ptr<Shard[]> shards_;
+    int shard_count_ = 0;
+    std::thread loop_thread_;
+    std::vector<std::shared_ptr<Connection>> conns_; // indexed by fd (loop thread only)
+
+    // --- Sockets ---------------------------------------------------------------------------
+
+    bool open_sockets() {
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof addr);
+        addr.sun_family = AF_UNIX;
+        if (path_.size() >= sizeof addr.sun_path) return false;
+        std::strncpy(addr.sun_path, path_.c_str(), sizeof addr.sun_path - 1);
+        ::unlink(path_.c_str());
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listen_fd_ < 0 || ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0 ||
+            ::listen(listen_fd_, 128) != 0)
+            return false;
+        wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+        if (wake_fd_ < 0 || epoll_fd_ < 0) return false;
+        return watch(listen_fd_, EPOLLIN, EPOLL_CTL_ADD) && watch(wake_fd_, EPOLLIN, EPOLL_CTL_ADD);
+    }
+
+    void close_sockets() {
+        if (listen_fd_ >= 0) {
+            ::close(listen_fd_);
+            ::unlink(path_.c_str());
+        }
+        if (wake_fd_ >= 0) ::close(wake_fd_);
+        if (epoll_fd_ >= 0) ::close(epoll_fd_);
+        listen_fd_ = wake_fd_ = epoll_fd_ = -1;
+    }
+
+    bool watch(int fd, std::uint32_t events, int how) {
+        epoll_event ev;
+        ev.events = events;
+        ev.data.fd = fd;
+        return ::epoll_ctl(epoll_fd_, how, fd, &ev) == 0;
+    }
+
+    // Any thread; the connection's out_mutex must be held.
+    void close_connection(Connection& c) {
+        if (c.closed) return;
+        c.closed = true;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, c.fd, nullptr);
+        ::close(c.fd); // shards check 'closed' first, so they never write to a reused fd
+    }
+
+    // --- Event loop ---------------------------------------------------------------------------
+
+    void event_loop() {
+        epoll_event events[64];
+        std::vector<std::vector<Job>> batches(shard_count_);
+        while (!stopping_) {
+            int n = ::epoll_wait(epoll_fd_, events, 64, -1);
+            for (int k = 0; k < n; ++k) {
+                int fd = events[k].data.fd;
+                if (fd == wake_fd_) continue; // stop() was called
+                if (fd == listen_fd_) {
+                    accept_all();
+                    continue;
+                }
+                if (fd >= static_cast<int>(conns_.size()) || !conns_[fd]) continue;
+                std::shared_ptr<Connection> c = conns_[fd];
+                if (events[k].events & EPOLLOUT) flush_pending(*c);
+                if (events[k].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    if (!read_requests(c, batches)) {
+                        std::lock_guard<std::mutex> lock(c->out_mutex);
+                        close_connection(*c);
+                        conns_[fd].reset();
+                    }
+                }
+            }
+            // One lock and at most one wake-up per shard for everything read.
+            for (int w = 0; w < shard_count_; ++w) {
+                if (batches[w].empty()) continue;
+                Shard& s = shards_[w];
+                bool was_empty;
+                {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    was_empty = s.jobs.empty();
+                    if (was_empty) s.jobs.swap(batches[w]);
+                    else s.jobs.insert(s.jobs.end(), batches[w].begin(), batches[w].end());
+                }
+                batches[w].clear();
+                if (was_empty) s.cv.notify_one();
+            }
+        }
+    }
+
+    void accept_all() {
+        while (true) {
+            int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return; // EAGAIN: no more waiting
+            if (fd >= static_cast<int>(conns_.size())) conns_.resize(fd + 1);
+            conns_[fd] = std::make_shared<Connection>();
+            conns_[fd]->fd = fd;
+            if (!watch(fd, EPOLLIN, EPOLL_CTL_ADD)) {
+                ::close(fd);
+                conns_[fd].reset();
+            }
+        }
+    }
+
+    // Shard for a request: the store's owner for matrix ops, else shard 0.
+    int shard_of(const LedgerRequest& r) const {
+        if (!ledger_op_is_matrix(r.op) || r.args[0] < 0) return 0;
+        return r.args[0] % shard_count_;
+    }
+
+    // Read what is there, cut it into frames, queue them. False: close.
+    bool read_requests(const std::shared_ptr<Connection>& c, std::vector<std::vector<Job>>& batches) {
+        char buf[1 << 16];
+        ssize_t r = ::read(c->fd, buf, sizeof buf);
+        if (r == 0) return false; // client closed
+        if (r < 0) return errno == EAGAIN || errno == EINTR;
+        c->in.append(buf, static_cast<std::size_t>(r));
+
+        std::size_t pos = 0;
+        while (true) {
+            const char* p = c->in.data() + pos;
+            std::size_t left = c->in.size() - pos;
+            if (left >= 4 && get_u32(p) > LEDGER_MAX_FRAME) return false;
+            std::size_t len = complete_frame(p, left);
+            if (len == 0) break;
+            Job job{c, LedgerRequest{0, 0, {0, 0, 0}}};
+            if (!decode_request(p, len, job.request)) job.request.op = 0;
+            batches[shard_of(job.request)].push_back(std::move(job));
+            pos += len;
+        }
+        c->in.erase(0, pos);
+        return true;
+    }
+
+    // EPOLLOUT: the socket has room again.
+    void flush_pending(Connection& c) {
+        std::lock_guard<std::mutex> lock(c.out_mutex);
+        if (c.closed) return;
+        write_some(c, c.out.data(), c.out.size());
+        if (c.out.empty() && c.want_write) {
+            c.want_write = false;
+            watch(c.fd, EPOLLIN, EPOLL_CTL_MOD);
+        }
+    }
+
+    // Write as much of [p, p + n) as the socket takes; keep the rest in c.out.
+    // out_mutex must be held. p may point into c.out itself.
+    void write_some(Connection& c, const char* p, std::size_t n) {
+        std::size_t done = 0;
+        while (done < n) {
+            ssize_t w = ::send(c.fd, p + done, n - done, MSG_NOSIGNAL);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) break; // EAGAIN (full) or a dead peer; the loop sees the latter
+            done += static_cast<std::size_t>(w);
+        }
+        if (p == c.out.data()) c.out.erase(0, done);
+        else c.out.append(p + done, n - done);
+    }
+
+    // --- Shards -----------------------------------------------------------------------------
+
+    // Send a shard's answers for one connection.
+    void send_answers(Connection& c, const std::string& answers) {
+        std::lock_guard<std::mutex> lock(c.out_mutex);
+        if (c.closed || answers.empty()) return;
+        if (c.out.empty()) write_some(c, answers.data(), answers.size());
+        else c.out += answers; // keep the order: older bytes first
+        if (!c.out.empty() && !c.want_write) {
+            c.want_write = true;
+            watch(c.fd, EPOLLIN | EPOLLOUT, EPOLL_CTL_MOD);
+        }
+    }
+
+    void shard_loop(int w) {
+        Shard& s = shards_[w];
+        std::vector<Job> jobs;
+        std::string answers;
+        std::vector<int> row;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(s.mutex);
+                s.cv.wait(lock, [&] { return !s.jobs.empty() || stopping_; });
+                if (s.jobs.empty()) return; // stopping
+                jobs.swap(s.jobs);
+            }
+            Connection* current = nullptr;
+            for (Job& job : jobs) {
+                if (job.conn.get() != current) {
+                    if (current) send_answers(*current, answers);
+                    answers.clear();
+                    current = job.conn.get();
+                }
+                execute(job.request, answers, row);
+            }
+            if (current) send_answers(*current, answers);
+            answers.clear();
+            served_.fetch_add(static_cast<long long>(jobs.size()), std::memory_order_relaxed);
+            jobs.clear(); // drops the connection references
+        }
+    }
+
+    // Run one request on the ledgers and append its answer. Only the
+    // owning shard calls this for a given store (shard 0 for the Inventory).
+    void execute(const LedgerRequest& r, std::string& answers, std::vector<int>& row) {
+        int v[5];
+        const int* a = r.args;
+        if (r.op == 0) {
+            encode_response(answers, r.id, LEDGER_MALFORMED, nullptr, 0);
+            return;
+        }
+        if (ledger_op_is_matrix(r.op)) {
+            bool store_ok = a[0] >= 0 && a[0] < stock_.stores;
+            bool item_ok = r.op == LOP_SHOW_STORE || (a[1] >= 0 && a[1] < stock_.items);
+            bool qty_ok = (r.op != LOP_ADD_STOCK && r.op != LOP_REDUCE_STOCK) || a[2] > 0;
+            if (!store_ok || !item_ok || !qty_ok) {
+                encode_response(answers, r.id, LEDGER_REJECTED, nullptr, 0);
+                return;
+            }
+        }
+        switch (r.op) {
+            case LOP_ADD_STOCK: {
+                // a[2] comes from the client: refuse anything that would
+                // overflow the cell instead of running into signed overflow.
+                int& current = cell(stock_, a[0], a[1]);
+                if (a[2] > INT_MAX - current) {
+                    encode_response(answers, r.id, LEDGER_REJECTED, nullptr, 0);
+                    return;
+                }
+                v[0] = (current += a[2]);
+                encode_response(answers, r.id, LEDGER_OK, v, 1);
+                return;
+            }
+            case LOP_REDUCE_STOCK: {
+                // Same rule as reduce_stock in week1_task2.cpp: clamp at zero.
+                int& current = cell(stock_, a[0], a[1]);
+                v[1] = a[2] < current ? a[2] : current;
+                v[0] = (current -= v[1]);
+                encode_response(answers, r.id, LEDGER_OK, v, 2);
+                return;
+            }
+            case LOP_GET_STOCK:
+                v[0] = cell(stock_, a[0], a[1]);
+                encode_response(answers, r.id, LEDGER_OK, v, 1);
+                return;
+            case LOP_SHOW_STORE: {
+                StockView view = store_row(stock_, a[0]);
+                row.resize(view.length);
+                for (int i = 0; i < view.length; ++i) row[i] = view[i];
+                encode_response(answers, r.id, LEDGER_OK, row.data(), view.length);
+                return;
+            }
+            case LOP_APPEND:
+                if (!append(inv_, a[0])) break;
+                v[0] = inv_.size;
+                encode_response(answers, r.id, LEDGER_OK, v, 1);
+                return;
+            case LOP_INSERT_AT:
+                // Checked here so insert_at / delete_at never print.
+                if (a[0] < 0 || a[0] > inv_.size || !insert_at(inv_, a[0], a[1])) break;
+                v[0] = inv_.size;
+                encode_response(answers, r.id, LEDGER_OK, v, 1);
+                return;
+            case LOP_DELETE_AT:
+                if (a[0] < 0 || a[0] >= inv_.size || !delete_at(inv_, a[0])) break;
+                v[0] = inv_.size;
+                encode_response(answers, r.id, LEDGER_OK, v, 1);
+                return;
+            case LOP_FIND:
+                v[0] = find(inv_, a[0]);
+                encode_response(answers, r.id, LEDGER_OK, v, 1);
+                return;
+            case LOP_STATS: {
+                if (inv_.size == 0) break;
+                MinMaxSum m = inventory_kernels().minmaxsum(inv_.data, inv_.size);
+                std::uint64_t sum = static_cast<std::uint64_t>(m.sum);
+                std::uint32_t half[2] = {static_cast<std::uint32_t>(sum), static_cast<std::uint32_t>(sum >> 32)};
+                v[0] = m.min;
+                v[1] = m.max;
+                v[2] = inv_.size;
+                std::memcpy(&v[3], half, sizeof half); // the 64-bit sum as two i32 words
+                encode_response(answers, r.id, LEDGER_OK, v, 5);
+                return;
+            }
+            default:
+                break;
+        }
+        encode_response(answers, r.id, LEDGER_REJECTED, nullptr, 0);
+    }
+};
+
+#endif // CENG241_LEDGER_SERVER_HPP
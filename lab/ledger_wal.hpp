@@ -0,0 +1,538 @@
+// CENG241 - Write-ahead log (WAL) with group commit and snapshot recovery
+// -----------------------------------------------------------------------
+// The ledgers live in memory: a crash loses every change since the program
+// started. Writing the whole ledger to disk after each change would be far
+// too slow, so databases use a *write-ahead log*: every change is appended
+// to a log file as a tiny record ("append 25", "add_stock 3 1 10"). After a
+// crash the program loads the last full copy of the ledger (the *snapshot*)
+// and replays the log on top of it.
+//
+// Making a record durable needs fsync()/fdatasync(), which waits for the
+// disk: roughly 50-500 microseconds on an SSD. One fsync per operation
+// would cap us at a few thousand operations per second. *Group commit*
+// fixes this: records are collected in memory and ONE background flusher
+// thread writes and syncs them together. One fsync then covers every
+// record logged while the previous one was running, so throughput grows
+// with load instead of being capped by the disk latency.
+//
+//   log()          appends a record to the in-memory group, returns its
+//                  sequence number (LSN) immediately
+//   wait_durable() blocks until that LSN is on disk
+//   sync()         waits for everything logged so far
+//
+// A group is flushed when it holds `group_ops` records, when `max_delay_us`
+// has passed, or as soon as somebody waits for it.
+//
+// WAL file layout:
+//
+//   WalFileHeader (16 bytes): magic "CENGWAL1", version, generation
+//   frame, frame, ...   one frame per group commit:
+//     WalFrameHeader (16 bytes): payload bytes, record count, checksum
+//     payload: the encoded records
+//
+// Records are compact: one opcode byte, then each argument as a zigzag
+// varint (small numbers take one byte, negatives stay small too). A typical
+// "append 25" is 2 bytes.
+//
+// A crash can leave the last frame half written. Replay stops at the first
+// frame whose length or checksum does not match; that frame was never
+// reported durable, so nothing acknowledged is lost.
+//
+// Snapshots and generations: a checkpoint writes the whole ledger to a new
+// ledger file (ledger_file.hpp) whose header carries generation G+1, renames
+// it over the old snapshot, then restarts the log with generation G+1.
+// Recovery replays the log only if its generation matches the snapshot's;
+// a log with an older generation was already folded into the snapshot (the
+// crash happened between the rename and the log restart) and is discarded.
+//
+// POSIX only. Functions return false on failure, like the rest of the lab.
+
+#ifndef CENG241_LEDGER_WAL_HPP
+#define CENG241_LEDGER_WAL_HPP
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>  // std::rename
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ledger_file.hpp"
+
+// --- Records -----------------------------------------------------------
+
+enum WalOp : unsigned char {
+    WAL_CREATE = 1,   // a = initial capacity
+    WAL_APPEND,       // a = stock
+    WAL_INSERT_AT,    // a = index, b = stock
+    WAL_DELETE_AT,    // a = index
+    WAL_RESERVE,      // a = new capacity
+    WAL_SORT_ASC,
+    WAL_REVERSE,
+    WAL_ADD_STOCK,    // a = store, b = item, c = qty
+    WAL_REDUCE_STOCK, // a = store, b = item, c = qty (clamped at zero)
+    WAL_OP_COUNT
+};
+
+struct WalRecord {
+    unsigned char op;
+    int a;
+    int b;
+    int c;
+};
+
+const int WAL_MAX_RECORD_BYTES = 1 + 3 * 5; // opcode + three 5-byte varints
+
+inline int wal_op_arity(unsigned char op) {
+    switch (op) {
+        case WAL_CREATE: case WAL_APPEND: case WAL_DELETE_AT: case WAL_RESERVE:
+            return 1;
+        case WAL_INSERT_AT:
+            return 2;
+        case WAL_ADD_STOCK: case WAL_REDUCE_STOCK:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+// Zigzag maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ... so small negatives stay
+// small; the varint then stores 7 bits per byte, high bit = "more follows".
+inline unsigned char* wal_put_varint(unsigned char* p, int v) {
+    std::uint32_t u = (static_cast<std::uint32_t>(v) << 1) ^ static_cast<std::uint32_t>(v >> 31);
+    while (u >= 0x80) {
+        *p++ = static_cast<unsigned char>(u | 0x80);
+        u >>= 7;
+    }
+    *p++ = static_cast<unsigned char>(u);
+    return p;
+}
+
+// Returns nullptr if the varint runs past 'end' or is longer than 5 bytes.
+inline const unsigned char* wal_get_varint(const unsigned char* p, const unsigned char* end, int& v) {
+    std::uint32_t u = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p == end) return nullptr;
+        unsigned char byte = *p++;
+        u |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            v = static_cast<int>((u >> 1) ^ (0u - (u & 1)));
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+// Encode into p (room for WAL_MAX_RECORD_BYTES); returns the end.
+inline unsigned char* wal_encode(unsigned char* p, const WalRecord& r) {
+    *p++ = r.op;
+    int arity = wal_op_arity(r.op);
+    if (arity > 0) p = wal_put_varint(p, r.a);
+    if (arity > 1) p = wal_put_varint(p, r.b);
+    if (arity > 2) p = wal_put_varint(p, r.c);
+    return p;
+}
+
+inline const unsigned char* wal_decode(const unsigned char* p, const unsigned char* end, WalRecord& r) {
+    if (p == end) return nullptr;
+    r = WalRecord{*p++, 0, 0, 0};
+    if (r.op == 0 || r.op >= WAL_OP_COUNT) return nullptr;
+    int arity = wal_op_arity(r.op);
+    if (arity > 0 && !(p = wal_get_varint(p, end, r.a))) return nullptr;
+    if (arity > 1 && !(p = wal_get_varint(p, end, r.b))) return nullptr;
+    if (arity > 2 && !(p = wal_get_varint(p, end, r.c))) return nullptr;
+    return p;
+}
+
+// --- File format -------------------------------------------------------
+
+const char WAL_FILE_MAGIC[8] = {'C', 'E', 'N', 'G', 'W', 'A', 'L', '1'};
+const std::uint32_t WAL_FILE_VERSION = 1;
+
+struct WalFileHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t generation; // matches the snapshot this log continues
+};
+
+struct WalFrameHeader {
+    std::uint32_t bytes;    // payload bytes after this header
+    std::uint32_t count;    // records in the payload
+    std::uint64_t checksum; // ledger_checksum of the payload
+};
+static_assert(sizeof(WalFileHeader) == 16 && sizeof(WalFrameHeader) == 16, "fixed on-disk sizes");
+
+// Write all of [data, data + bytes), retrying short writes.
+inline bool wal_write_all(int fd, const void* data, std::size_t bytes) {
+    const char* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t w = ::write(fd, p, bytes);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += w;
+        bytes -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+// fdatasync skips metadata such as the modification time; enough for a log.
+inline bool wal_data_sync(int fd) {
+#ifdef __linux__
+    return ::fdatasync(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+// A new or renamed file is only durable once its directory entry is synced.
+inline bool ledger_sync_parent_dir(const std::string& path) {
+    std::string::size_type slash = path.rfind('/');
+    std::string dir = (slash == std::string::npos) ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+// What wal_replay found. valid_bytes is where WriteAheadLog::open continues.
+struct WalReplayInfo {
+    bool          found;       // a log file exists
+    bool          stale;       // its generation is older than the snapshot: ignored
+    bool          torn_tail;   // an incomplete last frame was dropped
+    std::uint64_t records;     // records passed to fn
+    std::uint64_t valid_bytes; // header + complete frames
+};
+
+// Read the log at 'path' and call fn(const WalRecord&) -> bool for every
+// record, if the log continues snapshot 'generation'. Returns false if the
+// log is unreadable, belongs to a newer snapshot, or fn rejects a record.
+// A missing log is fine (nothing to replay).
+template <typename Fn>
+bool wal_replay(const char* path, std::uint32_t generation, WalReplayInfo& info, Fn fn) {
+    info = WalReplayInfo{false, false, false, 0, 0};
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return errno == ENOENT;
+    struct stat st;
+    std::vector<unsigned char> buf;
+    bool ok = ::fstat(fd, &st) == 0;
+    if (ok) {
+        buf.resize(static_cast<std::size_t>(st.st_size));
+        std::size_t got = 0;
+        while (ok && got < buf.size()) {
+            ssize_t r = ::read(fd, buf.data() + got, buf.size() - got);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) ok = false;
+            else got += static_cast<std::size_t>(r);
+        }
+    }
+    ::close(fd);
+    if (!ok) return false;
+    info.found = true;
+
+    WalFileHeader h;
+    if (buf.size() < sizeof h) { // crashed while creating the log
+        info.torn_tail = !buf.empty();
+        return true;
+    }
+    std::memcpy(&h, buf.data(), sizeof h);
+    if (std::memcmp(h.magic, WAL_FILE_MAGIC, sizeof h.magic) != 0 || h.version != WAL_FILE_VERSION) return false;
+    if (h.generation > generation) return false; // the snapshot it belongs to is missing
+    if (h.generation < generation) {
+        info.stale = true;
+        return true;
+    }
+
+    std::size_t pos = sizeof h;
+    while (pos + sizeof(WalFrameHeader) <= buf.size()) {
+        WalFrameHeader fh;
+        std::memcpy(&fh, buf.data() + pos, sizeof fh);
+        const unsigned char* p = buf.data() + pos + sizeof fh;
+        if (fh.bytes > buf.size() - pos - sizeof fh || ledger_checksum(p, fh.bytes) != fh.checksum) break;
+        const unsigned char* end = p + fh.bytes;
+        for (std::uint32_t k = 0; k < fh.count; ++k) {
+            WalRecord r;
+            p = wal_decode(p, end, r);
+            if (!p || !fn(r)) return false; // checksum matched, so this is not a torn write
+            ++info.records;
+        }
+        if (p != end) return false;
+        pos += sizeof fh + fh.bytes;
+    }
+    info.valid_bytes = pos;
+    info.torn_tail = pos != buf.size();
+    return true;
+}
+
+// --- Group-commit writer -----------------------------------------------
+
+struct WalOptions {
+    int group_ops = 4096;    // flush as soon as this many records are waiting
+    int max_delay_us = 1000; // ... or after this long
+};
+
+class WriteAheadLog {
+public:
+    WriteAheadLog() = default;
+    ~WriteAheadLog() { close(); }
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Open 'path' for appending after recovery. valid_bytes comes from
+    // wal_replay (it cuts off a torn tail); 0 or a stale log starts a fresh
+    // log for 'generation'.
+    bool open(const char* path, std::uint32_t generation, std::uint64_t valid_bytes, WalOptions options = WalOptions()) {
+        close();
+        options_ = options;
+        if (options_.group_ops < 1) options_.group_ops = 1;
+        fd_ = ::open(path, O_RDWR | O_CREAT | O_APPEND, 0644); // O_APPEND: every write goes to the end
+        if (fd_ < 0) return false;
+        bool ok = (valid_bytes >= sizeof(WalFileHeader))
+                ? ::ftruncate(fd_, static_cast<off_t>(valid_bytes)) == 0 && wal_data_sync(fd_)
+                : ::ftruncate(fd_, 0) == 0 && start_file(generation) && ledger_sync_parent_dir(path);
+        if (!ok) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        generation_ = generation;
+        next_lsn_ = 1;
+        durable_lsn_ = 0;
+        failed_ = false;
+        stop_ = false;
+        urgent_ = false;
+        pending_.assign(sizeof(WalFrameHeader), 0); // room for the frame header
+        pending_count_ = 0;
+        fsyncs_ = 0;
+        flusher_ = std::thread([this] { flusher_loop(); });
+        return true;
+    }
+
+    bool is_open() const { return fd_ >= 0; }
+
+    // Add a record to the current group. Returns its LSN, or 0 if the log
+    // is closed or a previous write failed.
+    std::uint64_t log(const WalRecord& r) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fd_ < 0 || failed_) return 0;
+        std::size_t at = pending_.size();
+        pending_.resize(at + WAL_MAX_RECORD_BYTES);
+        unsigned char* end = wal_encode(pending_.data() + at, r);
+        pending_.resize(static_cast<std::size_t>(end - pending_.data()));
+        if (++pending_count_ == options_.group_ops) wake_cv_.notify_one();
+        return next_lsn_++;
+    }
+
+    // Block until record 'lsn' is on disk. False if writing it failed, or
+    // for lsn 0 (what log() returns when the record was not taken).
+    bool wait_durable(std::uint64_t lsn) {
+        if (lsn == 0) return false;
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (durable_lsn_ >= lsn) return true;
+        urgent_ = true; // don't wait for max_delay_us: someone is blocked
+        wake_cv_.notify_one();
+        durable_cv_.wait(lock, [&] { return durable_lsn_ >= lsn || failed_; });
+        return durable_lsn_ >= lsn;
+    }
+
+    // Wait for every record logged so far.
+    bool sync() {
+        std::uint64_t last;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (fd_ < 0) return false;
+            if (failed_) return false;
+            last = next_lsn_ - 1;
+        }
+        return last == 0 || wait_durable(last); // nothing logged yet: trivially synced
+    }
+
+    // After a checkpoint: empty the log and tag it with the new snapshot's
+    // generation. No other thread may log while this runs.
+    bool restart(std::uint32_t generation) {
+        if (!sync()) return false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (::ftruncate(fd_, 0) != 0 || !start_file(generation)) {
+            failed_ = true;
+            return false;
+        }
+        generation_ = generation;
+        return true;
+    }
+
+    // Sync what is left and stop the flusher.
+    bool close() {
+        if (fd_ < 0) return true;
+        bool ok = sync();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_cv_.notify_one();
+        flusher_.join();
+        ok = (::close(fd_) == 0) && ok;
+        fd_ = -1;
+        return ok;
+    }
+
+    std::uint32_t generation() const { return generation_; }
+    // Number of fsyncs so far; records / fsyncs is the group-commit factor.
+    std::uint64_t fsyncs() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return fsyncs_;
+    }
+
+private:
+    int fd_ = -1;
+    WalOptions options_;
+    std::uint32_t generation_ = 0;
+    std::thread flusher_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_cv_;    // flusher waits here for work
+    std::condition_variable durable_cv_; // wait_durable waits here
+    std::vector<unsigned char> pending_; // frame header + records of the open group
+    std::vector<unsigned char> writing_; // the group being written
+    int pending_count_ = 0;
+    std::uint64_t next_lsn_ = 1;
+    std::uint64_t durable_lsn_ = 0;
+    std::uint64_t fsyncs_ = 0;
+    bool failed_ = false;
+    bool stop_ = false;
+    bool urgent_ = false;
+
+    bool start_file(std::uint32_t generation) {
+        WalFileHeader h;
+        std::memcpy(h.magic, WAL_FILE_MAGIC, sizeof h.magic);
+        h.version = WAL_FILE_VERSION;
+        h.generation = generation;
+        return wal_write_all(fd_, &h, sizeof h) && wal_data_sync(fd_);
+    }
+
+    void flusher_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_cv_.wait_for(lock, std::chrono::microseconds(options_.max_delay_us), [this] {
+                return stop_ || urgent_ || pending_count_ >= options_.group_ops;
+            });
+            urgent_ = false;
+            if (pending_count_ == 0) {
+                if (stop_) return;
+                continue;
+            }
+            // Take the whole group; new records go into a fresh buffer while
+            // this one is written, so log() never waits for the disk.
+            writing_.swap(pending_);
+            pending_.assign(sizeof(WalFrameHeader), 0);
+            WalFrameHeader fh;
+            fh.bytes = static_cast<std::uint32_t>(writing_.size() - sizeof fh);
+            fh.count = static_cast<std::uint32_t>(pending_count_);
+            fh.checksum = ledger_checksum(writing_.data() + sizeof fh, fh.bytes);
+            std::memcpy(writing_.data(), &fh, sizeof fh);
+            std::uint64_t last = next_lsn_ - 1;
+            pending_count_ = 0;
+
+            lock.unlock();
+            bool ok = wal_write_all(fd_, writing_.data(), writing_.size()) && wal_data_sync(fd_);
+            lock.lock();
+
+            if (!ok) {
+                // The file now ends in a partial frame that replay stops at,
+                // so nothing written after it could be recovered: drop what
+                // is queued, keep durable_lsn_ where it is and stop for good.
+                failed_ = true;
+                pending_.assign(sizeof(WalFrameHeader), 0);
+                pending_count_ = 0;
+                durable_cv_.notify_all();
+                return;
+            }
+            durable_lsn_ = last;
+            ++fsyncs_;
+            durable_cv_.notify_all();
+        }
+    }
+};
+
+// --- Snapshots ---------------------------------------------------------
+
+// Write a complete ledger file: 'shape' supplies kind, size, capacity,
+// matrix fields and generation; 'payload' holds shape.capacity ints. The
+// file is written under a temporary name and renamed over 'path', so a
+// crash leaves either the old or the new snapshot, never a mix.
+inline bool ledger_snapshot_write(const std::string& path, const LedgerFileHeader& shape, const int* payload) {
+    std::string tmp = path + ".tmp";
+    MappedFile f;
+    if (!ledger_file_create(f, tmp.c_str(), static_cast<LedgerFileKind>(shape.kind), shape.capacity)) return false;
+    LedgerFileHeader& h = *f.header;
+    h.size = shape.size;
+    h.stores = shape.stores;
+    h.items = shape.items;
+    h.layout = shape.layout;
+    h.ld = shape.ld;
+    h.generation = shape.generation;
+    if (shape.capacity > 0) std::memcpy(f.payload, payload, shape.capacity * sizeof(int));
+    // ledger_file_close stores the checksum, sets FLAG_CLEAN and msyncs.
+    if (!ledger_file_close(f)) return false;
+    return std::rename(tmp.c_str(), path.c_str()) == 0 && ledger_sync_parent_dir(path);
+}
+
+// Snapshots are read with read(2), not mapped: they are copied into the
+// ledger's own memory anyway, and the file is never modified.
+struct SnapshotReader {
+    int              fd;
+    LedgerFileHeader header;
+};
+
+// Returns 1 if the snapshot is open, 0 if there is none, -1 if it is bad.
+inline int ledger_snapshot_open(SnapshotReader& s, const char* path, LedgerFileKind kind) {
+    s.fd = ::open(path, O_RDONLY);
+    if (s.fd < 0) return errno == ENOENT ? 0 : -1;
+    struct stat st;
+    const LedgerFileHeader& h = s.header;
+    bool ok = ::fstat(s.fd, &st) == 0
+           && ::pread(s.fd, &s.header, sizeof s.header, 0) == static_cast<ssize_t>(sizeof s.header)
+           && std::memcmp(h.magic, LEDGER_FILE_MAGIC, sizeof h.magic) == 0
+           && h.version == LEDGER_FILE_VERSION
+           && h.kind == static_cast<std::uint32_t>(kind)
+           && (h.flags & FLAG_CLEAN) // snapshots are always closed cleanly
+           && h.size <= h.capacity
+           && sizeof(LedgerFileHeader) + h.capacity * sizeof(int) == static_cast<std::uint64_t>(st.st_size);
+    if (!ok) {
+        ::close(s.fd);
+        s.fd = -1;
+        return -1;
+    }
+    return 1;
+}
+
+// Read the payload (header.capacity ints) into dst, check it and close.
+inline bool ledger_snapshot_read(SnapshotReader& s, int* dst) {
+    std::size_t bytes = s.header.capacity * sizeof(int);
+    std::size_t got = 0;
+    char* p = reinterpret_cast<char*>(dst);
+    while (got < bytes) {
+        ssize_t r = ::pread(s.fd, p + got, bytes - got, static_cast<off_t>(sizeof(LedgerFileHeader) + got));
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) break;
+        got += static_cast<std::size_t>(r);
+    }
+    ::close(s.fd);
+    s.fd = -1;
+    return got == bytes && ledger_checksum(dst, bytes) == s.header.checksum;
+}
+
+inline void ledger_snapshot_close(SnapshotReader& s) {
+    if (s.fd >= 0) ::close(s.fd);
+    s.fd = -1;
+}
+
+#endif // CENG241_LEDGER_WAL_HPP
@@ -0,0 +1,123 @@
+// CENG241 - OutBuffer: formatted output without iostreams
+// ---------------------------------------------------------
+// Writing numbers through std::cout costs a stream state check, a locale
+// lookup and a small copy for every `<<`; `endl` adds a flush, i.e. one
+// system call per line. An OutBuffer is one large block (1 MiB by default)
+// filled with std::to_chars (no locale, no allocation) and handed to the
+// kernel with a single write(2) whenever it is full. Keep it and reuse it:
+// it allocates only in out_init.
+//
+// It writes straight to the file descriptor, so text still waiting in
+// std::cout's buffer has to go first: call std::cout.flush() before
+// printing to fd 1 (stdout_buffer() users do).
+//
+// Used by print_inventory (251009/inventory.hpp) and by the exporters in
+// ledger_export.hpp.
+
+#ifndef CENG241_OUT_BUFFER_HPP
+#define CENG241_OUT_BUFFER_HPP
+
+#include <cerrno>
+#include <charconv> // std::to_chars
+#include <cstddef>
+#include <cstring>  // std::memcpy, std::strlen
+#include <new>      // std::nothrow
+#include <unistd.h> // write
+
+const std::size_t OUT_BUFFER_BYTES = 1 << 20;
+
+struct OutBuffer {
+    int         fd = -1;
+    char*       data = nullptr;
+    std::size_t used = 0;
+    std::size_t capacity = 0;
+    bool        failed = false; // a write(2) failed; later output is dropped
+};
+
+// --- Buffer ------------------------------------------------------------------------
+
+inline bool out_init(OutBuffer& out, int fd, std::size_t capacity = OUT_BUFFER_BYTES) {
+    if (capacity < 64) capacity = 64; // room for the longest single item
+    if (out.capacity != capacity) { // reuse the old block when possible
+        delete[] out.data;
+        out.data = new (std::nothrow) char[capacity];
+        out.capacity = out.data ? capacity : 0;
+    }
+    out.fd = fd;
+    out.used = 0;
+    out.failed = out.data == nullptr;
+    return !out.failed;
+}
+
+inline bool out_flush(OutBuffer& out) {
+    std::size_t done = 0;
+    while (!out.failed && done < out.used) {
+        ssize_t w = ::write(out.fd, out.data + done, out.used - done);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) out.failed = true;
+        else done += static_cast<std::size_t>(w);
+    }
+    out.used = 0;
+    return !out.failed;
+}
+
+inline void out_free(OutBuffer& out) {
+    delete[] out.data;
+    out.data = nullptr;
+    out.used = 0;
+    out.capacity = 0;
+}
+
+// Make room for n more bytes (n <= capacity). The writers below drop their
+// output when the buffer has no block (out_init failed) or a write failed.
+inline void out_reserve(OutBuffer& out, std::size_t n) {
+    if (out.used + n > out.capacity) out_flush(out);
+}
+
+inline void out_bytes(OutBuffer& out, const void* p, std::size_t n) {
+    if (!out.data || out.failed) return;
+    const char* c = static_cast<const char*>(p);
+    if (out.used + n <= out.capacity) { // the common case: fits as is
+        std::memcpy(out.data + out.used, c, n);
+        out.used += n;
+        return;
+    }
+    while (n > 0) {
+        out_reserve(out, 1);
+        std::size_t part = out.capacity - out.used < n ? out.capacity - out.used : n;
+        std::memcpy(out.data + out.used, c, part);
+        out.used += part;
+        c += part;
+        n -= part;
+    }
+}
+
+inline void out_str(OutBuffer& out, const char* s) {
+    out_bytes(out, s, std::strlen(s));
+}
+
+inline void out_char(OutBuffer& out, char c) {
+    if (!out.data || out.failed) return;
+    out_reserve(out, 1);
+    out.data[out.used++] = c;
+}
+
+inline void out_int(OutBuffer& out, long long v) {
+    if (!out.data || out.failed) return;
+    out_reserve(out, 24);
+    out.used = static_cast<std::size_t>(std::to_chars(out.data + out.used, out.data + out.capacity, v).ptr - out.data);
+}
+
+// --- stdout ----------------------------------------------------------------------------
+
+// The buffer for stdout, kept between calls so paging allocates only once.
+inline OutBuffer& stdout_buffer() {
+    static OutBuffer out;
+    if (!out.data) {
+        if (!out_init(out, 1)) return out; // failed stays set: output is dropped
+    }
+    out.failed = false;
+    return out;
+}
+
+#endif // CENG241_OUT_BUFFER_HPP
@@ -0,0 +1,179 @@
+// CENG241 - SpscQueue: a bounded lock-free queue between two pipeline stages
+// -------------------------------------------------------------------------
+// Exactly ONE thread pushes and exactly ONE thread pops (single producer,
+// single consumer). That is all a pipeline stage needs, and it means no
+// lock and no compare-and-swap: the slots form a ring, the producer only
+// writes 'tail_', the consumer only writes 'head_'.
+//
+//   slots:   [ . . A B C D . . ]      head_ -> A (next to pop)
+//                                     tail_ -> first '.' after D (next to push)
+//
+//   push   write the slot at tail_, THEN publish tail_ + 1 (release), so the
+//          consumer that sees the new tail also sees the slot's contents.
+//   pop    read the slot at head_, THEN publish head_ + 1 (release), so the
+//          producer only reuses the slot after the consumer is done with it.
+//
+// Each index lives on its own cache line, next to a cached copy of the
+// OTHER index: the producer re-reads head_ (a line the consumer is writing)
+// only when its cached copy says the ring is full, and vice versa.
+//
+// The queue is BOUNDED: a fast producer that fills it waits in push() until
+// the consumer catches up. That wait is the backpressure that keeps a fast
+// stage from running ahead and filling memory. Waiting spins briefly,
+// yields the CPU a few times and then sleeps on a condition variable until
+// the other side moves (a stage fed from a terminal may wait for minutes;
+// it must not burn a core doing so). The lock-free path only pays for a
+// fence and one load of the other side's "parked" flag; the mutex is
+// touched only when somebody is actually asleep. full_waits() /
+// empty_waits() count how often each side had to wait, which shows the
+// slowest stage.
+
+#ifndef CENG241_SPSC_QUEUE_HPP
+#define CENG241_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>  // std::this_thread::yield
+#include <utility> // std::move
+#include <vector>
+
+template <typename T>
+class SpscQueue {
+public:
+    // Room for at least 'capacity' items (rounded up to a power of two).
+    explicit SpscQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) size *= 2;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer: move v in unless the ring is full.
+    bool try_push(T& v) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) return false;
+        }
+        slots_[tail & mask_] = std::move(v);
+        tail_.store(tail + 1, std::memory_order_release);
+        wake(consumer_parked_);
+        return true;
+    }
+
+    // Consumer: move the oldest item out unless the ring is empty.
+    bool try_pop(T& out) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) return false;
+        }
+        out = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        wake(producer_parked_);
+        return true;
+    }
+
+    // Producer: push, waiting while the ring is full (backpressure).
+    void push(T v) {
+        if (try_push(v)) return;
+        ++full_waits_;
+        for (int spin = 0; !try_push(v); ++spin) {
+            if (spin < SPIN_LIMIT) {
+                pause(spin);
+            } else {
+                park(producer_parked_, [&] {
+                    return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire) <= mask_;
+                });
+            }
+        }
+    }
+
+    // Consumer: pop, waiting while the ring is empty. Returns false once the
+    // producer has called close() and every item has been popped.
+    bool pop(T& out) {
+        if (try_pop(out)) return true;
+        ++empty_waits_;
+        for (int spin = 0;; ++spin) {
+            if (try_pop(out)) return true;
+            if (closed_.load(std::memory_order_acquire)) return try_pop(out); // items pushed before close()
+            if (spin < SPIN_LIMIT) {
+                pause(spin);
+            } else {
+                park(consumer_parked_, [&] {
+                    return head_.load(std::memory_order_relaxed) != tail_.load(std::memory_order_acquire)
+                        || closed_.load(std::memory_order_acquire);
+                });
+            }
+        }
+    }
+
+    // Producer: no more items will come.
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        wake(consumer_parked_);
+    }
+
+    long long full_waits() const { return full_waits_; }
+    long long empty_waits() const { return empty_waits_; }
+
+private:
+    std::vector<T> slots_;
+    std::size_t mask_ = 0;
+    std::atomic<bool> closed_{false};
+
+    // Only used once a side has run out of spins (see park / wake).
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::atomic<bool> producer_parked_{false};
+    std::atomic<bool> consumer_parked_{false};
+
+    alignas(64) std::atomic<std::size_t> head_{0}; // written by the consumer
+    std::size_t cached_tail_ = 0;                  // consumer's copy of tail_
+    long long empty_waits_ = 0;
+
+    alignas(64) std::atomic<std::size_t> tail_{0}; // written by the producer
+    std::size_t cached_head_ = 0;                  // producer's copy of head_
+    long long full_waits_ = 0;
+
+    static const int SPIN_LIMIT = 128; // pauses, then yields, then sleep
+
+    // Sleep until ready() holds. 'parked' is raised BEFORE ready() is
+    // checked and read by wake() AFTER the index store, with a full fence on
+    // both sides: either wake() sees the flag and notifies, or ready() sees
+    // the new index. No wakeup can be lost in between.
+    template <typename Ready>
+    void park(std::atomic<bool>& parked, Ready ready) {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        sleep_cv_.wait(lock, ready);
+        parked.store(false, std::memory_order_relaxed);
+    }
+
+    void wake(std::atomic<bool>& parked) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!parked.load(std::memory_order_relaxed)) return;
+        { std::lock_guard<std::mutex> lock(sleep_mutex_); } // the sleeper is inside wait() now
+        sleep_cv_.notify_all();
+    }
+
+    // Busy-wait a little (the other side is usually microseconds away), then
+    // give the CPU away so the other stage can run on the same core.
+    static void pause(int spin) {
+        if (spin < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+};
+
+#endif // CENG241_SPSC_QUEUE_HPP
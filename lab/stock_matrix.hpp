@@ -0,0 +1,185 @@
+// CENG241 - StockMatrix: store x item stock in ONE contiguous block
+// -----------------------------------------------------------------
+// week1_task2.cpp originally used `int**`: an array of row pointers plus a
+// separate `new int[NUM_ITEMS]` per store. Every access then follows a
+// pointer first, and the rows are scattered around the heap.
+//
+// StockMatrix stores all cells in a single aligned allocation:
+//
+//   row-major (one store after another):    [s0i0 s0i1 ... | s1i0 s1i1 ... | ...]
+//   column-major (one item after another):  [s0i0 s1i0 ... | s0i1 s1i1 ... | ...]
+//
+// The cell of store s, item i lives at   cells[s * ld + i]   (row-major)
+//                                   or   cells[i * ld + s]   (column-major)
+// where `ld` (the "leading dimension") is the row length rounded up to a
+// multiple of 16 ints, so every row/column starts on a 64-byte cache line.
+//
+// Pick the layout by the scans you run most:
+//   - "everything of store s"          -> row-major keeps it contiguous
+//   - "item j across all stores"       -> column-major keeps it contiguous
+// Whole-matrix totals (item_totals / store_totals) are written so that they
+// walk memory in order for EITHER layout, which lets the compiler vectorize.
+//
+// Sizes are chosen at runtime (e.g. 5,000 stores x 200,000 items).
+// Like the lab code, functions report failure with a bool return.
+// create_matrix optionally takes an arena or pool (ledger_alloc.hpp) for
+// programs that create many small per-store tables.
+
+#ifndef CENG241_STOCK_MATRIX_HPP
+#define CENG241_STOCK_MATRIX_HPP
+
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <cstring> // std::memset
+#include <new>     // std::align_val_t, std::nothrow
+#include "ledger_alloc.hpp"
+
+enum class MatrixLayout { RowMajor, ColMajor };
+
+const int MATRIX_ALIGN_BYTES = 64;                              // one cache line
+const int MATRIX_ALIGN_INTS = MATRIX_ALIGN_BYTES / sizeof(int); // 16
+
+struct StockMatrix {
+    int*         cells;  // one aligned block of outer * ld ints
+    int          stores; // rows of the logical matrix
+    int          items;  // columns of the logical matrix
+    MatrixLayout layout;
+    std::size_t  ld;     // padded length of one contiguous run (row or column)
+    LedgerAllocator* alloc = nullptr; // nullptr = aligned operator new / delete
+};
+
+// A strided window onto one row (store) or one column (item).
+struct StockView {
+    int*           base;
+    int            length;
+    std::ptrdiff_t stride; // distance between neighbours, in ints
+
+    int& operator[](int k) const { return base[k * stride]; }
+};
+
+inline std::size_t round_up_ints(std::size_t n) {
+    return (n + MATRIX_ALIGN_INTS - 1) / MATRIX_ALIGN_INTS * MATRIX_ALIGN_INTS;
+}
+
+inline std::size_t matrix_bytes(const StockMatrix& m) {
+    std::size_t outer = (m.layout == MatrixLayout::RowMajor) ? m.stores : m.items;
+    return outer * m.ld * sizeof(int);
+}
+
+// Allocate a zero-filled stores x items matrix.
+inline bool create_matrix(StockMatrix& m, int stores, int items, MatrixLayout layout = MatrixLayout::RowMajor,
+                          LedgerAllocator* alloc = nullptr) {
+    m.alloc = alloc;
+    m.cells = nullptr;
+    m.stores = 0;
+    m.items = 0;
+    m.layout = layout;
+    m.ld = 0;
+    if (stores <= 0 || items <= 0) return false;
+
+    std::size_t inner = (layout == MatrixLayout::RowMajor) ? items : stores;
+    std::size_t outer = (layout == MatrixLayout::RowMajor) ? stores : items;
+    std::size_t ld = round_up_ints(inner);
+    std::size_t bytes = outer * ld * sizeof(int);
+    // Aligned operator new (C++17): the block starts on a cache line.
+    // Arena and pool buffers are 64-byte aligned as well.
+    void* p = alloc ? alloc->allocate(bytes) : ::operator new(bytes, std::align_val_t(MATRIX_ALIGN_BYTES), std::nothrow);
+    if (!p) return false;
+    std::memset(p, 0, bytes); // padding is zeroed too, so it never disturbs sums
+
+    m.cells = static_cast<int*>(p);
+    m.stores = stores;
+    m.items = items;
+    m.ld = ld;
+    return true;
+}
+
+inline void destroy_matrix(StockMatrix& m) {
+    if (m.cells && m.alloc) m.alloc->release(m.cells, matrix_bytes(m));
+    else if (m.cells) ::operator delete(m.cells, std::align_val_t(MATRIX_ALIGN_BYTES));
+    m.cells = nullptr;
+    m.stores = 0;
+    m.items = 0;
+    m.ld = 0;
+}
+
+// Position of (store, item) inside the block.
+inline std::size_t cell_offset(const StockMatrix& m, int store, int item) {
+    return (m.layout == MatrixLayout::RowMajor) ? static_cast<std::size_t>(store) * m.ld + item
+                                                : static_cast<std::size_t>(item) * m.ld + store;
+}
+
+inline int& cell(StockMatrix& m, int store, int item) {
+    return m.cells[cell_offset(m, store, item)];
+}
+
+inline int cell(const StockMatrix& m, int store, int item) {
+    return m.cells[cell_offset(m, store, item)];
+}
+
+// All items of one store.
+inline StockView store_row(const StockMatrix& m, int store) {
+    if (m.layout == MatrixLayout::RowMajor) return StockView{m.cells + store * m.ld, m.items, 1};
+    return StockView{m.cells + store, m.items, static_cast<std::ptrdiff_t>(m.ld)};
+}
+
+// One item across all stores.
+inline StockView item_column(const StockMatrix& m, int item) {
+    if (m.layout == MatrixLayout::ColMajor) return StockView{m.cells + item * m.ld, m.stores, 1};
+    return StockView{m.cells + item, m.stores, static_cast<std::ptrdiff_t>(m.ld)};
+}
+
+// Total stock of one item across all stores.
+inline long long item_total(const StockMatrix& m, int item) {
+    StockView col = item_column(m, item);
+    long long sum = 0;
+    for (int s = 0; s < col.length; ++s) sum += col[s];
+    return sum;
+}
+
+// Total stock of one store across all items.
+inline long long store_total(const StockMatrix& m, int store) {
+    StockView row = store_row(m, store);
+    long long sum = 0;
+    for (int i = 0; i < row.length; ++i) sum += row[i];
+    return sum;
+}
+
+// out[i] = total of item i over all stores (out has m.items entries).
+// Row-major: add whole rows into out one after another, so both the matrix
+// and 'out' are read sequentially (no stride-ld jumps per item).
+inline void item_totals(const StockMatrix& m, long long* out) {
+    if (m.layout == MatrixLayout::ColMajor) {
+        for (int i = 0; i < m.items; ++i) out[i] = item_total(m, i);
+        return;
+    }
+    for (int i = 0; i < m.items; ++i) out[i] = 0;
+    for (int s = 0; s < m.stores; ++s) {
+        const int* row = m.cells + s * m.ld;
+        for (int i = 0; i < m.items; ++i) out[i] += row[i];
+    }
+}
+
+// out[s] = total of store s over all items (out has m.stores entries).
+inline void store_totals(const StockMatrix& m, long long* out) {
+    if (m.layout == MatrixLayout::RowMajor) {
+        for (int s = 0; s < m.stores; ++s) out[s] = store_total(m, s);
+        return;
+    }
+    for (int s = 0; s < m.stores; ++s) out[s] = 0;
+    for (int i = 0; i < m.items; ++i) {
+        const int* col = m.cells + i * m.ld;
+        for (int s = 0; s < m.stores; ++s) out[s] += col[s];
+    }
+}
+
+// Copy 'src' into a freshly created matrix 'dst' with the other layout
+// (memory from the same allocator).
+inline bool convert_layout(const StockMatrix& src, StockMatrix& dst, MatrixLayout layout) {
+    if (!create_matrix(dst, src.stores, src.items, layout, src.alloc)) return false;
+    for (int s = 0; s < src.stores; ++s) {
+        for (int i = 0; i < src.items; ++i) cell(dst, s, i) = cell(src, s, i);
+    }
+    return true;
+}
+
+#endif // CENG241_STOCK_MATRIX_HPP
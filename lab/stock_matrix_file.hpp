@@ -0,0 +1,65 @@
+// CENG241 - Persistent StockMatrix backed by a memory-mapped file
+// ---------------------------------------------------------------
+// Same idea as 251009/inventory_file.hpp: the matrix cells live inside a
+// ledger file (ledger_file.hpp) and StockMatrix::cells points into the
+// mapping. All StockMatrix functions (cell, store_row, item_totals, ...)
+// work unchanged. Do NOT call destroy_matrix on a mapped matrix; use
+// close_matrix_file, which writes the checksum and unmaps.
+
+#ifndef CENG241_STOCK_MATRIX_FILE_HPP
+#define CENG241_STOCK_MATRIX_FILE_HPP
+
+#include "stock_matrix.hpp"
+#include "ledger_file.hpp"
+
+inline void matrix_from_file(StockMatrix& m, const MappedFile& f) {
+    const LedgerFileHeader& h = *f.header;
+    m.cells = f.payload;
+    m.stores = static_cast<int>(h.stores);
+    m.items = static_cast<int>(h.items);
+    m.layout = (h.layout == 0) ? MatrixLayout::RowMajor : MatrixLayout::ColMajor;
+    m.ld = h.ld;
+    m.alloc = nullptr; // the cells belong to the mapping
+}
+
+inline bool create_matrix_file(StockMatrix& m, MappedFile& f, const char* path, int stores, int items,
+                               MatrixLayout layout = MatrixLayout::RowMajor) {
+    if (stores <= 0 || items <= 0) return false;
+    std::size_t inner = (layout == MatrixLayout::RowMajor) ? items : stores;
+    std::size_t outer = (layout == MatrixLayout::RowMajor) ? stores : items;
+    std::size_t ld = round_up_ints(inner);
+    if (!ledger_file_create(f, path, LEDGER_KIND_STOCK_MATRIX, outer * ld)) return false;
+    LedgerFileHeader& h = *f.header;
+    h.size = outer * ld;
+    h.stores = static_cast<std::uint32_t>(stores);
+    h.items = static_cast<std::uint32_t>(items);
+    h.layout = (layout == MatrixLayout::RowMajor) ? 0 : 1;
+    h.ld = static_cast<std::uint32_t>(ld);
+    matrix_from_file(m, f);
+    return true;
+}
+
+inline bool open_matrix_file(StockMatrix& m, MappedFile& f, const char* path, bool verify = false) {
+    if (!ledger_file_open(f, path, LEDGER_KIND_STOCK_MATRIX, verify)) return false;
+    const LedgerFileHeader& h = *f.header;
+    std::size_t inner = (h.layout == 0) ? h.items : h.stores;
+    std::size_t outer = (h.layout == 0) ? h.stores : h.items;
+    // The header must describe exactly the payload we mapped.
+    if (h.layout > 1 || h.ld < inner || h.ld % MATRIX_ALIGN_INTS != 0 || outer * h.ld != h.capacity) {
+        ledger_file_discard(f); // leave the rejected file as it was
+        return false;
+    }
+    matrix_from_file(m, f);
+    return true;
+}
+
+inline bool close_matrix_file(StockMatrix& m, MappedFile& f) {
+    bool ok = ledger_file_close(f);
+    m.cells = nullptr;
+    m.stores = 0;
+    m.items = 0;
+    m.ld = 0;
+    return ok;
+}
+
+#endif // CENG241_STOCK_MATRIX_FILE_HPP
@@ -0,0 +1,212 @@
+// CENG241 - Fixed-shape stock matrix (template version of StockMatrix)
+// --------------------------------------------------------------------
+// week1_task2.cpp knows its shape at compile time (NUM_STORES = 10,
+// NUM_ITEMS = 5) but StockMatrix (stock_matrix.hpp) is built for shapes
+// chosen at runtime: the cells are on the heap, every loop bound is a
+// variable and every row offset is a multiplication by a stored value.
+//
+//   ledger::StockMatrix<Stores, Items, T>
+//
+// puts the shape into the TYPE instead:
+// - the cells are a std::array<T, Stores * Items> inside the object: no
+//   heap allocation, no pointer to follow, sizeof(matrix) == the cells
+//   (so a large shape belongs in a static or global, not on the stack);
+// - cell(s, i) is s * Items + i with a constant Items, so the compiler
+//   folds it (and the whole matrix can be used in constexpr code);
+// - store and item totals loop over constant bounds. Rows of up to
+//   FIXED_UNROLL_ITEMS cells are summed with a fold expression over
+//   std::index_sequence, i.e. written out in full with no loop at all;
+//   longer rows keep a loop with a constant trip count, which the compiler
+//   unrolls and vectorizes without a remainder check.
+//
+// ledger::StockMatrix<DYNAMIC_SHAPE, DYNAMIC_SHAPE, T> is the runtime-shape
+// fallback with the SAME member functions (create, stores, items, cell,
+// row, store_total, item_total, store_totals, item_totals, total), backed
+// by a std::vector. Code written against that interface (see
+// bench_fixed_matrix.cpp) works with either.
+//
+// Like ledger::Inventory (251009/inventory_generic.hpp) this lives in
+// namespace ledger next to the lab's plain ::StockMatrix struct, and reports
+// failure with a bool. Totals are long long for integer T (no overflow on
+// big tables) and T itself for floating-point T.
+
+#ifndef CENG241_STOCK_MATRIX_FIXED_HPP
+#define CENG241_STOCK_MATRIX_FIXED_HPP
+
+#include <array>
+#include <cstddef>     // std::size_t
+#include <new>         // std::bad_alloc
+#include <type_traits> // std::conditional_t, std::is_integral
+#include <utility>     // std::index_sequence
+#include <vector>
+
+namespace ledger {
+
+const int DYNAMIC_SHAPE = -1;     // "chosen at runtime"
+const int FIXED_UNROLL_ITEMS = 32; // longer rows are summed with a (constant-bound) loop
+
+template <typename T>
+using StockTotal = std::conditional_t<std::is_integral<T>::value, long long, T>;
+
+// --- Fixed shape ---------------------------------------------------------------
+
+template <int Stores, int Items, typename T = int>
+class StockMatrix {
+    static_assert(Stores > 0 && Items > 0, "use DYNAMIC_SHAPE for a shape chosen at runtime");
+
+public:
+    using value_type = T;
+    using total_type = StockTotal<T>;
+
+    // Zero-filled, like create_matrix.
+    constexpr StockMatrix() : cells_{} {}
+
+    // Same call as the runtime fallback; only the matching shape succeeds.
+    constexpr bool create(int stores, int items) {
+        cells_ = {};
+        return stores == Stores && items == Items;
+    }
+
+    static constexpr int stores() { return Stores; }
+    static constexpr int items() { return Items; }
+
+    constexpr T& cell(int store, int item) { return cells_[index(store, item)]; }
+    constexpr const T& cell(int store, int item) const { return cells_[index(store, item)]; }
+
+    // All items of one store (contiguous: the layout is row-major).
+    constexpr T* row(int store) { return cells_.data() + index(store, 0); }
+    constexpr const T* row(int store) const { return cells_.data() + index(store, 0); }
+
+    constexpr total_type store_total(int store) const {
+        return sum_row(row(store), std::make_index_sequence<(Items <= FIXED_UNROLL_ITEMS ? Items : 0)>());
+    }
+
+    constexpr total_type item_total(int item) const {
+        total_type sum = 0;
+        for (int s = 0; s < Stores; ++s) sum += cells_[index(s, item)];
+        return sum;
+    }
+
+    // out[s] = total of store s (out has Stores entries).
+    constexpr void store_totals(total_type* out) const {
+        for (int s = 0; s < Stores; ++s) out[s] = store_total(s);
+    }
+
+    // out[i] = total of item i (out has Items entries): whole rows are added
+    // into out, so both are read in order.
+    constexpr void item_totals(total_type* out) const {
+        for (int i = 0; i < Items; ++i) out[i] = 0;
+        for (int s = 0; s < Stores; ++s) {
+            const T* r = row(s);
+            for (int i = 0; i < Items; ++i) out[i] += r[i];
+        }
+    }
+
+    constexpr total_type total() const {
+        total_type sum = 0;
+        for (std::size_t k = 0; k < cells_.size(); ++k) sum += cells_[k];
+        return sum;
+    }
+
+private:
+    std::array<T, static_cast<std::size_t>(Stores) * Items> cells_;
+
+    static constexpr std::size_t index(int store, int item) {
+        return static_cast<std::size_t>(store) * Items + item;
+    }
+
+    // Short rows: r[0] + r[1] + ... + r[Items-1], written out by the compiler.
+    template <std::size_t... K>
+    static constexpr total_type sum_row(const T* r, std::index_sequence<K...>) {
+        if constexpr (sizeof...(K) > 0) {
+            return (total_type(0) + ... + static_cast<total_type>(r[K]));
+        } else {
+            total_type sum = 0;
+            for (int i = 0; i < Items; ++i) sum += r[i];
+            return sum;
+        }
+    }
+};
+
+// --- Runtime shape (fallback) ------------------------------------------------------
+
+template <typename T>
+class StockMatrix<DYNAMIC_SHAPE, DYNAMIC_SHAPE, T> {
+public:
+    using value_type = T;
+    using total_type = StockTotal<T>;
+
+    StockMatrix() = default;
+
+    // Allocate a zero-filled stores x items table; false on a bad shape or
+    // when memory runs out.
+    bool create(int stores, int items) {
+        cells_.clear();
+        stores_ = items_ = 0;
+        if (stores <= 0 || items <= 0) return false;
+        try {
+            cells_.assign(static_cast<std::size_t>(stores) * items, T());
+        } catch (const std::bad_alloc&) {
+            return false;
+        }
+        stores_ = stores;
+        items_ = items;
+        return true;
+    }
+
+    int stores() const { return stores_; }
+    int items() const { return items_; }
+
+    T& cell(int store, int item) { return cells_[index(store, item)]; }
+    const T& cell(int store, int item) const { return cells_[index(store, item)]; }
+
+    T* row(int store) { return cells_.data() + index(store, 0); }
+    const T* row(int store) const { return cells_.data() + index(store, 0); }
+
+    total_type store_total(int store) const {
+        const T* r = row(store);
+        total_type sum = 0;
+        for (int i = 0; i < items_; ++i) sum += r[i];
+        return sum;
+    }
+
+    total_type item_total(int item) const {
+        total_type sum = 0;
+        for (int s = 0; s < stores_; ++s) sum += cells_[index(s, item)];
+        return sum;
+    }
+
+    void store_totals(total_type* out) const {
+        for (int s = 0; s < stores_; ++s) out[s] = store_total(s);
+    }
+
+    void item_totals(total_type* out) const {
+        for (int i = 0; i < items_; ++i) out[i] = 0;
+        for (int s = 0; s < stores_; ++s) {
+            const T* r = row(s);
+            for (int i = 0; i < items_; ++i) out[i] += r[i];
+        }
+    }
+
+    total_type total() const {
+        total_type sum = 0;
+        for (const T& v : cells_) sum += v;
+        return sum;
+    }
+
+private:
+    std::vector<T> cells_;
+    int stores_ = 0;
+    int items_ = 0;
+
+    std::size_t index(int store, int item) const {
+        return static_cast<std::size_t>(store) * items_ + item;
+    }
+};
+
+template <typename T = int>
+using DynamicStockMatrix = StockMatrix<DYNAMIC_SHAPE, DYNAMIC_SHAPE, T>;
+
+} // namespace ledger
+
+#endif // CENG241_STOCK_MATRIX_FIXED_HPP
@@ -0,0 +1,161 @@
+// CENG241 - Versioned stock table: O(1) snapshots of a StockMatrix
+// ----------------------------------------------------------------
+// A report over all stores (store totals, show_store for every store) must
+// see one moment of the table; with add_stock / reduce_stock running on
+// other threads that used to mean locking the table for the whole report.
+//
+// VersionedStockMatrix stores the row-major cells in copy-on-write chunks
+// of COW_CHUNK_INTS cells (cow_chunks.hpp): cell (s, i) is slot
+// s * items + i, in chunk slot / 1024. Positions never move, so a chunk is
+// only ever copied, never split.
+//
+//   snapshot(m)      copies the directory pointer under the lock: O(1).
+//   add / reduce     take the lock for one cell. The first write after a
+//                    snapshot copies the directory (cells / 1024 pointers),
+//                    the first write into each shared chunk copies 4 KiB.
+//
+// Readers scan a StockSnapshot without any lock while sales continue on the
+// newer version. Dropping the snapshot frees the chunks only it still used.
+
+#ifndef CENG241_STOCK_MATRIX_SNAPSHOT_HPP
+#define CENG241_STOCK_MATRIX_SNAPSHOT_HPP
+
+#include <algorithm> // std::min, std::copy, std::fill
+#include <climits>   // INT_MAX
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "cow_chunks.hpp"
+
+struct MatrixDirectory {
+    std::vector<CowChunkRef> chunks; // ceil(stores * items / 1024) chunks
+    int stores;
+    int items;
+    unsigned long long version;      // number of changes applied so far
+};
+
+// An immutable view of the whole table at one version.
+struct StockSnapshot {
+    std::shared_ptr<const MatrixDirectory> dir;
+};
+
+struct VersionedStockMatrix {
+    mutable std::mutex lock;              // one cell update, or one snapshot() pointer copy
+    std::shared_ptr<MatrixDirectory> dir;
+};
+
+inline bool create_versioned_matrix(VersionedStockMatrix& m, int stores, int items) {
+    if (stores <= 0 || items <= 0) return false;
+    auto d = std::make_shared<MatrixDirectory>();
+    d->stores = stores;
+    d->items = items;
+    d->version = 0;
+    std::size_t cells = static_cast<std::size_t>(stores) * items;
+    for (std::size_t first = 0; first < cells; first += COW_CHUNK_INTS) {
+        CowChunkRef chunk = std::make_shared<CowChunk>();
+        chunk->count = static_cast<int>(std::min<std::size_t>(COW_CHUNK_INTS, cells - first));
+        std::fill(chunk->items, chunk->items + COW_CHUNK_INTS, 0);
+        d->chunks.push_back(chunk);
+    }
+    std::lock_guard<std::mutex> guard(m.lock);
+    m.dir = d;
+    return true;
+}
+
+inline StockSnapshot snapshot(const VersionedStockMatrix& m) {
+    std::lock_guard<std::mutex> guard(m.lock);
+    return StockSnapshot{m.dir};
+}
+
+// Read cell (s, i) of a directory without copying anything.
+inline int cell(const MatrixDirectory& d, int store, int item) {
+    std::size_t slot = static_cast<std::size_t>(store) * d.items + item;
+    return d.chunks[slot / COW_CHUNK_INTS]->items[slot % COW_CHUNK_INTS];
+}
+
+// The writable cell (s, i); caller holds m.lock.
+inline int& writable_cell(VersionedStockMatrix& m, int store, int item) {
+    MatrixDirectory& d = cow_writable(m.dir);
+    std::size_t slot = static_cast<std::size_t>(store) * d.items + item;
+    ++d.version;
+    return cow_writable(d.chunks[slot / COW_CHUNK_INTS]).items[slot % COW_CHUNK_INTS];
+}
+
+// False (nothing changed) for a cell outside the table or qty <= 0.
+inline bool valid_change(const MatrixDirectory& d, int store, int item, int qty) {
+    return store >= 0 && store < d.stores && item >= 0 && item < d.items && qty > 0;
+}
+
+// Add qty (> 0) units. False for a bad cell or quantity, or if the add
+// would pass INT_MAX.
+inline bool add_stock(VersionedStockMatrix& m, int store, int item, int qty) {
+    std::lock_guard<std::mutex> guard(m.lock);
+    if (!valid_change(*m.dir, store, item, qty)) return false;
+    if (qty > INT_MAX - cell(*m.dir, store, item)) return false;
+    writable_cell(m, store, item) += qty;
+    return true;
+}
+
+// Removes up to qty (> 0) units (never below zero); 'removed' says how
+// many. False for a bad cell or quantity.
+inline bool reduce_stock(VersionedStockMatrix& m, int store, int item, int qty, int& removed) {
+    std::lock_guard<std::mutex> guard(m.lock);
+    removed = 0;
+    if (!valid_change(*m.dir, store, item, qty)) return false;
+    int& c = writable_cell(m, store, item);
+    removed = c < qty ? c : qty;
+    c -= removed;
+    return true;
+}
+
+// --- Readers (no lock: a snapshot never changes) -------------------------------
+
+inline unsigned long long snapshot_version(const StockSnapshot& s) { return s.dir->version; }
+
+inline int cell(const StockSnapshot& s, int store, int item) {
+    return cell(*s.dir, store, item);
+}
+
+// Copy one store's row (items ints) into out, e.g. for show_store.
+inline void store_row(const StockSnapshot& s, int store, int* out) {
+    std::size_t slot = static_cast<std::size_t>(store) * s.dir->items;
+    for (int done = 0; done < s.dir->items;) {
+        const CowChunk& chunk = *s.dir->chunks[slot / COW_CHUNK_INTS];
+        int offset = static_cast<int>(slot % COW_CHUNK_INTS);
+        int n = std::min(chunk.count - offset, s.dir->items - done);
+        std::copy(chunk.items + offset, chunk.items + offset + n, out + done);
+        done += n;
+        slot += n;
+    }
+}
+
+inline long long store_total(const StockSnapshot& s, int store) {
+    std::size_t slot = static_cast<std::size_t>(store) * s.dir->items;
+    long long total = 0;
+    for (int done = 0; done < s.dir->items;) {
+        const CowChunk& chunk = *s.dir->chunks[slot / COW_CHUNK_INTS];
+        int offset = static_cast<int>(slot % COW_CHUNK_INTS);
+        int n = std::min(chunk.count - offset, s.dir->items - done);
+        for (int k = 0; k < n; ++k) total += chunk.items[offset + k];
+        done += n;
+        slot += n;
+    }
+    return total;
+}
+
+// out[s] = total of store s (out has stores entries); reads the chunks in order.
+inline void store_totals(const StockSnapshot& s, long long* out) {
+    for (int store = 0; store < s.dir->stores; ++store) out[store] = store_total(s, store);
+}
+
+// Sum of every cell in the snapshot.
+inline long long total_stock(const StockSnapshot& s) {
+    long long total = 0;
+    for (const CowChunkRef& chunk : s.dir->chunks) {
+        for (int k = 0; k < chunk->count; ++k) total += chunk->items[k];
+    }
+    return total;
+}
+
+#endif // CENG241_STOCK_MATRIX_SNAPSHOT_HPP
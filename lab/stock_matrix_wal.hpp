@@ -0,0 +1,143 @@
+// CENG241 - Durable StockMatrix: snapshot + write-ahead log
+// ---------------------------------------------------------
+// Same scheme as 251009/inventory_wal.hpp for the store x item table:
+// base.snap holds a full copy of the matrix, base.wal the add_stock /
+// reduce_stock records logged since (see ledger_wal.hpp). Opening replays
+// the log, so the table survives crashes. Unlike stock_matrix_file.hpp
+// (which maps the table in place and relies on a clean close), every
+// change here is durable as soon as its log record is.
+//
+// A new table is written as snapshot 1 right away, so the shape (stores,
+// items, layout) always comes from the snapshot and the log only holds
+// stock changes.
+
+#ifndef CENG241_STOCK_MATRIX_WAL_HPP
+#define CENG241_STOCK_MATRIX_WAL_HPP
+
+#include <string>
+#include "stock_matrix.hpp"
+#include "ledger_wal.hpp"
+
+struct DurableStockMatrix {
+    StockMatrix   m;
+    WriteAheadLog wal;
+    std::string   snapshot_path; // base + ".snap"
+    std::string   wal_path;      // base + ".wal"
+};
+
+// Apply one logged change. Out-of-range cells are rejected, so a damaged
+// log cannot write outside the matrix.
+inline bool apply_stock_record(StockMatrix& m, const WalRecord& r) {
+    if (r.a < 0 || r.a >= m.stores || r.b < 0 || r.b >= m.items || r.c <= 0) return false;
+    int& current = cell(m, r.a, r.b);
+    if (r.op == WAL_ADD_STOCK) {
+        current += r.c;
+        return true;
+    }
+    if (r.op == WAL_REDUCE_STOCK) {
+        current = (r.c > current) ? 0 : current - r.c; // clamp like week1_task2
+        return true;
+    }
+    return false;
+}
+
+inline bool checkpoint_durable_matrix(DurableStockMatrix& led);
+
+// Load base.snap and replay base.wal. If there is no snapshot yet a zeroed
+// stores x items table is created and written as the first snapshot.
+inline bool open_durable_matrix(DurableStockMatrix& led, const char* base, int stores, int items,
+                                MatrixLayout layout = MatrixLayout::RowMajor, WalOptions options = WalOptions()) {
+    led.snapshot_path = std::string(base) + ".snap";
+    led.wal_path = std::string(base) + ".wal";
+
+    SnapshotReader snap;
+    int found = ledger_snapshot_open(snap, led.snapshot_path.c_str(), LEDGER_KIND_STOCK_MATRIX);
+    if (found < 0) return false;
+    if (found == 0) {
+        // Generation 0 with an empty log; the checkpoint turns it into snapshot 1.
+        if (!create_matrix(led.m, stores, items, layout)) return false;
+        if (!led.wal.open(led.wal_path.c_str(), 0, 0, options) || !checkpoint_durable_matrix(led)) {
+            led.wal.close();
+            destroy_matrix(led.m);
+            return false;
+        }
+        return true;
+    }
+
+    const LedgerFileHeader& h = snap.header;
+    MatrixLayout file_layout = (h.layout == 0) ? MatrixLayout::RowMajor : MatrixLayout::ColMajor;
+    bool ok = h.layout <= 1 && create_matrix(led.m, static_cast<int>(h.stores), static_cast<int>(h.items), file_layout)
+           && led.m.ld == h.ld && static_cast<std::uint64_t>((file_layout == MatrixLayout::RowMajor ? h.stores : h.items)) * h.ld == h.capacity;
+    if (!ok) {
+        ledger_snapshot_close(snap);
+        destroy_matrix(led.m);
+        return false;
+    }
+    std::uint32_t generation = h.generation;
+    if (!ledger_snapshot_read(snap, led.m.cells)) {
+        destroy_matrix(led.m);
+        return false;
+    }
+
+    WalReplayInfo info;
+    ok = wal_replay(led.wal_path.c_str(), generation, info,
+                    [&](const WalRecord& r) { return apply_stock_record(led.m, r); });
+    if (!ok || !led.wal.open(led.wal_path.c_str(), generation, info.stale ? 0 : info.valid_bytes, options)) {
+        destroy_matrix(led.m);
+        return false;
+    }
+    return true;
+}
+
+inline bool flush_durable_matrix(DurableStockMatrix& led) {
+    return led.wal.sync();
+}
+
+// Write the whole table as snapshot generation+1 and restart the log.
+inline bool checkpoint_durable_matrix(DurableStockMatrix& led) {
+    if (!led.wal.sync()) return false;
+    const StockMatrix& m = led.m;
+    std::size_t outer = (m.layout == MatrixLayout::RowMajor) ? m.stores : m.items;
+    LedgerFileHeader shape{};
+    shape.kind = LEDGER_KIND_STOCK_MATRIX;
+    shape.size = outer * m.ld;
+    shape.capacity = outer * m.ld;
+    shape.stores = static_cast<std::uint32_t>(m.stores);
+    shape.items = static_cast<std::uint32_t>(m.items);
+    shape.layout = (m.layout == MatrixLayout::RowMajor) ? 0 : 1;
+    shape.ld = static_cast<std::uint32_t>(m.ld);
+    shape.generation = led.wal.generation() + 1;
+    if (!ledger_snapshot_write(led.snapshot_path, shape, m.cells)) return false;
+    return led.wal.restart(shape.generation);
+}
+
+// Sync the log and free the table (the log is kept for the next open).
+inline bool close_durable_matrix(DurableStockMatrix& led) {
+    bool ok = led.wal.close();
+    destroy_matrix(led.m);
+    return ok;
+}
+
+// Add qty (> 0) units; the change is queued in the log. Returns false for
+// a bad cell or quantity, or if the log is broken. The record is logged
+// before the table changes, so memory is never ahead of the log.
+inline bool add_stock(DurableStockMatrix& led, int store, int item, int qty) {
+    WalRecord r{WAL_ADD_STOCK, store, item, qty};
+    if (store < 0 || store >= led.m.stores || item < 0 || item >= led.m.items || qty <= 0) return false;
+    return led.wal.log(r) != 0 && apply_stock_record(led.m, r);
+}
+
+// Remove up to qty (> 0) units, clamping at zero; 'removed' receives how
+// many were really taken.
+inline bool reduce_stock(DurableStockMatrix& led, int store, int item, int qty, int& removed) {
+    WalRecord r{WAL_REDUCE_STOCK, store, item, qty};
+    removed = 0;
+    if (store < 0 || store >= led.m.stores || item < 0 || item >= led.m.items || qty <= 0) return false;
+    if (led.wal.log(r) == 0) return false;
+    int before = cell(led.m, store, item);
+    apply_stock_record(led.m, r);
+    removed = before - cell(led.m, store, item);
+    return true;
+}
+
+#endif // CENG241_STOCK_MATRIX_WAL_HPP
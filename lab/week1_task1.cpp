@@ -1,5 +1,13 @@
+#include <charconv> // from_chars: --bulk arguments
+#include <cstring>  // strlen
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "bulk_arithmetic.hpp"
 using namespace std;
 
 // Task 1: Four Operations with Dynamic Array, Pointers, and Functions
@@ -47,7 +55,67 @@ bool divide(const int* a, const int* b, double* out) {
     return true; // success
 }
 
-int main() {
+// True if 'text' is a whole number that fits in 'out' and nothing else.
+template <typename T>
+bool parse_whole(const char* text, T& out) {
+    const char* end = text + strlen(text);
+    from_chars_result r = from_chars(text, end, out);
+    return r.ec == errc() && r.ptr == end && r.ptr != text;
+}
+
+// Bulk mode: ./week1_task1 --bulk N [threads]
+// Prices N random (qty, unit) pairs as qty * unit + fee with the array
+// versions from bulk_arithmetic.hpp, checks every result against the
+// one-pair functions above and prints the throughput.
+int bulk_demo(size_t n, int threads) {
+    vector<int> qty(n), unit(n), fee(n);
+    mt19937 rng(241);
+    for (size_t i = 0; i < n; ++i) {
+        qty[i] = static_cast<int>(rng() % 1000);
+        unit[i] = static_cast<int>(rng() % 5000); // some unit prices are 0
+        fee[i] = static_cast<int>(rng() % 100);
+    }
+    vector<double> price(n), share(n);
+    vector<uint64_t> valid(bulk_mask_words(n));
+    ThreadPool pool(threads);
+
+    auto t0 = chrono::steady_clock::now();
+    parallel_bulk_mul_add(pool, qty.data(), unit.data(), fee.data(), price.data(), n);
+    auto t1 = chrono::steady_clock::now();
+    size_t zeros = parallel_bulk_divide(pool, qty.data(), unit.data(), share.data(), valid.data(), n);
+    auto t2 = chrono::steady_clock::now();
+
+    size_t wrong = 0;
+    for (size_t i = 0; i < n; ++i) {
+        // qty * unit < 5e6 is exact in a double, so fma and mul-then-add agree.
+        double cost, q;
+        mul(&qty[i], &unit[i], &cost);
+        bool ok = divide(&qty[i], &unit[i], &q);
+        if (price[i] != cost + fee[i] || ok != bulk_mask_valid(valid.data(), i) || (ok && share[i] != q)) ++wrong;
+    }
+
+    double s1 = chrono::duration<double>(t1 - t0).count();
+    double s2 = chrono::duration<double>(t2 - t1).count();
+    cout << n << " pairs, " << pool.size() << " thread(s), " << bulk_kernels().name << " kernels\n"
+         << fixed << setprecision(1)
+         << "qty * unit + fee: " << n / s1 / 1e6 << " M pairs/s\n"
+         << "qty / unit:       " << n / s2 / 1e6 << " M pairs/s (" << zeros << " zero divisors)\n"
+         << (wrong ? "MISMATCH with mul/divide: " + to_string(wrong) + "\n" : string("results match mul/divide\n"));
+    return wrong ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && string(argv[1]) == "--bulk") {
+        // from_chars instead of stoull/stoi: bad input is reported, not thrown.
+        size_t n = 0;
+        int threads = 1;
+        if (!parse_whole(argv[2], n) || n == 0 || (argc > 3 && !parse_whole(argv[3], threads))) {
+            cout << "Usage: " << argv[0] << " --bulk N [threads]   (N > 0, threads a whole number)\n";
+            return 1;
+        }
+        return bulk_demo(n, threads < 1 ? 1 : threads);
+    }
+
     cout << "Task 1: Two-number operations using dynamic array and pointers\n";
 
     int size = 2;
@@ -1,81 +1,102 @@
 #include <iostream>
 #include <vector>
 #include <limits>
+#include <string>
+#include <cstdlib>
+#include "stock_matrix.hpp"
+#include "stock_matrix_file.hpp"
+#include "stock_matrix_wal.hpp"
+#include "ledger_loader.hpp"
+#include "ledger_pipeline.hpp" // --replay
+#include "out_buffer.hpp"   // show_store: one write for a whole row
 using namespace std;
 
 // Task 2: Stationery Stock Management with Dynamic 2D Array
 // - 10 stores, each with 5 items
-// - Use int** dynamic allocation
+// - Use dynamic allocation (now a single contiguous StockMatrix, see below)
 // - Menu: show store stock, add stock, reduce stock, exit
 // - Input validation and proper deletion
 
 /* NOTES / TEACHING POINTS (added inline below):
- - This file demonstrates a dynamic 2D array using raw pointers (int**).
-     Each row is separately allocated with new[], and the array of row pointers
-     itself is allocated with new[] as well.
+ - The first version of this file used a dynamic 2D array of raw pointers
+     (int**): each row separately allocated with new[], plus an array of row
+     pointers. It now uses StockMatrix (stock_matrix.hpp): ONE aligned block
+     holding every cell, sized at runtime. Cell (s, item) is found with a
+     multiplication instead of following a row pointer.
  - Memory ownership: the code that creates the structure must also delete it.
- - In modern C++ prefer std::vector or smart pointers; raw int** is shown here
-     for educational purposes (to understand pointer-to-pointer and manual
-     allocation/deallocation).
+ - In modern C++ prefer std::vector or smart pointers. StockMatrix still
+     does its own allocation/deallocation (create_matrix / destroy_matrix),
+     so the manual-ownership rules above apply to it as well.
  - Key topics covered in comments: indexing, bounds checking, input validation,
      preventing negative stocks, and safe deletion.
 */
 
+// Default shape; can be overridden at startup: ./week1_task2 [stores items]
 const int NUM_STORES = 10;
 const int NUM_ITEMS = 5;
 
-int** create_stock() {
-    // Allocate an array of pointers (one pointer per store).
-    // 'stock' points to the first element of this pointer-array.
-    int** stock = new int*[NUM_STORES];
-    for (int i = 0; i < NUM_STORES; ++i) {
-        // For each store, allocate an array of NUM_ITEMS integers.
-        // So memory layout is 'array of pointers' -> each points to an 'array of ints'.
-        stock[i] = new int[NUM_ITEMS];
-        // Initialize all item quantities to 0 to have a defined starting state.
-        for (int j = 0; j < NUM_ITEMS; ++j) stock[i][j] = 0;
-    }
-    return stock; // Caller receives ownership and must call delete_stock when done.
+bool create_stock(StockMatrix& stock, int stores, int items, LedgerAllocator* alloc = nullptr) {
+    // One allocation for the whole table, zero-filled so every item starts
+    // at 0. Compare with the old int** version: stores + 1 allocations.
+    // 'alloc' lets programs with many short-lived tables use an arena or a
+    // pool (ledger_alloc.hpp) instead of the heap.
+    return create_matrix(stock, stores, items, MatrixLayout::RowMajor, alloc);
 }
 
-void delete_stock(int** stock) {
-    // Free each row first, then free the array of pointers.
-    if (!stock) return; // nothing to do
-    for (int i = 0; i < NUM_STORES; ++i) {
-        // Be careful: each stock[i] was allocated with new[] so we must use delete[]
-        // to free it. If stock[i] were nullptr we could skip it, but our create
-        // function always initializes them.
-        delete[] stock[i];
-        stock[i] = nullptr; // defensive: avoid dangling pointers
-    }
-    delete[] stock;
+void delete_stock(StockMatrix& stock) {
+    // One block, one delete (returned to the allocator it came from).
+    // Safe to call twice (cells becomes nullptr).
+    destroy_matrix(stock);
 }
 
 int read_int_in_range(const string& prompt, int low, int high) {
     int x;
     while (true) {
         cout << prompt;
-        if (cin >> x && x >= low && x <= high) return x;
+        if (cin >> x && int_in_range(x, low, high)) return x;
         cout << "Invalid input. Please enter a number between " << low << " and " << high << ".\n";
         cin.clear();
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
     }
 }
 
-void show_store(int** stock) {
+string store_prompt(const StockMatrix& stock) {
+    return "Enter store number (1-" + to_string(stock.stores) + "): ";
+}
+
+string item_prompt(const StockMatrix& stock) {
+    return "Enter item number (1-" + to_string(stock.items) + "): ";
+}
+
+void show_store(const StockMatrix& stock) {
     // Ask user for store number and print all items for that store.
-    int s = read_int_in_range("Enter store number (1-10): ", 1, NUM_STORES) - 1;
-    cout << "Stock for store " << (s + 1) << ":\n";
-    for (int j = 0; j < NUM_ITEMS; ++j) {
-        // Access pattern: stock[s][j] -> go to row s, then column j
-        cout << "  Item " << (j + 1) << ": " << stock[s][j] << "\n";
+    int s = read_int_in_range(store_prompt(stock), 1, stock.stores) - 1;
+    // A row view: all items of store s (contiguous in row-major layout).
+    // With 200,000 items a `cout <<` per line is slow; the lines are
+    // formatted into one buffer and written at once (out_buffer.hpp).
+    StockView row = store_row(stock, s);
+    cout.flush();
+    OutBuffer& out = stdout_buffer();
+    out_str(out, "Stock for store ");
+    out_int(out, s + 1);
+    out_str(out, ":\n");
+    for (int j = 0; j < row.length; ++j) {
+        out_str(out, "  Item ");
+        out_int(out, j + 1);
+        out_str(out, ": ");
+        out_int(out, row[j]);
+        out_char(out, '\n');
     }
+    out_flush(out);
 }
 
-void add_stock(int** stock) {
+// 'wal' is set with --wal: the change is logged and we wait until the log
+// record is on disk before confirming it (one fsync per change is fine at
+// typing speed; ledger_wal.hpp batches them under load).
+void add_stock(StockMatrix& stock, WriteAheadLog* wal) {
     // Validate store and item indices using helper.
-    int s = read_int_in_range("Enter store number (1-10): ", 1, NUM_STORES) - 1;
-    int item = read_int_in_range("Enter item number (1-5): ", 1, NUM_ITEMS) - 1;
+    int s = read_int_in_range(store_prompt(stock), 1, stock.stores) - 1;
+    int item = read_int_in_range(item_prompt(stock), 1, stock.items) - 1;
     int qty;
     cout << "Enter quantity to add (positive integer): ";
     // Quantity must be positive. We also protect against non-integer input.
@@ -84,15 +105,20 @@ void add_stock(int** stock) {
         cin.clear();
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
     }
+    // Write-ahead: the record must be on disk before the table changes.
+    if (wal && !wal->wait_durable(wal->log(WalRecord{WAL_ADD_STOCK, s, item, qty}))) {
+        cout << "The change could not be written to the log; stock not changed.\n";
+        return;
+    }
     // Update the in-memory stock. No overflow checks here; in production you'd
     // consider upper bounds or use a larger integer type if needed.
-    stock[s][item] += qty;
-    cout << "Added " << qty << " to store " << (s+1) << ", item " << (item+1) << ". New stock: " << stock[s][item] << "\n";
+    cell(stock, s, item) += qty;
+    cout << "Added " << qty << " to store " << (s+1) << ", item " << (item+1) << ". New stock: " << cell(stock, s, item) << "\n";
 }
 
-void reduce_stock(int** stock) {
-    int s = read_int_in_range("Enter store number (1-10): ", 1, NUM_STORES) - 1;
-    int item = read_int_in_range("Enter item number (1-5): ", 1, NUM_ITEMS) - 1;
+void reduce_stock(StockMatrix& stock, WriteAheadLog* wal) {
+    int s = read_int_in_range(store_prompt(stock), 1, stock.stores) - 1;
+    int item = read_int_in_range(item_prompt(stock), 1, stock.items) - 1;
     int qty;
     cout << "Enter quantity to reduce (positive integer): ";
     while (!(cin >> qty) || qty <= 0) {
@@ -102,18 +128,118 @@ void reduce_stock(int** stock) {
     }
     // If the requested reduction is larger than current stock, we clamp to 0
     // and inform the user. Another design option is to reject the operation.
-    if (qty > stock[s][item]) {
-        cout << "Cannot reduce by " << qty << " because current stock is " << stock[s][item] << ". Setting stock to 0.\n";
-        stock[s][item] = 0;
+    // Same write-ahead order as add_stock. The log stores the request;
+    // replay clamps the same way.
+    if (wal && !wal->wait_durable(wal->log(WalRecord{WAL_REDUCE_STOCK, s, item, qty}))) {
+        cout << "The change could not be written to the log; stock not changed.\n";
+        return;
+    }
+    int& current = cell(stock, s, item);
+    if (qty > current) {
+        cout << "Cannot reduce by " << qty << " because current stock is " << current << ". Setting stock to 0.\n";
+        current = 0;
     } else {
-        stock[s][item] -= qty;
-        cout << "Reduced " << qty << " from store " << (s+1) << ", item " << (item+1) << ". New stock: " << stock[s][item] << "\n";
+        current -= qty;
+        cout << "Reduced " << qty << " from store " << (s+1) << ", item " << (item+1) << ". New stock: " << current << "\n";
     }
 }
 
-int main() {
-    cout << "Task 2: Stationery stock management (10 stores x 5 items)\n";
-    int** stock = create_stock();
+// --replay: feed a whole file of operations through the pipeline stages
+// (read, parse, validate, apply, print) running side by side on their own
+// threads, instead of one prompt at a time.
+int run_replay_file(StockMatrix& stock, const char* replay) {
+    int fd = string(replay) == "-" ? 0 : open(replay, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        cout << "Cannot read replay file: " << replay << "\n";
+        delete_stock(stock);
+        return 1;
+    }
+    cout.flush(); // the replay writes to fd 1 directly
+    ReplayReport report;
+    bool ok = run_replay(stock, fd, 1, PipelineMode::Pipelined, report);
+    if (fd != 0) close(fd);
+    cout << "Replayed " << report.lines << " operations (" << report.rejected << " skipped) in " << report.seconds
+         << " s, input via " << ingest_backend_name(report.backend) << (ok ? "" : ", READ ERROR") << "\n";
+    delete_stock(stock);
+    return ok ? 0 : 1;
+}
+
+// Usage:
+//   ./week1_task2 [stores items]                  table in memory only
+//   ./week1_task2 --file stock.mat [stores items] table kept in a memory-mapped
+//                                                 file; reopened on the next run
+//   ./week1_task2 --wal stock [stores items]      every change logged to stock.wal
+//                                                 (crash-safe); stock.snap holds the
+//                                                 table as of the last checkpoint
+//   ./week1_task2 --load stock.csv                table read from a CSV file, one
+//                                                 line per store (ledger_loader.hpp)
+//   ./week1_task2 --replay ops.txt [stores items] no menu: run the add / reduce / show
+//                                                 lines of ops.txt ('-' = stdin) through
+//                                                 the staged pipeline (ledger_pipeline.hpp)
+int main(int argc, char* argv[]) {
+    const char* path = nullptr;
+    const char* wal_base = nullptr;
+    const char* csv = nullptr;
+    const char* replay = nullptr;
+    int arg = 1;
+    if (argc >= 3 && string(argv[1]) == "--load") {
+        csv = argv[2];
+        arg = 3;
+    } else if (argc >= 3 && string(argv[1]) == "--file") {
+        path = argv[2];
+        arg = 3;
+    } else if (argc >= 3 && string(argv[1]) == "--wal") {
+        wal_base = argv[2];
+        arg = 3;
+    } else if (argc >= 3 && string(argv[1]) == "--replay") {
+        replay = argv[2];
+        arg = 3;
+    }
+    int stores = NUM_STORES;
+    int items = NUM_ITEMS;
+    if (argc == arg + 2) {
+        stores = atoi(argv[arg]);
+        items = atoi(argv[arg + 1]);
+    }
+
+    StockMatrix stock;
+    MappedFile file{-1, nullptr, 0, nullptr, nullptr};
+    DurableStockMatrix durable;
+    WriteAheadLog* wal = nullptr;
+    bool ok;
+    if (wal_base) {
+        // Loads stock.snap and replays stock.wal, or starts a new table.
+        ok = open_durable_matrix(durable, wal_base, stores, items);
+        stock = durable.m;
+        wal = &durable.wal;
+    } else if (csv) {
+        LoadReport report;
+        ok = load_matrix(stock, csv, report);
+        if (ok && report.bad_lines > 0) {
+            cout << report.bad_lines << " malformed line(s) left as zero stock, first on line "
+                 << report.bad_line_numbers[0] << "\n";
+        }
+    } else if (path) {
+        // Reuse yesterday's table if the file exists, otherwise start a new one.
+        // A file that exists but cannot be opened is reported, not overwritten.
+        if (ledger_file_exists(path)) {
+            if (!open_matrix_file(stock, file, path)) {
+                cout << "Cannot open " << path << ": not a readable stock table file.\n";
+                return 1;
+            }
+            ok = true;
+        } else {
+            ok = create_matrix_file(stock, file, path, stores, items);
+        }
+    } else {
+        ok = create_stock(stock, stores, items);
+    }
+    if (!ok) {
+        cout << "Could not create a " << stores << " x " << items << " stock table.\n";
+        return 1;
+    }
+    if (replay) return run_replay_file(stock, replay);
+    cout << "Task 2: Stationery stock management (" << stock.stores << " stores x " << stock.items << " items)\n";
 
     while (true) {
         cout << "\nMenu:\n";
@@ -123,16 +249,27 @@ int main() {
         cout << "4. Exit\n";
         int cmd = read_int_in_range("Choose an option (1-4): ", 1, 4);
         if (cmd == 1) show_store(stock);
-        else if (cmd == 2) add_stock(stock);
-        else if (cmd == 3) reduce_stock(stock);
+        else if (cmd == 2) add_stock(stock, wal);
+        else if (cmd == 3) reduce_stock(stock, wal);
         else if (cmd == 4) {
             cout << "Exiting and freeing memory...\n";
             break;
         }
     }
 
-    delete_stock(stock);
-    cout << "Memory freed. Goodbye.\n";
+    if (wal_base) {
+        // A checkpoint folds the log into a fresh snapshot, so the next
+        // start has nothing to replay. durable.m shares stock's cells.
+        checkpoint_durable_matrix(durable);
+        close_durable_matrix(durable);
+        cout << "Stock saved to " << wal_base << ".snap. Goodbye.\n";
+    } else if (path) {
+        close_matrix_file(stock, file); // writes the checksum, data stays on disk
+        cout << "Stock saved to " << path << ". Goodbye.\n";
+    } else {
+        delete_stock(stock);
+        cout << "Memory freed. Goodbye.\n";
+    }
     return 0;
 }
 
@@ -145,7 +282,8 @@ int main() {
      access with .at(i) if you want exceptions on out-of-range access.
 
   2) Single allocation 2D array (more cache-friendly): allocate one block of
-     NUM_STORES * NUM_ITEMS ints and compute index as row*NUM_ITEMS + col.
+     stores * items ints and compute index as row*items + col. This is what
+     StockMatrix in stock_matrix.hpp does (rows padded to 64-byte lines).
 
   3) Input validation: current helper read_int_in_range is simple and effective
      for this exercise. For production code consider centralizing error handling
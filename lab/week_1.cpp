@@ -41,8 +41,9 @@ int main(){
    
     // Step 3: Verify our dynamic array works
     cout << "\nNumbers stored in dynamic array:" << endl;
+    // '\n' instead of endl (why: see out_buffer.hpp).
     for (int i = 0; i < size; i++) {
-        cout << "numbers[" << i << "] = " << numbers[i] << endl;
+        cout << "numbers[" << i << "] = " << numbers[i] << '\n';
     }
 
     // Step 4: POINTER vs VALUE DEMONSTRATION